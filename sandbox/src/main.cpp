@@ -1,4 +1,5 @@
-﻿#include <format>
+﻿#include <cstdlib>
+#include <format>
 #include <simple_gui.hpp>
 #include <ui_loader/component_register.hpp>
 #include <ui_loader/refl/type.hpp>
@@ -10,16 +11,19 @@ using namespace SimpleGui;
 class DisplayFPSForLabel final : public ExtendedFunctions {
 protected:
     void Update() override {
-        auto lbl = static_cast<Label *>(m_target);
-        lbl->SetText(std::format("FPS: {:.2f}", SG_GuiManager.GetRealFrameRate()));
+        // 每帧都会执行，格式化到栈上的缓冲区避免堆分配
+        char text[32];
+        auto result = std::format_to_n(text, sizeof(text), "FPS: {:.2f}", SG_GuiManager.GetRealFrameRate());
+        static_cast<Label *>(m_target)->SetText(std::string_view(text, result.out - text));
     }
 };
 
 class DisplayDeltaForLabel final : public ExtendedFunctions {
 protected:
     void Update() override {
-        auto lbl = static_cast<Label *>(m_target);
-        lbl->SetText(std::format("delta: {:.4f}", SG_GuiManager.GetDelta()));
+        char text[32];
+        auto result = std::format_to_n(text, sizeof(text), "delta: {:.4f}", SG_GuiManager.GetDelta());
+        static_cast<Label *>(m_target)->SetText(std::string_view(text, result.out - text));
     }
 };
 
@@ -41,9 +45,9 @@ protected:
 
     void Render(Renderer &renderer) override {
         //renderer.FillCircle(circlePos, 50, Color::GREEN);
-        renderer.SetTopRender(true);
+        renderer.PushRenderLayer(RenderLayer::Overlay);
         renderer.RenderCircle(circlePos, 50, Color::GREEN, true);
-        renderer.SetTopRender(false);
+        renderer.PopRenderLayer();
     }
 };
 
@@ -349,6 +353,54 @@ static void TestCheckBox() {
 }
 
 
+static void TestScrollPanelBlit() {
+    SG_GuiManager.SetUnlimitedFrameRate(true);
+
+    auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test scroll panel blit");
+    dp->SetSize(600, 500);
+
+    auto vBoxLayout = dp->AddChild<BoxLayout>(Direction::Vertical);
+    vBoxLayout->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+
+    auto frameTimeLbl = vBoxLayout->AddChild<Label>("frame time: -");
+    auto blitCheckBox = vBoxLayout->AddChild<CheckBox>("blit scroll");
+    auto kineticCheckBox = vBoxLayout->AddChild<CheckBox>("kinetic scroll");
+    auto flingBtn = vBoxLayout->AddChild<Button>("fling");
+
+    auto scrollPanel = vBoxLayout->AddChild<ScrollPanel>();
+    scrollPanel->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+
+    // 2000个子组件
+    for (int i = 0; i < 2000; ++i) {
+        auto btn = scrollPanel->AddChild<Button>(std::format("button {}", i));
+        btn->SetPosition(static_cast<float>(i % 10) * 110, static_cast<float>(i / 10) * 40);
+    }
+
+    blitCheckBox->checkStateChanged.Connect("on_check_state_changed",
+                                            [scrollPanel](bool checked) {
+                                                scrollPanel->SetBlitScrollEnabled(checked);
+                                            });
+    kineticCheckBox->checkStateChanged.Connect("on_check_state_changed",
+                                               [scrollPanel](bool checked) {
+                                                   scrollPanel->SetKineticScrollEnabled(checked);
+                                               });
+    flingBtn->clicked.Connect("on_clicked",
+                              [scrollPanel]() {
+                                  scrollPanel->Fling(Vec2(0, 400));
+                              });
+
+    // 统计0.5秒内的平均帧时间，对比开启和关闭blit scroll的差异
+    auto timer = SG_GuiManager.GetTimer(0.5f);
+    timer->timeout.Connect("on_timeout_update_frame_time",
+                           [frameTimeLbl, scrollPanel]() {
+                               double frameRate = SG_GuiManager.GetRealFrameRate();
+                               frameTimeLbl->SetText(std::format("frame time: {:.3f} ms ({})",
+                                                                 frameRate > 0 ? 1000.0 / frameRate : 0.0,
+                                                                 scrollPanel->IsBlitScrollEnabled() ? "blit" : "full redraw"));
+                           });
+    timer->Start();
+}
+
 static void TestLineEdit() {
     auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test line edit");
     dp->SetSize(300, 300);
@@ -369,6 +421,23 @@ static void TestLineEdit() {
                                          });
 }
 
+static void TestTextEdit() {
+    auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test text edit");
+    dp->SetSize(500, 400);
+
+    std::string text;
+    for (int i = 0; i < 100000; ++i) {
+        text += std::format("line {}: the quick brown fox jumps over the lazy dog\n", i);
+    }
+
+    auto textEdit = dp->AddChild<TextEdit>(text);
+    textEdit->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+    textEdit->textChanged.Connect("on_textChanged",
+                                  [textEdit]() {
+                                      SDL_Log("on_textChanged: line count = %zu", textEdit->GetLineCount());
+                                  });
+}
+
 static void TestDraggablePanel() {
     auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test draggable panel");
     dp->SetSize(300, 300);
@@ -385,7 +454,7 @@ static void TestTextureRect() {
     auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test texture rect");
     dp->SetSize(300, 300);
 
-    auto texture = SG_GuiManager.GetWindow().GetRenderer().CreateSharedTexture("D:\\download\\edge\\bg.jpg");
+    auto texture = SG_GuiManager.GetWindow().GetRenderer().CreateSharedTexture("D:\\download\\edge\\bg.jpg", true);
     auto textureRect = dp->AddChild<TextureRect>(texture);
     textureRect->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
     textureRect->SetTextureStretchMode(TextureStretchMode::KeepAspectCentered);
@@ -428,6 +497,17 @@ static void TestComboBox() {
 
     cbb->SetCurrentItem(0);
 
+    // 打开下拉列表后输入文本进行过滤
+    auto partsCbb = dp->AddChild<ComboBox>();
+    std::vector<std::string> parts;
+    for (int i = 0; i < 10000; ++i) {
+        parts.push_back(std::format("PN-{:c}{:05}", 'A' + i % 26, SDL_rand(100000)));
+    }
+    partsCbb->AddItems(parts);
+    partsCbb->SetMaxItemsListHeight(300);
+    partsCbb->SetSize(200, 30);
+    partsCbb->SetPosition(0, 60);
+
     auto tipLbl = cbb->SetToolTip<Label>("");
     tipLbl->CustomThemeColor(ThemeColorFlags::LabelBackground, Color(0, 0, 0, 180));
 
@@ -489,6 +569,93 @@ static void TestComboBox() {
         });
 }
 
+static void TestListView() {
+    class Model final : public ListViewModel {
+    public:
+        size_t GetRowCount() const override { return 1000000; }
+        bool HasFixedRowHeight() const override { return false; }
+        float GetRowHeight(size_t row) const override { return row % 10 == 0 ? 40.f : 0.f; }
+    };
+
+    class Delegate final : public ListViewDelegate {
+    public:
+        std::unique_ptr<BaseComponent> CreateRowComponent() override {
+            return std::make_unique<Label>("");
+        }
+
+        void BindRowComponent(BaseComponent *cmp, size_t row) override {
+            static_cast<Label *>(cmp)->SetText(std::format("item {}", row));
+        }
+    };
+
+    auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test list view");
+    dp->SetSize(300, 400);
+
+    auto listView = dp->AddChild<ListView>();
+    listView->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+    listView->SetDelegate(std::make_unique<Delegate>());
+    listView->SetModel(std::make_shared<Model>());
+    listView->rowClicked.Connect("on_rowClicked",
+                                 [](size_t row) {
+                                     SDL_Log("on_rowClicked: %zu", row);
+                                 });
+}
+
+static void TestTableView() {
+    constexpr size_t rowCount = 100000;
+    constexpr size_t columnCount = 30;
+
+    auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test table view");
+    dp->SetSize(800, 500);
+
+    auto tableView = dp->AddChild<TableView>();
+    tableView->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+
+    auto idColumn = tableView->AddColumn<int>("id", nullptr, 80);
+    auto nameColumn = tableView->AddColumn<std::string>("name", nullptr, 120);
+    std::vector<TypedTableColumn<double> *> valueColumns;
+    for (size_t col = 2; col < columnCount; ++col) {
+        valueColumns.push_back(tableView->AddColumn<double>(std::format("value {}", col - 2),
+                                                            [](const double &value, std::string &out) {
+                                                                std::format_to(std::back_inserter(out), "{:.3f}", value);
+                                                            }));
+    }
+
+    std::vector<int> ids(rowCount);
+    std::vector<std::string> names(rowCount);
+    for (size_t row = 0; row < rowCount; ++row) {
+        ids[row] = static_cast<int>(row);
+        names[row] = std::format("row {}", SDL_rand(static_cast<Sint32>(rowCount)));
+    }
+    idColumn->SetValues(std::move(ids));
+    nameColumn->SetValues(std::move(names));
+    for (auto column : valueColumns) {
+        std::vector<double> values(rowCount);
+        for (auto &value : values) value = SDL_randf() * 1000;
+        column->SetValues(std::move(values));
+    }
+
+    // 每秒更新约1000个单元格
+    auto timer = SG_GuiManager.GetTimer(0.1f);
+    timer->timeout.Connect("on_timeout_update_cells",
+                           [valueColumns]() {
+                               for (int i = 0; i < 100; ++i) {
+                                   auto column = valueColumns[SDL_rand(static_cast<Sint32>(valueColumns.size()))];
+                                   column->SetValue(SDL_rand(static_cast<Sint32>(rowCount)), SDL_randf() * 1000);
+                               }
+                           });
+    timer->Start();
+
+    tableView->cellClicked.Connect("on_cellClicked",
+                                   [](size_t row, size_t column) {
+                                       SDL_Log("on_cellClicked: row %zu, column %zu", row, column);
+                                   });
+    tableView->sorted.Connect("on_sorted",
+                              [](size_t column, bool ascending) {
+                                  SDL_Log("on_sorted: column %zu, %s", column, ascending ? "ascending" : "descending");
+                              });
+}
+
 static void TestBoxLayout() {
     auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>();
     dp->SetTitle("test box layout");
@@ -506,6 +673,205 @@ static void TestBoxLayout() {
     }
 }
 
+static void TestFlexLayout() {
+    auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test flex layout");
+    dp->SetSize(400, 300);
+
+    auto flexLayout = dp->AddChild<FlexLayout>(Direction::Horizontal);
+    flexLayout->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+    flexLayout->SetWrap(true);
+    flexLayout->SetSpacing(4);
+    flexLayout->SetLineSpacing(4);
+    flexLayout->SetAlignItems(FlexAlign::Center);
+
+    for (int i = 0; i < 20; ++i) {
+        auto btn = flexLayout->AddChild<Button>(std::format("button {}", i));
+        FlexItem item;
+        item.grow = static_cast<float>(i % 3);
+        item.maxSize = Vec2(160, -1);
+        flexLayout->SetFlexItem(btn, item);
+    }
+}
+
+static void TestGridLayout() {
+    constexpr int columnCount = 20;
+    constexpr int cellCount = 1000;
+
+    auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("test grid layout");
+    dp->SetSize(800, 500);
+
+    auto vBoxLayout = dp->AddChild<BoxLayout>(Direction::Vertical);
+    vBoxLayout->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+
+    auto btn = vBoxLayout->AddChild<Button>("relayout");
+    auto scrollPanel = vBoxLayout->AddChild<ScrollPanel>();
+    scrollPanel->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+
+    auto gridLayout = scrollPanel->AddChild<GridLayout>(columnCount);
+    gridLayout->SetSize(1400, 800);
+    gridLayout->SetSpacing(2, 2);
+
+    auto header = gridLayout->AddChild<Label>("header (span 20 columns)");
+    gridLayout->SetGridItem(header, 0, 0, 1, columnCount);
+    for (int i = 0; i < cellCount; ++i) {
+        gridLayout->AddChild<Label>(std::format("cell {}", i));
+    }
+
+    // 每次修改间距使缓存失效，测量重新求解1000个单元格的耗时
+    btn->clicked.Connect("on_clicked",
+                         [gridLayout]() {
+                             float spacing = gridLayout->GetSpacing().x == 2 ? 3.f : 2.f;
+                             Uint64 start = SDL_GetPerformanceCounter();
+                             gridLayout->SetSpacing(spacing, spacing);
+                             gridLayout->Update();
+                             double ms = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+                             SG_INFO("grid relayout: {:.3f} ms", ms);
+                         });
+}
+
+static void TestMemoryReport() {
+    constexpr int count = 10000;
+
+    auto scrollPanel = SG_GuiManager.GetWindow().AddComponent<ScrollPanel>();
+    scrollPanel->SetSize(600, 400);
+    auto vBoxLayout = scrollPanel->AddChild<BoxLayout>(Direction::Vertical);
+    vBoxLayout->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Fixed);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < count; ++i) {
+        vBoxLayout->AddChild<Label>(std::format("label {}", i));
+    }
+    double ms = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    SG_INFO("build {} labels: {:.3f} ms", count, ms);
+
+    // 只有少数组件使用提示框
+    auto btn = vBoxLayout->AddChild<Button>("button with tooltip");
+    btn->SetToolTipEnabled(true);
+    btn->SetToolTip<Label>("tooltip");
+
+    SG_INFO("sizeof BaseComponent: {}, Label: {}, Button: {}, BoxLayout: {}, ScrollPanel: {}",
+            sizeof(BaseComponent), sizeof(Label), sizeof(Button), sizeof(BoxLayout), sizeof(ScrollPanel));
+
+    std::unordered_map<std::string, ComponentMemoryInfo> report;
+    SG_GuiManager.GetWindow().GetRootComponent().CollectMemoryReport(report);
+    for (const auto &[name, info]: report) {
+        SG_INFO("{}: count {}, tooltips {}, extended functions {}, fonts {}, theme colors {}, attached {} bytes",
+                name, info.count, info.toolTipCount, info.extFunctionsManagerCount, info.fontCount,
+                info.themeColorMapCount, info.attachedBytes);
+    }
+    SG_INFO("slab allocator: {} slabs, {} bytes in use",
+            SlabAllocator::GetInstance().GetSlabCount(), SlabAllocator::GetInstance().GetUsedBytes());
+}
+
+static void TestAddChildren() {
+    constexpr int count = 10000;
+
+    auto scrollPanel = SG_GuiManager.GetWindow().AddComponent<ScrollPanel>();
+    scrollPanel->SetSize(600, 400);
+    auto vBoxLayout = scrollPanel->AddChild<BoxLayout>(Direction::Vertical);
+    vBoxLayout->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Fixed);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    std::vector<std::unique_ptr<Label>> labels;
+    labels.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        labels.push_back(std::make_unique<Label>(std::format("row {}", i)));
+    }
+    vBoxLayout->AddChildren(labels);
+    double ms = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    SG_INFO("AddChildren {} labels: {:.3f} ms", count, ms);
+
+    // 逐个添加时也可以用Begin/EndBulkUpdate合并
+    start = SDL_GetPerformanceCounter();
+    vBoxLayout->BeginBulkUpdate();
+    for (int i = 0; i < count; ++i) {
+        vBoxLayout->AddChild<Label>(std::format("row {}", count + i));
+    }
+    vBoxLayout->EndBulkUpdate();
+    ms = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    SG_INFO("bulk update {} labels: {:.3f} ms", count, ms);
+}
+
+static void TestParallelUpdate() {
+    constexpr int panelCount = 8;
+    constexpr int labelCount = 2500;
+
+    SG_INFO("job system workers: {}", SG_GuiManager.GetJobSystem().GetWorkerCount());
+    for (int i = 0; i < panelCount; ++i) {
+        auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>(std::format("panel {}", i));
+        dp->SetPosition(i * 40.f, i * 30.f);
+        dp->SetSize(300, 300);
+        // 各个面板的子树互不依赖，布局排列在工作线程中进行
+        dp->SetParallelUpdateEnabled(true);
+
+        auto flexLayout = dp->AddChild<FlexLayout>(Direction::Horizontal);
+        flexLayout->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
+        flexLayout->SetWrap(true);
+
+        std::vector<std::unique_ptr<Label>> labels;
+        labels.reserve(labelCount);
+        for (int j = 0; j < labelCount; ++j) {
+            labels.push_back(std::make_unique<Label>(std::format("{}", j)));
+        }
+        flexLayout->AddChildren(labels);
+    }
+}
+
+static void TestCulling() {
+    constexpr int count = 10000;
+
+    auto scrollPanel = SG_GuiManager.GetWindow().AddComponent<ScrollPanel>();
+    scrollPanel->SetSize(600, 400);
+    auto vBoxLayout = scrollPanel->AddChild<BoxLayout>(Direction::Vertical);
+    vBoxLayout->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Fixed);
+
+    std::vector<std::unique_ptr<Label>> labels;
+    labels.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        labels.push_back(std::make_unique<Label>(std::format("row {}", i)));
+    }
+    // 滚动到可见区域之外的行不会更新和绘制，最后一行即使不可见也保持更新
+    labels.back()->SetUpdateWhenHidden(true);
+    vBoxLayout->AddChildren(labels);
+
+    auto timer = SG_GuiManager.GetTimer(1.0f);
+    timer->timeout.Connect("on_timeout_count_culled",
+                           [vBoxLayout] {
+                               size_t culled = 0;
+                               vBoxLayout->ForEachChild([&culled](BaseComponent *child) {
+                                   if (child->IsCulled()) ++culled;
+                               });
+                               SG_INFO("culled rows: {}", culled);
+                           });
+    timer->Start();
+}
+
+static void TestOcclusion() {
+    constexpr int panelCount = 4;
+
+    for (int i = 0; i < panelCount; ++i) {
+        auto dp = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>(std::format("panel {}", i));
+        dp->SetPosition(100 + i * 20.f, 100 + i * 20.f);
+        dp->SetSize(400, 300);
+        for (int j = 0; j < 50; ++j) {
+            dp->AddChild<Button>(std::format("button {}", j))->SetPosition(j % 5 * 80.f, j / 5 * 30.f);
+        }
+    }
+    // 最上层的面板完全覆盖下面的面板
+    auto top = SG_GuiManager.GetWindow().AddComponent<DraggablePanel>("top panel");
+    top->SetPosition(80, 80);
+    top->SetSize(520, 420);
+
+    auto timer = SG_GuiManager.GetTimer(1.0f);
+    timer->timeout.Connect("on_timeout_occlusion_stats",
+                           [] {
+                               const auto &stats = SG_GuiManager.GetWindow().GetRenderer().GetStats();
+                               SG_INFO("occluded components: {}, occluded commands: {}, recorded commands: {}",
+                                       stats.occludedComponents, stats.occludedCommands, stats.recordedCommands);
+                           });
+    timer->Start();
+}
+
 static void ViewImage() {
     class ClickToTop final : public ExtendedFunctions {
     protected:
@@ -514,17 +880,7 @@ static void ViewImage() {
                 ev && ev->IsPressed(MouseButton::Left)) {
                 if (!m_target->GetGlobalRect().ContainPoint(ev->GetPosition())) return false;
 
-                auto &children = m_target->GetParent()->GetChildren();
-                if (children[children.size() - 1].get() == m_target) return false;
-
-                auto rit = std::find_if(children.rbegin(), children.rend(),
-                                        [this](auto &child) {
-                                            return child.get() == this->m_target;
-                                        });
-                if (rit == children.rend()) return false;
-                auto it = rit.base() - 1;
-                std::rotate(it, it + 1, children.end());
-                return true;
+                return m_target->GetParent()->MoveChildToTop(m_target);
             }
             return false;
         }
@@ -536,7 +892,7 @@ static void ViewImage() {
             if (const auto ev = event->Convert<DropEvent>();
                 ev && ev->IsDropFile()) {
                 std::string path = ev->GetContent();
-                auto texture = SG_GuiManager.GetWindow().GetRenderer().CreateSharedTexture(path);
+                auto texture = SG_GuiManager.GetWindow().GetRenderer().CreateSharedTexture(path, true);
                 if (texture->IsNull()) {
                     SG_INFO("Texture could not be loaded: {}", path);
                     return false;
@@ -571,8 +927,8 @@ static void ViewImage() {
     lbl->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
     lbl->SetTextAlignments(TextAlignment::Center, TextAlignment::Center);
     lbl->CustomThemeColor(ThemeColorFlags::LabelForeground, Color(175, 175, 175));
-    lbl->GetFont().SetSize(18);
-    lbl->GetFont().SetStyle(FontStyle::Bold);
+    lbl->GetOrCreateFont().SetSize(18);
+    lbl->GetOrCreateFont().SetStyle(FontStyle::Bold);
     SG_GuiManager.GetWindow().GetRootComponent().AddExtendedFunctions<OpenDroppedFile>();
 }
 
@@ -615,19 +971,191 @@ static void TestClassRegistry() {
 
 }
 
+// 预热若干帧后开始统计堆分配，统计结束时输出分配的调用点并退出
+class AllocCheckFunctions final : public ExtendedFunctions {
+public:
+    AllocCheckFunctions(size_t warmUpFrames, size_t frames) : m_warmUpFrames(warmUpFrames), m_frames(frames) {}
+
+    static inline bool failed = false;
+
+protected:
+    size_t m_warmUpFrames;
+    size_t m_frames;
+    size_t m_frame = 0;
+
+    void Update() override {
+        ++m_frame;
+        if (m_frame == m_warmUpFrames) {
+            AllocTracker::Begin();
+            return;
+        }
+        if (m_frame != m_warmUpFrames + m_frames) return;
+
+        AllocTracker::End();
+        failed = AllocTracker::GetCount() > 0;
+        if (failed) {
+            SG_ERROR("alloc check: {} allocations ({} bytes) in {} steady frames",
+                     AllocTracker::GetCount(), AllocTracker::GetBytes(), m_frames);
+            for (const auto &site: AllocTracker::GetCallSites()) {
+                SG_ERROR("  {}: {} allocations, {} bytes", site.address, site.count, site.bytes);
+            }
+        }
+        else {
+            SG_INFO("alloc check: no allocations in {} steady frames", m_frames);
+        }
+
+        SDL_Event quit{};
+        quit.type = SDL_EVENT_QUIT;
+        SDL_PushEvent(&quit);
+    }
+};
+
+// 无窗口运行不依赖外部文件的场景，预热后的帧内出现堆分配时返回非0
+static int RunAllocCheck(size_t frames) {
+    if (!AllocTracker::IsAvailable()) {
+        SG_ERROR("alloc check: SimpleGui was built without SG_ALLOC_TRACKING");
+        return 1;
+    }
+
+    TestScrollPanel();
+    TestProgressBar();
+    TestSlider();
+    TestCheckBox();
+    TestComboBox();
+    TestListView();
+    TestBoxLayout();
+    TestFlexLayout();
+    TestGridLayout();
+
+    SG_GuiManager.GetWindow().GetRootComponent().AddExtendedFunctions<AllocCheckFunctions>(60, frames);
+    SG_GuiManager.SetUnlimitedFrameRate(true);
+    SG_GuiManager.Run();
+    GuiManager::Quit();
+    return AllocCheckFunctions::failed ? 1 : 0;
+}
+
+// 记录子组件每帧绘制时的可见矩形
+class RenderProbeFunctions final : public ExtendedFunctions {
+public:
+    struct Record {
+        size_t frame = 0;
+        Rect visibleGRect;
+    };
+
+    RenderProbeFunctions(Record *record, const size_t *frame) : m_record(record), m_frame(frame) {}
+
+protected:
+    Record *m_record;
+    const size_t *m_frame;
+
+    void Render(Renderer &renderer) override {
+        m_record->frame = *m_frame;
+        m_record->visibleGRect = m_target->GetVisibleGlobalRect();
+    }
+};
+
+// 开启blit scroll的滚动面板每帧滚动少于一屏，检查滚入可见区域的子组件在同一帧以滚动后的位置绘制
+class ScrollExposeCheckFunctions final : public ExtendedFunctions {
+public:
+    ScrollExposeCheckFunctions(ScrollPanel *scrollPanel, std::vector<Label *> rows, size_t frames)
+        : m_scrollPanel(scrollPanel), m_rows(std::move(rows)), m_records(m_rows.size()), m_frames(frames) {
+        for (size_t i = 0; i < m_rows.size(); ++i) {
+            m_rows[i]->AddExtendedFunctions<RenderProbeFunctions>(&m_records[i], &m_frame);
+        }
+    }
+
+    static inline bool failed = false;
+
+protected:
+    ScrollPanel *m_scrollPanel;
+    std::vector<Label *> m_rows;
+    std::vector<RenderProbeFunctions::Record> m_records;
+    size_t m_frames;
+    size_t m_frame = 0;
+    size_t m_checks = 0;
+    size_t m_errors = 0;
+
+    // 根组件最先更新，此时上一帧已经绘制完，子组件的位置就是上一帧绘制时的位置
+    void Update() override {
+        if (m_frame > 2) CheckLastFrame();
+        if (m_frame == 2) m_scrollPanel->Fling(Vec2(0, 300));
+        ++m_frame;
+        if (m_frame <= m_frames) return;
+
+        failed = m_errors > 0 || m_checks == 0;
+        if (failed) SG_ERROR("scroll expose check: {} of {} row checks failed", m_errors, m_checks);
+        else SG_INFO("scroll expose check: {} row checks passed", m_checks);
+
+        SDL_Event quit{};
+        quit.type = SDL_EVENT_QUIT;
+        SDL_PushEvent(&quit);
+    }
+
+    void CheckLastFrame() {
+        Rect contentGRect = m_scrollPanel->GetContentGlobalRect().GetIntersection(m_scrollPanel->GetVisibleGlobalRect());
+        for (size_t i = 0; i < m_rows.size(); ++i) {
+            Rect expected = m_rows[i]->GetGlobalRect().GetIntersection(contentGRect);
+            if (expected.size.w <= 0 || expected.size.h <= 0) continue;
+
+            ++m_checks;
+            const auto &record = m_records[i];
+            if (record.frame == m_frame - 1 && record.visibleGRect.position.IsEqualApprox(expected.position) &&
+                record.visibleGRect.size.IsEqualApprox(expected.size)) continue;
+
+            // 只输出前10次失败
+            if (++m_errors <= 10) {
+                SG_ERROR("scroll expose check: row {} in frame {} was {}", i, m_frame - 1,
+                         record.frame == m_frame - 1 ? "drawn at a stale position" : "not drawn");
+            }
+        }
+    }
+};
+
+// 无窗口运行，滚动过程中每帧检查新露出区域的子组件，出现漏绘时返回非0
+static int RunScrollExposeCheck(size_t frames) {
+    auto scrollPanel = SG_GuiManager.GetWindow().AddComponent<ScrollPanel>();
+    scrollPanel->SetSize(400, 300);
+    scrollPanel->SetBlitScrollEnabled(true);
+
+    std::vector<Label *> rows;
+    for (int i = 0; i < 200; ++i) {
+        auto row = scrollPanel->AddChild<Label>(std::format("row {}", i));
+        row->SetPosition(0, static_cast<float>(i) * 30);
+        rows.push_back(row);
+    }
+
+    SG_GuiManager.GetWindow().GetRootComponent().AddExtendedFunctions<ScrollExposeCheckFunctions>(scrollPanel, std::move(rows), frames);
+    SG_GuiManager.SetTargetFrameRate(60);
+    SG_GuiManager.Run();
+    GuiManager::Quit();
+    return ScrollExposeCheckFunctions::failed ? 1 : 0;
+}
+
 int main(int argc, char **argv) {
+    // sandbox --alloc-check [frames]
+    // sandbox --scroll-expose-check [frames]
+    bool allocCheck = argc > 1 && std::string_view(argv[1]) == "--alloc-check";
+    bool scrollExposeCheck = argc > 1 && std::string_view(argv[1]) == "--scroll-expose-check";
+    if (allocCheck) AllocTracker::InstallSDLHooks();
+    if (allocCheck || scrollExposeCheck) SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+
     GuiManager::Init(argc, argv, R"(C:\WINDOWS\Fonts\simhei.ttf)");
     Window &win = SG_GuiManager.GetWindow("sandbox", 960, 640);
     win.GetFont().SetSize(14);
+    if (allocCheck) return RunAllocCheck(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 600);
+    if (scrollExposeCheck) return RunScrollExposeCheck(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 120);
+    if (argc > 1 && std::string_view(argv[1]) == "--pipelined") win.GetRenderer().SetPipelined(true);
     // win.SwitchStyle(StyleManager::LightStyle);
 
     // auto lbl = win.AddComponent<Label>();
     // lbl->SetText("hello world");
-    // lbl->GetFont().SetSize(72);
+    // lbl->GetOrCreateFont().SetSize(72);
 
     // TestScrollBar();
     // TestScrollPanel();
+    // TestScrollPanelBlit();
     // TestLineEdit();
+    // TestTextEdit();
     // TestTimer();
     // TestProgressBar();
     // TestSlider();
@@ -636,7 +1164,16 @@ int main(int argc, char **argv) {
     // TestDraggablePanel();
     // ViewImage();
     // TestComboBox();
+    // TestListView();
+    // TestTableView();
     // TestBoxLayout();
+    // TestFlexLayout();
+    // TestGridLayout();
+    // TestMemoryReport();
+    // TestAddChildren();
+    // TestParallelUpdate();
+    // TestCulling();
+    // TestOcclusion();
     // TestComponentRegister();
     TestClassRegistry();
 
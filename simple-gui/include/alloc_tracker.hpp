@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+
+namespace SimpleGui {
+	// 堆分配统计，用于检查稳定的帧内是否还存在堆分配
+	// 以SG_ALLOC_TRACKING（CMake选项）编译时替换全局operator new/delete，并可接管SDL的内存函数
+	// 未启用时不进行任何记录，所有统计都为0
+	class AllocTracker final {
+	public:
+		struct CallSite final {
+			void* address;			// 分配函数的返回地址，可通过调试器或addr2line解析到源码位置
+			size_t count;
+			size_t bytes;
+		};
+
+		static constexpr size_t MAX_CALL_SITES = 256;
+
+		AllocTracker() = delete;
+
+		static bool IsAvailable();
+		// 接管SDL_malloc等函数（SDL_ttf、SDL_image同样经过这些函数），需要在GuiManager::Init之前调用
+		static void InstallSDLHooks();
+
+		// 清空统计并开始记录
+		static void Begin();
+		static void End();
+		static bool IsRecording();
+
+		static size_t GetCount();
+		static size_t GetBytes();
+		// 按分配次数从多到少排序，调用点超过MAX_CALL_SITES时多出的部分只计入总数
+		static std::vector<CallSite> GetCallSites();
+	};
+}
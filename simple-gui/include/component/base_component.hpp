@@ -1,14 +1,17 @@
 #pragma once
 #include <vector>
+#include <string>
 #include <unordered_map>
 #include <memory>
 #include <functional>
+#include <ranges>
 #include "renderer.hpp"
 #include "style.hpp"
 #include "math.hpp"
 #include "timer.hpp"
 #include "extended_functions.hpp"
 #include "common/types.hpp"
+#include "common/geometry_store.hpp"
 
 
 namespace SimpleGui {
@@ -25,10 +28,23 @@ namespace SimpleGui {
 	class Window;
 	class Event;
 
+	// 某一类型组件的数量，以及按需创建的附属对象的数量和占用的内存
+	struct ComponentMemoryInfo final {
+		size_t count = 0;
+		size_t toolTipCount = 0;
+		size_t extFunctionsManagerCount = 0;
+		size_t fontCount = 0;
+		size_t themeColorMapCount = 0;
+		size_t attachedBytes = 0;
+	};
+
+	// 组件及其提示框、扩展功能管理器都从SlabAllocator分配，unique_ptr的所有权语义不变
 	class BaseComponent {
 	public:
+		SG_SLAB_ALLOCATED
+
 		BaseComponent();
-		virtual ~BaseComponent() = default;
+		virtual ~BaseComponent();
 
 		virtual bool HandleEvent(Event* event);
 		virtual void Update();
@@ -38,15 +54,17 @@ namespace SimpleGui {
 		Rect GetGlobalRect() const { return Rect{ GetGlobalPosition(), m_size}; }
 		Rect GetVisibleGlobalRect() const { return m_visibleGRect; }
 		Rect GetContentGlobalRect() const;
+		// 绘制后被完全覆盖（不透明且没有空洞）的区域，使用全局坐标，用于剔除被遮挡的组件。没有时返回空矩形
+		virtual Rect GetOpaqueGlobalRect() { return {}; }
 
 		// 基于global_position的坐标系统，无法在组件被添加到父组件之前有效设置position(局部)
 		// 采用基于position(局部)的坐标系统，通过计算获得global_position
 
 		Vec2 GetPosition() const { return m_position; }
-		void SetPosition(const Vec2 pos) { m_position = pos; }
-		void SetPosition(float x, float y) { m_position.x = x; m_position.y = y; }
-		void SetPositionX(float x) { m_position.x = x; }
-		void SetPositionY(float y) { m_position.y = y; }
+		void SetPosition(const Vec2 pos);
+		void SetPosition(float x, float y);
+		void SetPositionX(float x);
+		void SetPositionY(float y);
 
 		Vec2 GetGlobalPosition() const;
 		void SetGlobalPosition(const Vec2& pos);
@@ -70,22 +88,37 @@ namespace SimpleGui {
 		void SetMinHeight(float h);
 
 		ComponentPadding GetPadding() const { return m_padding; }
-		void SetPadding(const ComponentPadding& padding) { m_padding = padding; }
+		void SetPadding(const ComponentPadding& padding) { m_padding = padding; InvalidateLayout(); }
 		void SetPadding(int left, int top, int right, int bottom) {
-			m_padding.left = left; m_padding.top = top; m_padding.right = right; m_padding.bottom = bottom; }
+			m_padding.left = left; m_padding.top = top; m_padding.right = right; m_padding.bottom = bottom; InvalidateLayout(); }
 
 		ComponentSizeConfigs GetSizeConfigs() const { return m_sizeConfigs; }
-		void SetSizeConfigs(const ComponentSizeConfigs& config) { m_sizeConfigs = config; }
+		void SetSizeConfigs(const ComponentSizeConfigs& config) { m_sizeConfigs = config; InvalidateParentLayout(); }
 		void SetSizeConfigs(ComponentSizeConfig wConfig, ComponentSizeConfig hConfig) {
-			m_sizeConfigs.first = wConfig; m_sizeConfigs.second = hConfig; }
-		void SetSizeConfigW(ComponentSizeConfig config) { m_sizeConfigs.first = config; }
-		void SetSizeConfigH(ComponentSizeConfig config) { m_sizeConfigs.second = config; }
+			m_sizeConfigs.first = wConfig; m_sizeConfigs.second = hConfig; InvalidateParentLayout(); }
+		void SetSizeConfigW(ComponentSizeConfig config) { m_sizeConfigs.first = config; InvalidateParentLayout(); }
+		void SetSizeConfigH(ComponentSizeConfig config) { m_sizeConfigs.second = config; InvalidateParentLayout(); }
+
+		// 标记需要重新布局，并向上传递到最近的布局根（父组件不是布局的布局组件）
+		// 布局组件只在失效后重新测量和排列子组件
+		void InvalidateLayout();
+		bool IsLayoutDirty() const { return m_layoutDirty; }
 
 		bool IsVisible() const { return m_visible; }
 		void SetVisible(bool visible);
 
 		bool IsDisabled() const { return m_disabled; }
-		void SetDisabled(bool disabled) { m_disabled = disabled; }
+		void SetDisabled(bool disabled);
+
+		// 启用后，作为窗口的顶层组件时，其子树的布局计算在每帧更新之前与其他启用的子树并行进行
+		bool IsParallelUpdateEnabled() const { return m_parallelUpdate; }
+		void SetParallelUpdateEnabled(bool enable) { m_parallelUpdate = enable; }
+
+		// 位于父组件的可见内容区域之外时，整个子树默认既不更新也不绘制；开启后仍然更新（但不绘制），适用于需要持续计时的组件
+		bool IsUpdateWhenHidden() const { return m_updateWhenHidden; }
+		void SetUpdateWhenHidden(bool enable) { m_updateWhenHidden = enable; }
+		// 最近一次更新时是否位于父组件的可见内容区域之外
+		bool IsCulled() const { return m_culled; }
 
 		template<typename T, typename...Args>
 		T* AddChild(Args&& ...args) {
@@ -112,65 +145,116 @@ namespace SimpleGui {
 
 		void AddChild(std::unique_ptr<BaseComponent> child);
 		void AddChildDeferred(std::unique_ptr<BaseComponent> child);
+
+		// 批量添加子组件：预留一次容量，子组件进入组件树和布局失效推迟到最后统一处理
+		template<std::ranges::range Range>
+		void AddChildren(Range&& children) {
+			if constexpr (std::ranges::sized_range<Range>) m_children.reserve(m_children.size() + std::ranges::size(children));
+			BeginBulkUpdate();
+			for (auto& child : children) {
+				AddChild(std::unique_ptr<BaseComponent>(std::move(child)));
+			}
+			EndBulkUpdate();
+		}
+
+		// Begin/End之间添加的子组件在End时才调用EnteredComponentTree，并且只使布局失效一次，可以嵌套
+		void BeginBulkUpdate() { ++m_bulkUpdateDepth; }
+		void EndBulkUpdate();
+		bool IsInBulkUpdate() const { return m_bulkUpdateDepth > 0; }
 		BaseComponent* GetChildAt(size_t idx) const;
 		virtual std::unique_ptr<BaseComponent> RemoveChild(BaseComponent* cmp);
 		virtual std::unique_ptr<BaseComponent> RemoveChildDeferred(BaseComponent* cmp);
+		// 移动到子组件列表末尾（最后绘制、最先处理事件），子组件仍在添加缓存中时返回false
+		bool MoveChildToTop(BaseComponent* cmp);
 
+		// 可能包含已移除子组件留下的空位；每个子组件记录了自身的下标，不要直接改变列表的顺序
 		std::vector<std::unique_ptr<BaseComponent>>& GetChildren() { return m_children; };
 		size_t GetChildrenCount() const;
 		bool HasChild(BaseComponent* cmp);
 		void ClearAllChildren();
 		void ClearAllChildrenDeferred() const;
-		void ForEachChild(const std::function<void(BaseComponent*)>& fn);
+		// 模板参数直接接收可调用对象，不构造std::function
+		template<typename Fn>
+		void ForEachChild(Fn&& fn) {
+			for (auto& child : m_children) {
+				if (!child || child->m_needRemove) continue;
+				fn(child.get());
+			}
+
+			for (auto& child : m_childCaches) {
+				if (!child || child->m_needRemove) continue;
+				fn(child.get());
+			}
+		}
+
+		// 包含所有子组件的最小矩形（局部坐标），子组件添加、移除、移动或改变大小时增量维护
+		// 只有位于边界上的子组件收缩或被移除时才重新计算
+		Rect GetChildrenBounds();
+		// 平移所有子组件，子组件边界随之平移
+		void TranslateChildren(const Vec2& delta);
 
 		// size_t GetIndex() const { return m_index; };
 		// void SetIndex(size_t idx);
 
-		virtual void SetFont(std::unique_ptr<Font> font) { m_font = std::move(font); };
+		virtual void SetFont(std::unique_ptr<Font> font);
 		virtual void SetFont(std::string_view path, int size);
-		virtual Font& GetFont();
+		// 没有设置字体时直接使用所在窗口的字体，不再为每个组件打开一份字体
+		virtual const Font& GetFont() const;
+		// 修改字体时使用：没有自己的字体时先复制一份当前字体（写时复制），不影响其他组件
+		Font& GetOrCreateFont();
 
 		Color GetThemeColor(ThemeColorFlags flag);
+		// 当前样式为该槽位设置的九宫格皮肤，没有设置或自定义了该槽位的颜色时返回nullptr
+		const NineSliceSkin* GetThemeSkin(ThemeColorFlags flag);
 		virtual void CustomThemeColor(ThemeColorFlags flag, const Color& color);
 		virtual void ClearCustomThemeColor(ThemeColorFlags flag);
 		virtual void ClearCustomThemeColors();
 
-		bool ToolTipEnabled() const { return m_toolTip->enabled; };
-		void SetToolTipEnabled(bool enabled) const { m_toolTip->enabled = enabled; };
+		// 提示框和扩展功能管理器在第一次使用时才创建，未创建时遍历直接跳过
+		bool ToolTipEnabled() const { return m_toolTip && m_toolTip->enabled; };
+		void SetToolTipEnabled(bool enabled) {
+			if (!enabled && !m_toolTip) return;
+			GetOrCreateToolTip().enabled = enabled;
+		}
 
 		template<typename T, typename...Args>
 		T* SetToolTip(Args&& ...args) {
 			static_assert(std::is_base_of_v<BaseComponent, T>, "T 必须继承自 BaseComponent");
 			auto cmp = std::make_unique<T>(std::forward<Args>(args)...);
 			auto ptr = cmp.get();
-			m_toolTip->cmp = std::move(cmp);
+			GetOrCreateToolTip().cmp = std::move(cmp);
 			return ptr;
 		}
 
-		BaseComponent* GetToolTipComponent() const { return m_toolTip->cmp.get(); }
+		BaseComponent* GetToolTipComponent() const { return m_toolTip ? m_toolTip->cmp.get() : nullptr; }
 
 		template<typename T, typename ...Args>
 		T* AddExtendedFunctions(Args&& ...args) {
-			return m_extFunctionsManager->AddExtendedFunctions<T>(std::forward<Args>(args)...);
+			return GetOrCreateExtendedFunctionsManager().AddExtendedFunctions<T>(std::forward<Args>(args)...);
 		}
 
 		template<typename T, typename ...Args>
 		T* AddExtendedFunctionsDeferred(Args&& ...args) {
-			return m_extFunctionsManager->AddExtendedFunctionsDeferred<T>(std::forward<Args>(args)...);
+			return GetOrCreateExtendedFunctionsManager().AddExtendedFunctionsDeferred<T>(std::forward<Args>(args)...);
 		}
 
 		template<typename T>
 		std::unique_ptr<ExtendedFunctions> RemoveExtendedFunctions() {
+			if (!m_extFunctionsManager) return nullptr;
 			return m_extFunctionsManager->RemoveExtendedFunctions<T>();
 		}
 
 		template<typename T>
 		std::unique_ptr<ExtendedFunctions> RemoveExtendedFunctionsDeferred() {
+			if (!m_extFunctionsManager) return nullptr;
 			return m_extFunctionsManager->RemoveExtendedFunctionsDeferred<T>();
 		}
 
-		void ClearAllExtendedFunctions() const { m_extFunctionsManager->Clear(); }
-		void ClearAllExtendedFunctionsDeferred() const { m_extFunctionsManager->ClearDeferred(); }
+		void ClearAllExtendedFunctions() const { if (m_extFunctionsManager) m_extFunctionsManager->Clear(); }
+		void ClearAllExtendedFunctionsDeferred() const { if (m_extFunctionsManager) m_extFunctionsManager->ClearDeferred(); }
+
+		// 按类型统计以该组件为根的子树（包括提示框组件）中组件的数量和附属对象的内存，键为类型名
+		void CollectMemoryReport(std::unordered_map<std::string, ComponentMemoryInfo>& report) const;
 
 	public:
 		Signal<bool> visibleChanged;
@@ -181,6 +265,8 @@ namespace SimpleGui {
 	protected:
 		class ToolTip final {
 		public:
+			SG_SLAB_ALLOCATED
+
 			const float MOUSE_SATY_DURATION = 1.0f;
 
 			BaseComponent *target{};
@@ -210,20 +296,55 @@ namespace SimpleGui {
 		bool m_visible = true;
 		bool m_disabled = false;
 		bool m_needRemove = false;
+		bool m_ownedByParent = false;			// 位于父组件的子组件列表中，几何信息变化时通知父组件
+		bool m_isLayout = false;				// 子组件的大小、可见性变化时需要重新布局
+		bool m_layoutDirty = true;
+		bool m_layoutArranging = false;			// 正在排列子组件，此时子组件的变化不会使布局失效
+		bool m_parallelUpdate = false;
+		bool m_updateWhenHidden = false;
+		bool m_culled = false;
+
+		uint32_t m_bulkUpdateDepth = 0;
+		bool m_bulkChildrenChanged = false;
+		std::vector<BaseComponent*> m_bulkEnteredChildren;	// 批量更新期间添加、尚未进入组件树的子组件，被移除的子组件留下空位
+
+		Rect m_childrenBounds;				// 使用局部坐标
+		bool m_hasChildrenBounds = false;
+		bool m_childrenBoundsDirty = false;
 
 		std::unique_ptr<Font> m_font;
-		std::unordered_map<ThemeColorFlags, Color> m_themeColorCaches;
+		std::unique_ptr<std::unordered_map<ThemeColorFlags, Color>> m_themeColorCaches;		// 自定义过主题颜色时才创建
 
 		Window* m_window = nullptr;
 		BaseComponent* m_parent = nullptr;
 		std::unique_ptr<ToolTip> m_toolTip{};
 		std::vector<std::unique_ptr<BaseComponent>> m_children;
 		std::vector<std::unique_ptr<BaseComponent>> m_childCaches;
+		size_t m_indexInParent = 0;				// 在父组件的m_children（或m_childCaches）中的下标
+		size_t m_bulkEnterIndex = NOT_BULK_ENTERING;	// 在父组件的m_bulkEnteredChildren中的下标
+		bool m_inChildCaches = false;
+		size_t m_childrenCount = 0;
+		mutable bool m_childrenNeedCompact = false;	// m_children中有空位或NeedRemove的子组件
 		std::unique_ptr<ExtendedFunctionsManager> m_extFunctionsManager;
 
+		// 所在窗口的几何数据存储，只有位于组件树中的组件才拥有槽位
+		GeometryStore* m_geometryStore = nullptr;
+		uint32_t m_geometryIndex = GeometryStore::INVALID_INDEX;
+
 	protected:
 		virtual void EnteredComponentTree() {};
 		virtual void ExitedComponentTree() {};
+		// 使用的字体对象变了，持有TTF_Text的组件需要切换到新字体
+		virtual void OnFontChanged() {};
+
+		// 用皮肤或主题颜色填充组件的可见范围
+		void RenderThemeBackground(Renderer& renderer, ThemeColorFlags flag);
+
+		// 并行更新阶段，在工作线程中调用。只能修改自身子树的几何数据（如布局排列），
+		// 不能发射信号、调用SDL、增删组件或访问子树以外的组件
+		virtual void UpdateLayoutParallel();
+		// 还有待加入或待移除的子组件，此时子组件列表只能在主线程中整理
+		bool HasPendingChildChanges() const { return !m_childCaches.empty() || m_childrenNeedCompact; }
 
 		void SetComponentOwner(BaseComponent* cmp, Window* window, BaseComponent* parent) const {
 			cmp->m_window = window;
@@ -246,15 +367,58 @@ namespace SimpleGui {
 		void SetComponentVisibleGlobalRect(BaseComponent* cmp, const Rect& rect) const { cmp->m_visibleGRect = rect; }
 
 		void EnteredComponentTree(BaseComponent* cmp) const { cmp->EnteredComponentTree(); }
+		void UpdateLayoutParallel(BaseComponent* cmp) const { cmp->UpdateLayoutParallel(); }
 		void ExitedComponentTree(BaseComponent* cmp) const { cmp->ExitedComponentTree(); }
 
+		// 直接修改m_position或m_size之后调用，通知父组件更新子组件边界
+		void NotifyGeometryChanged(const Rect& oldRect);
+
+		// 为该组件及其所有子组件分配几何数据槽位（父组件先于子组件），并同步当前的几何数据
+		void RegisterGeometry(GeometryStore* store, uint32_t parentIndex);
+		void UnregisterGeometry();
+		void SyncGeometry() const;
+
+		// 绘制提示框和扩展功能，子组件由调用者自行绘制
+		void RenderToolTipAndExtendedFunctions(Renderer& renderer) const;
+
 		void PreparationOfUpdateChildren();
 		void UpdateChildSizeConfigs(BaseComponent* cmp) const;
+		// 更新所有子组件，跳过位于可见内容区域之外的子树；applySizeConfigs为true时先应用子组件的大小配置
+		void UpdateChildren(bool applySizeConfigs);
 		void CalcVisibleGlobalRect(BaseComponent* parent, BaseComponent* target) const;
 		Rect CalcVisibleGlobalRect(const Rect& parentVisibleGRect, const Rect& parentContentGRect, const Rect& targetGRect) const;
 
-		// 计算包含所有子组件的最小矩形
-		// 在PreparationOfUpdateChildren之后调用
+		// 包含所有子组件的最小矩形（全局坐标），使用缓存的子组件边界
 		Rect CalcChildrenBoundaryGlobalRect(BaseComponent* cmp) const;
+
+	private:
+		friend class GeometryStore;
+		friend class Window;
+
+		ToolTip& GetOrCreateToolTip();
+		// 窗口字体替换后通知子树中没有自己字体的组件
+		void NotifyWindowFontChanged();
+		ExtendedFunctionsManager& GetOrCreateExtendedFunctionsManager();
+
+		void InvalidateParentLayout() {
+			if (!m_parent || !m_parent->m_isLayout) return;
+			if (m_parent->m_bulkUpdateDepth) m_parent->m_bulkChildrenChanged = true;
+			else m_parent->InvalidateLayout();
+		}
+		void OnChildrenChanged() { if (m_isLayout) InvalidateLayout(); }
+		void OnChildAdded(const Rect& rect);
+		void OnChildRemoved(const Rect& rect);
+		static constexpr size_t NOT_BULK_ENTERING = SIZE_MAX;
+
+		void AddBulkEnteredChild(BaseComponent* child);
+		// 子组件在批量更新结束前被移除时，在待进入组件树的列表中留下空位，返回是否去掉
+		bool DiscardBulkEnteredChild(BaseComponent* child);
+		// 通过子组件记录的下标查找，cmp不是该组件的子组件时返回nullptr
+		std::unique_ptr<BaseComponent>* FindChildSlot(BaseComponent* cmp);
+		void OnChildGeometryChanged(const Rect& oldRect, const Rect& newRect);
+		void RecalcChildrenBounds();
+		// 记录子组件是否被剔除，返回是否跳过其更新
+		bool CullChild(BaseComponent* child, const Vec2& contentOrigin, const Rect& cullGRect, bool allCulled) const;
+		void ClearVisibleGlobalRects();
 	};
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 #include "base_component.hpp"
 #include "label.hpp"
-#include "scroll_panel.hpp"
+#include "list_view.hpp"
 #include "signal.hpp"
 
 
@@ -15,7 +15,7 @@ namespace SimpleGui {
 		void Update() override;
 		void Render(Renderer& renderer) override;
 
-		std::string GetCurrentItem() const { return m_masterItemLbl->GetText(); }
+		std::string GetCurrentItem() const { return m_hasCurrentItem ? m_items[m_currIndex] : ""; }
 		std::string GetItem(size_t index) const;
 		std::vector<std::string> GetItems() const;
 		size_t GetItemCount() const;
@@ -37,6 +37,11 @@ namespace SimpleGui {
 		bool IsAutoHideItemsList() const { return m_autoHideItemsList; }
 		void SetAutoHideItemsList(bool hide) { m_autoHideItemsList = hide; }
 
+		// 下拉列表显示时输入的文本，只显示以该文本开头的项（不区分大小写）
+		const std::string& GetFilterText() const { return m_filterText; }
+		void SetFilterText(std::string_view text);
+		size_t GetFilteredItemCount() const { return m_filterText.empty() ? m_items.size() : m_filteredItems.size(); }
+
 	public:
 		// size_t index, const std::string& item
 		Signal<size_t, const std::string&> currentItemChanged;
@@ -45,25 +50,46 @@ namespace SimpleGui {
 		void EnteredComponentTree() override;
 
 	private:
+		class ItemsListModel;
+		class ItemsListDelegate;
+
+		static constexpr size_t INVALID_INDEX = static_cast<size_t>(-1);
+
 		std::vector<std::string> m_items;
-		std::vector<Label*> m_itemLbls;
+		std::vector<std::string> m_lowerItems;			// 小写的项，用于前缀匹配
+		std::vector<size_t> m_prefixIndex;				// 按小写的项排序的项下标
+		std::vector<size_t> m_filteredItems;			// 匹配过滤文本的项下标，按原顺序排列
+		std::string m_filterText;
+		std::string m_lowerFilterText;
 		std::unique_ptr<Label> m_masterItemLbl;
-		std::unique_ptr<ScrollPanel> m_itemsPanel;
+		std::unique_ptr<ListView> m_itemsList;
 		ComponentElementRect m_toggleRect;
 		size_t m_currIndex{};
+		size_t m_hoveredRow{ INVALID_INDEX };
+		size_t m_matchFirst{};							// 过滤文本在m_prefixIndex中的匹配范围 [first, last)
+		size_t m_matchLast{};
 		float m_maxItemsListHeight{};
 		float m_maxItemsListWidth{};
 		bool m_autoHideItemsList{ true };
-
-		BaseComponent* m_lastHoveredLbl{};
-		BaseComponent* m_hoveringLbl{};
-		BaseComponent* m_lastSelectedLbl{};
-		BaseComponent* m_selectedLbl{};
-
-		void AddItem(const std::string& item, bool addToItems);
+		bool m_hasCurrentItem{};
+		bool m_prefixIndexDirty{ true };
+		bool m_textInputStarted{};						// 文本输入是否由下拉列表开启
+
+		size_t GetItemIndex(size_t row) const { return m_filterText.empty() ? row : m_filteredItems[row]; }
+		size_t GetItemRow(size_t index) const;
+		void MeasureItem(const std::string& item);
+
+		void ShowItemsList(bool show);
+		void UpdateFilter(bool narrowing);
+		void RebuildPrefixIndex();
+		// 把新添加的项插入到有效的前缀索引中，同时更新匹配范围
+		void InsertPrefixIndex(size_t index);
+		void RefreshItemsList();
+		void SetHoveredRow(size_t row);
 
 		bool HandleToggleItemsList(Event* event);
 		bool HandleSelectItem(Event* event);
+		bool HandleTypeAhead(Event* event);
 		void RenderToggleRect(Renderer& renderer);
 		void RenderItemsList(Renderer& renderer);
 
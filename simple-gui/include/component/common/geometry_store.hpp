@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "math.hpp"
+
+
+namespace SimpleGui {
+	class BaseComponent;
+
+	// 每个窗口一份的组件几何数据，按字段分别连续存放（SoA），组件只保存下标
+	// 子组件的下标总是大于父组件，可见矩形的计算是一次按下标顺序的线性扫描
+	class GeometryStore final {
+	public:
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+		enum Flags : uint8_t {
+			Alive = 1 << 0,
+			Visible = 1 << 1,
+			Disabled = 1 << 2,
+			Changed = 1 << 3,				// 上次扫描之后自身的几何数据发生了变化
+			Hidden = 1 << 4,				// 存在不可见的祖先组件，由扫描计算
+		};
+
+		GeometryStore() = default;
+		~GeometryStore() = default;
+
+		GeometryStore(const GeometryStore&) = delete;
+		GeometryStore& operator=(const GeometryStore&) = delete;
+
+		// 新的槽位总是追加在末尾，以保证父组件的下标小于子组件
+		uint32_t Allocate(BaseComponent* owner, uint32_t parent);
+		void Release(uint32_t index);
+
+		void SetLocalRect(uint32_t index, const Rect& rect);
+		// 内容矩形（局部坐标原点偏移和内容大小），发生变化时返回true
+		bool SetContentRect(uint32_t index, const Vec2& origin, const Vec2& size);
+		void SetFlag(uint32_t index, Flags flag, bool value);
+		bool HasFlag(uint32_t index, Flags flag) const { return m_flags[index] & flag; }
+		void MarkChanged(uint32_t index) { m_flags[index] |= Changed; }
+
+		uint32_t GetParent(uint32_t index) const { return m_parents[index]; }
+		Vec2 GetGlobalPosition(uint32_t index) const { return Vec2(m_globalX[index], m_globalY[index]); }
+		Rect GetVisibleGlobalRect(uint32_t index) const;
+
+		// 按下标顺序计算所有槽位的全局位置和可见矩形，并清除Changed标记
+		// 死亡槽位过多时先进行压缩，压缩会更新组件保存的下标
+		void UpdateVisibleRects();
+
+		size_t GetSlotCount() const { return m_flags.size(); }
+		size_t GetAliveCount() const { return m_flags.size() - m_deadCount; }
+
+	private:
+		static constexpr size_t COMPACT_THRESHOLD = 64;
+
+		std::vector<float> m_localX;
+		std::vector<float> m_localY;
+		std::vector<float> m_width;
+		std::vector<float> m_height;
+		std::vector<float> m_originX;
+		std::vector<float> m_originY;
+		std::vector<float> m_contentW;
+		std::vector<float> m_contentH;
+		std::vector<float> m_globalX;
+		std::vector<float> m_globalY;
+		std::vector<float> m_visibleX;
+		std::vector<float> m_visibleY;
+		std::vector<float> m_visibleW;
+		std::vector<float> m_visibleH;
+		std::vector<uint8_t> m_flags;
+		std::vector<uint32_t> m_parents;
+		std::vector<BaseComponent*> m_owners;
+		size_t m_deadCount = 0;
+
+		void Compact();
+	};
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace SimpleGui {
+	// 基于piece table的文本缓冲区，原始文本只读，新增文本只追加到add buffer中
+	// 同时增量维护每一行起始位置（字节偏移）的索引，换行符属于所在行的末尾
+	class PieceTable final {
+	public:
+		explicit PieceTable(std::string_view text = "");
+		~PieceTable() = default;
+
+		std::string GetText() const;
+		void GetText(size_t offset, size_t length, std::string& out) const;
+		void SetText(std::string_view text);
+
+		void Insert(size_t offset, std::string_view text);
+		void Erase(size_t offset, size_t length);
+
+		size_t GetLength() const { return m_length; }
+		bool IsEmpty() const { return m_length == 0; }
+
+		size_t GetLineCount() const { return m_lineStarts.size(); }
+		size_t GetLineStart(size_t line) const { return m_lineStarts[line]; }
+		// 不包含换行符
+		size_t GetLineLength(size_t line) const;
+		size_t GetLineFromOffset(size_t offset) const;
+		void GetLineText(size_t line, std::string& out) const;
+
+	private:
+		enum class BufferType {
+			Original,
+			Add,
+		};
+
+		struct Piece final {
+			BufferType buffer;
+			size_t start;
+			size_t length;
+		};
+
+		std::string m_original;
+		std::string m_add;
+		std::vector<Piece> m_pieces;
+		std::vector<size_t> m_pieceOffsets;		// 每个piece在文本中的起始位置
+		std::vector<size_t> m_lineStarts;
+		size_t m_length;
+
+		const std::string& GetBuffer(BufferType type) const {
+			return type == BufferType::Original ? m_original : m_add;
+		}
+
+		size_t FindPiece(size_t offset) const;
+		void UpdatePieceOffsets(size_t fromPiece);
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+
+namespace SimpleGui {
+	// 行高索引，所有行高相同时只使用默认行高计算，O(1)
+	// 设置过单独的行高后使用树状数组（前缀和）维护，查询与修改均为O(log n)
+	class RowHeightIndex final {
+	public:
+		RowHeightIndex() = default;
+		~RowHeightIndex() = default;
+
+		void Reset(size_t count, float defaultHeight);
+		// 一次性设置所有行的行高，O(n)
+		void Reset(std::vector<float> heights, float defaultHeight);
+
+		size_t GetCount() const { return m_count; }
+		float GetDefaultHeight() const { return m_defaultHeight; }
+		bool IsUniform() const { return m_heights.empty(); }
+
+		float GetHeight(size_t row) const;
+		void SetHeight(size_t row, float height);
+
+		// 第row行顶部到第0行顶部的距离
+		float GetOffset(size_t row) const;
+		float GetTotalHeight() const { return static_cast<float>(m_totalHeight); }
+		// 返回包含y的行，y超出范围时返回最近的行
+		size_t FindRow(float y) const;
+
+	private:
+		std::vector<float> m_heights;
+		std::vector<double> m_tree;			// 树状数组，下标从1开始
+		size_t m_count = 0;
+		float m_defaultHeight = 0;
+		double m_totalHeight = 0;
+
+		void BuildTree();
+	};
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "math.hpp"
+#include "types.hpp"
+
+
+namespace SimpleGui {
+	class Renderer;
+	class Event;
+
+	// 不依赖子组件的滚动条，用于虚拟化组件（只渲染可见部分的组件）
+	// 滚动偏移量与内容长度、显示长度均由组件自身提供
+	class VirtualScrollBar final {
+	public:
+		explicit VirtualScrollBar(Direction direction = Direction::Vertical);
+		~VirtualScrollBar() = default;
+
+		bool HandleEvent(Event* event);
+		void Update(const Rect& slotGRect, const Rect& clipGRect, float contentLength, float viewLength);
+		void Render(Renderer& renderer, const Color& slotColor, const Color& sliderColor) const;
+
+		Direction GetDirection() const { return m_direction; }
+
+		float GetOffset() const { return m_offset; }
+		void SetOffset(float offset) { m_offset = Clamp(offset, 0, GetMaxOffset()); }
+		void ScrollBy(float delta) { SetOffset(m_offset + delta); }
+		float GetMaxOffset() const { return m_contentLength > m_viewLength ? m_contentLength - m_viewLength : 0; }
+
+		float GetThickness() const { return m_thickness; }
+		void SetThickness(float thickness) { m_thickness = thickness; }
+
+		// 内容长度大于显示长度时才需要显示滚动条
+		bool IsNeeded() const { return m_contentLength > m_viewLength; }
+		MouseState GetSliderState() const { return m_sliderState; }
+
+	private:
+		Direction m_direction;
+		MouseState m_sliderState;
+		Rect m_slotGRect;
+		Rect m_clipGRect;
+		Rect m_sliderGRect;
+		float m_offset;
+		float m_contentLength;
+		float m_viewLength;
+		float m_thickness;
+		float m_minSliderLength;
+		float m_dragStartMousePos;
+		float m_dragStartOffset;
+		bool m_dragging;
+
+		float GetAxis(const Vec2& v) const { return m_direction == Direction::Vertical ? v.y : v.x; }
+		float GetSlotLength() const { return GetAxis(m_slotGRect.size); }
+		float GetSliderLength() const { return GetAxis(m_sliderGRect.size); }
+	};
+}
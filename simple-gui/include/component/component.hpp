@@ -7,10 +7,15 @@
 #include "scrollbar.hpp"
 #include "scroll_panel.hpp"
 #include "line_edit.hpp"
+#include "text_edit.hpp"
 #include "progress_bar.hpp"
 #include "slider.hpp"
 #include "check_box.hpp"
 #include "combo_box.hpp"
+#include "list_view.hpp"
+#include "table_view.hpp"
 #include "layout/box_layout.hpp"
 #include "layout/anchor_point_layout.hpp"
+#include "layout/flex_layout.hpp"
+#include "layout/grid_layout.hpp"
 #include "common/types.hpp"
@@ -13,6 +13,7 @@ namespace SimpleGui {
 		bool HandleEvent(Event* event) override;
 		void Update() override;
 		void Render(Renderer& renderer) override;
+		Rect GetOpaqueGlobalRect() override;
 
 		std::string GetTitle() const { return m_titleLbl->GetText(); }
 		void SetTitle(std::string_view title) const { m_titleLbl->SetText(title); }
@@ -32,6 +32,7 @@ namespace SimpleGui {
 
 	protected:
 		void EnteredComponentTree() override;
+		void OnFontChanged() override;
 
 	private:
 		std::string m_text;
@@ -42,6 +42,9 @@ namespace SimpleGui {
 		std::unique_ptr<BaseComponent> RemoveChild(BaseComponent* cmp) override;
 		std::unique_ptr<BaseComponent> RemoveChildDeferred(BaseComponent* cmp) override;
 
+	protected:
+		void Arrange() override;
+
 	private:
 		std::unordered_map<BaseComponent*, AnchorPoint> m_anchorPoints;
 
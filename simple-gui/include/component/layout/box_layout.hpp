@@ -21,16 +21,24 @@ namespace SimpleGui {
 
 		void Update() override;
 
+	protected:
+		void Arrange() override;
+
 	private:
 		Direction m_direction;
 		Alignment m_alignment;
 		int m_spacing;
 		std::vector<int> m_weights;
 
-		void UpdateHorizontalDirection() const;
-		void UpdateVerticalDirection() const;
-
-		int GetVisibleChildrenCount() const;
+		// 测量结果，只在布局失效时重新计算
+		std::vector<BaseComponent*> m_fixedSizeChildren;
+		std::vector<BaseComponent*> m_expandingSizeChildren;
+		float m_totalFixedLength;
+		int m_totalWeight;
+		int m_visibleChildrenCount;
 
+		void Measure();
+		void ArrangeHorizontalDirection() const;
+		void ArrangeVerticalDirection() const;
 	};
 }
\ No newline at end of file
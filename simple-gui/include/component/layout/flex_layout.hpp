@@ -0,0 +1,107 @@
+#pragma once
+#include <optional>
+#include "layout.hpp"
+
+
+namespace SimpleGui {
+	enum class FlexJustify {
+		Begin,
+		Center,
+		End,
+		SpaceBetween,
+		SpaceAround,
+	};
+
+	enum class FlexAlign {
+		Begin,
+		Center,
+		End,
+		Stretch,
+	};
+
+	struct FlexItem final {
+		float basis = -1;							// 主轴上的初始大小，小于0时使用组件的最小大小
+		float grow = 0;
+		float shrink = 1;
+		Vec2 minSize;
+		Vec2 maxSize = Vec2(-1, -1);				// 小于0表示不限制
+		std::optional<FlexAlign> alignSelf;
+	};
+
+	// 弹性布局，支持换行、basis/grow/shrink和最小/最大大小。子组件参数被收集到连续的节点数组中一次求解
+	class FlexLayout final : public Layout {
+	public:
+		explicit FlexLayout(Direction direction = Direction::Horizontal);
+		~FlexLayout() override = default;
+
+		void Update() override;
+
+		std::unique_ptr<BaseComponent> RemoveChild(BaseComponent* cmp) override;
+		std::unique_ptr<BaseComponent> RemoveChildDeferred(BaseComponent* cmp) override;
+
+		Direction GetDirection() const { return m_direction; }
+		void SetDirection(Direction direction);
+
+		bool IsWrap() const { return m_wrap; }
+		void SetWrap(bool wrap);
+
+		FlexJustify GetJustify() const { return m_justify; }
+		void SetJustify(FlexJustify justify);
+
+		FlexAlign GetAlignItems() const { return m_alignItems; }
+		void SetAlignItems(FlexAlign align);
+
+		// 主轴方向上子组件之间的间距
+		float GetSpacing() const { return m_spacing; }
+		void SetSpacing(float spacing);
+
+		// 换行后行与行之间的间距
+		float GetLineSpacing() const { return m_lineSpacing; }
+		void SetLineSpacing(float spacing);
+
+		void SetFlexItem(BaseComponent* cmp, const FlexItem& item);
+		const FlexItem* GetFlexItem(BaseComponent* cmp) const;
+
+	protected:
+		void Arrange() override;
+
+	private:
+		struct Node final {
+			BaseComponent* cmp;
+			float basis;
+			float grow;
+			float shrink;
+			float minMain;
+			float maxMain;
+			float minCross;
+			float maxCross;
+			float main;
+			float cross;
+			FlexAlign align;
+			bool frozen;
+		};
+
+		struct Line final {
+			size_t begin;
+			size_t end;
+			float crossSize;
+		};
+
+		std::unordered_map<BaseComponent*, FlexItem> m_items;
+		std::vector<Node> m_nodes;
+		std::vector<Line> m_lines;
+		std::vector<Rect> m_rects;
+		LayoutResultCache m_resultCache;
+		Direction m_direction;
+		FlexJustify m_justify;
+		FlexAlign m_alignItems;
+		float m_spacing;
+		float m_lineSpacing;
+		bool m_wrap;
+
+		void CollectNodes();
+		void Solve(const Vec2& contentSize);
+		void ResolveFlexibleLengths(const Line& line, float availableMain);
+		void ApplyRects();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+#include "flex_layout.hpp"
+
+
+namespace SimpleGui {
+	enum class GridTrackType {
+		Fixed,
+		Auto,						// 适应所含组件的最小大小
+		Fraction,					// 按比例分配剩余空间
+	};
+
+	struct GridTrack final {
+		GridTrackType type = GridTrackType::Fraction;
+		float value = 1;			// Fixed时为像素大小，Fraction时为比例
+		float minSize = 0;
+		float maxSize = -1;			// 小于0表示不限制
+	};
+
+	struct GridItem final {
+		int row = -1;				// 行和列都小于0时自动放置，只设置其中一个时另一个视为0
+		int column = -1;
+		int rowSpan = 1;
+		int columnSpan = 1;
+		FlexAlign alignH = FlexAlign::Stretch;
+		FlexAlign alignV = FlexAlign::Stretch;
+	};
+
+	// 网格布局，支持跨行/跨列和自动放置。子组件参数被收集到连续的节点数组中一次求解
+	class GridLayout final : public Layout {
+	public:
+		explicit GridLayout(int columnCount = 1);
+		~GridLayout() override = default;
+
+		void Update() override;
+
+		std::unique_ptr<BaseComponent> RemoveChild(BaseComponent* cmp) override;
+		std::unique_ptr<BaseComponent> RemoveChildDeferred(BaseComponent* cmp) override;
+
+		const std::vector<GridTrack>& GetColumns() const { return m_columns; }
+		void SetColumns(const std::vector<GridTrack>& columns);
+		// 设置count个等比例的列
+		void SetColumnCount(int count);
+
+		// 超出行定义数量的行使用隐式行
+		const std::vector<GridTrack>& GetRows() const { return m_rows; }
+		void SetRows(const std::vector<GridTrack>& rows);
+		const GridTrack& GetImplicitRow() const { return m_implicitRow; }
+		void SetImplicitRow(const GridTrack& track);
+
+		Vec2 GetSpacing() const { return m_spacing; }
+		void SetSpacing(float h, float v);
+
+		void SetGridItem(BaseComponent* cmp, const GridItem& item);
+		void SetGridItem(BaseComponent* cmp, int row, int column, int rowSpan = 1, int columnSpan = 1);
+		const GridItem* GetGridItem(BaseComponent* cmp) const;
+
+		size_t GetRowCount() const { return m_rowCount; }
+
+	protected:
+		void Arrange() override;
+
+	private:
+		struct Node final {
+			BaseComponent* cmp;
+			Vec2 minSize;
+			int row;
+			int column;
+			int rowSpan;
+			int columnSpan;
+			FlexAlign alignH;
+			FlexAlign alignV;
+		};
+
+		struct TrackSizes final {
+			std::vector<float> sizes;
+			std::vector<float> offsets;
+			std::vector<float> contentMinSizes;
+		};
+
+		std::unordered_map<BaseComponent*, GridItem> m_items;
+		std::vector<GridTrack> m_columns;
+		std::vector<GridTrack> m_rows;
+		GridTrack m_implicitRow;
+		std::vector<Node> m_nodes;
+		std::vector<uint8_t> m_occupied;		// 行优先的单元格占用表
+		std::vector<Rect> m_rects;
+		TrackSizes m_columnSizes;
+		TrackSizes m_rowSizes;
+		LayoutResultCache m_resultCache;
+		Vec2 m_spacing;
+		size_t m_rowCount;
+
+		void CollectNodes();
+		void PlaceNodes();
+		bool IsAreaFree(int row, int column, int rowSpan, int columnSpan) const;
+		void OccupyArea(int row, int column, int rowSpan, int columnSpan);
+		void Solve(const Vec2& contentSize);
+		void SolveTracks(bool columns, float available);
+		const GridTrack& GetTrack(bool columns, size_t index) const;
+		void ApplyRects();
+	};
+}
\ No newline at end of file
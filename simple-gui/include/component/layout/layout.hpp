@@ -1,13 +1,35 @@
 #pragma once
+#include <bit>
 #include "../base_component.hpp"
 //#define SG_CMP_DEBUG_LAYOUT_BG
 
 namespace SimpleGui {
 	class Layout : public BaseComponent {
 	public:
-		Layout() = default;
+		Layout() { m_isLayout = true; }
 		~Layout() override = default;
 
+	protected:
+		// 测量并排列子组件，只修改子组件的几何数据
+		virtual void Arrange() {}
+
+		void ArrangeIfDirty() {
+			if (!m_layoutDirty) return;
+			m_layoutArranging = true;
+			Arrange();
+			m_layoutArranging = false;
+			m_layoutDirty = false;
+		}
+
+		// 并行阶段先完成排列，主线程的Update中布局不再是脏的
+		void UpdateLayoutParallel() override {
+			if (!m_visible || HasPendingChildChanges()) return;
+			ArrangeIfDirty();
+			BaseComponent::UpdateLayoutParallel();
+		}
+
+	public:
+
 #ifdef SG_CMP_DEBUG_LAYOUT_BG
 		virtual void Render(Renderer& renderer) override {
 			SG_CMP_RENDER_CONDITIONS;
@@ -16,4 +38,51 @@ namespace SimpleGui {
 		}
 #endif // SG_CMP_DEBUG_LAYOUT_BG
 	};
+
+
+	// 布局求解结果的缓存。输入（布局参数、子组件参数）不变时，以可用大小为键保存最近几次的结果
+	class LayoutResultCache final {
+	public:
+		static constexpr size_t CAPACITY = 4;
+
+		void BeginInputs() { m_hash = 14695981039346656037ull; }
+		void AddInput(uint64_t value) { m_hash = (m_hash ^ value) * 1099511628211ull; }
+		void AddInput(float value) { AddInput(static_cast<uint64_t>(std::bit_cast<uint32_t>(value))); }
+		void AddInput(const void* ptr) { AddInput(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr))); }
+
+		// 输入发生变化时清空已缓存的结果
+		void EndInputs() {
+			if (m_hash == m_inputHash) return;
+			m_inputHash = m_hash;
+			m_entries.clear();
+			m_next = 0;
+		}
+
+		const std::vector<Rect>* Find(const Vec2& availableSize) const {
+			for (const auto& entry : m_entries) {
+				if (entry.availableSize == availableSize) return &entry.rects;
+			}
+			return nullptr;
+		}
+
+		void Store(const Vec2& availableSize, const std::vector<Rect>& rects) {
+			if (m_entries.size() < CAPACITY) {
+				m_entries.push_back({ availableSize, rects });
+				return;
+			}
+			m_entries[m_next] = { availableSize, rects };
+			m_next = (m_next + 1) % CAPACITY;
+		}
+
+	private:
+		struct Entry final {
+			Vec2 availableSize;
+			std::vector<Rect> rects;
+		};
+
+		std::vector<Entry> m_entries;
+		size_t m_next = 0;
+		uint64_t m_hash = 0;
+		uint64_t m_inputHash = 0;
+	};
 }
\ No newline at end of file
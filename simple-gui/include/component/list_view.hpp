@@ -0,0 +1,93 @@
+#pragma once
+#include "base_component.hpp"
+#include "common/row_height_index.hpp"
+#include "common/virtual_scrollbar.hpp"
+
+
+namespace SimpleGui {
+	class ListViewModel {
+	public:
+		virtual ~ListViewModel() = default;
+
+		virtual size_t GetRowCount() const = 0;
+		// 返回true时不会逐行查询行高，所有行均使用ListView的默认行高
+		virtual bool HasFixedRowHeight() const { return true; }
+		// 返回值小于等于0时使用ListView的默认行高
+		virtual float GetRowHeight(size_t /*row*/) const { return 0; }
+	};
+
+
+	class ListViewDelegate {
+	public:
+		virtual ~ListViewDelegate() = default;
+
+		// 创建用于显示行的组件，组件会被回收并绑定到其他行
+		virtual std::unique_ptr<BaseComponent> CreateRowComponent() = 0;
+		virtual void BindRowComponent(BaseComponent* cmp, size_t row) = 0;
+	};
+
+
+	// 虚拟化列表，只为可见行（以及少量预留行）创建组件，滚动时回收并重新绑定行组件
+	class ListView final : public BaseComponent {
+	public:
+		static constexpr size_t INVALID_ROW = static_cast<size_t>(-1);
+
+		ListView();
+		~ListView() override = default;
+
+		bool HandleEvent(Event* event) override;
+		void Update() override;
+		void Render(Renderer& renderer) override;
+
+		ListViewModel* GetModel() const { return m_model.get(); }
+		void SetModel(std::shared_ptr<ListViewModel> model);
+
+		ListViewDelegate* GetDelegate() const { return m_delegate.get(); }
+		void SetDelegate(std::unique_ptr<ListViewDelegate> delegate);
+
+		float GetDefaultRowHeight() const { return m_defaultRowHeight; }
+		void SetDefaultRowHeight(float height);
+
+		size_t GetOverscan() const { return m_overscan; }
+		void SetOverscan(size_t count) { m_overscan = count; }
+
+		// 模型的行数或行高发生变化后调用
+		void ResetModel();
+		// 模型中的数据发生变化后调用，重新绑定可见的行
+		void UpdateRows(size_t first, size_t count);
+		void UpdateRowHeight(size_t row);
+
+		size_t GetRowCount() const { return m_heightIndex.GetCount(); }
+		size_t GetRowAtPosition(const Vec2& globalPos) const;
+		Rect GetRowGlobalRect(size_t row) const;
+		BaseComponent* GetRowComponent(size_t row) const;
+
+		float GetScrollOffset() const { return m_vScrollBar.GetOffset(); }
+		void SetScrollOffset(float offset) { m_vScrollBar.SetOffset(offset); }
+		void ScrollToRow(size_t row);
+
+	public:
+		Signal<size_t> rowClicked;
+
+	protected:
+		void EnteredComponentTree() override;
+		Vec2 GetContentSize() const override;
+
+	private:
+		std::shared_ptr<ListViewModel> m_model;
+		std::unique_ptr<ListViewDelegate> m_delegate;
+		RowHeightIndex m_heightIndex;
+		VirtualScrollBar m_vScrollBar;
+		std::vector<BaseComponent*> m_rowCmps;			// 第i个元素对应第m_firstRow + i行
+		std::vector<BaseComponent*> m_rowCmpsCache;
+		std::vector<BaseComponent*> m_freeRowCmps;
+		size_t m_firstRow;
+		float m_defaultRowHeight;
+		size_t m_overscan;
+		bool m_rowsDirty;
+
+		void UpdateVisibleRows();
+		void ReleaseRowComponent(BaseComponent* cmp);
+		BaseComponent* AcquireRowComponent();
+	};
+}
@@ -23,8 +23,18 @@ namespace SimpleGui {
 
 	private:
 		BaseComponent* m_handlingCmp{};
+		std::vector<BaseComponent*> m_parallelSubtrees;
+		// 遮挡剔除，每帧复用
+		std::vector<bool> m_occludedChildren;
+		std::vector<Rect> m_occluders;
+		std::vector<Rect> m_occlusionFragments;
+		std::vector<Rect> m_occlusionScratch;
 
 		explicit RootComponent(Window* window);
 		void SetSizeToFillWindow();
+		void UpdateSubtreesParallel();
+		// 从前往后遍历顶层子组件，标记被之前（更上层）的不透明区域完全覆盖的子组件
+		void CollectOccludedChildren();
+		bool IsOccluded(const Rect& rect);
 	};
 }
\ No newline at end of file
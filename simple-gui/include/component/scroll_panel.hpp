@@ -11,19 +11,61 @@ namespace SimpleGui {
 		void SetHScrollBarVisible(bool visible) const { m_hScrollBar->SetVisible(visible); }
 		void SetVScrollBarVisible(bool visible) const { m_vScrollBar->SetVisible(visible); }
 
+		// 开启后子组件绘制到缓存纹理中，滚动时复用已绘制的内容，只重绘新露出的区域
+		// 滚动过程中子组件自身的变化需要通过AddDamageRect通知，滚动停止后会完整重绘一次
+		// 没有滚动时比较子组件记录的绘制命令，与缓存的内容相同时直接使用缓存，不再绘制到纹理中
+		bool IsBlitScrollEnabled() const { return m_blitScrollEnabled; }
+		void SetBlitScrollEnabled(bool enabled);
+
+		bool IsKineticScrollEnabled() const { return m_kineticScrollEnabled; }
+		void SetKineticScrollEnabled(bool enabled);
+
+		// 以给定的速度（像素/秒，滑块坐标）开始惯性滚动
+		void Fling(const Vec2& velocity);
+
+		void AddDamageRect(const Rect& gRect);
+		void InvalidateScrollCache() { m_scrollCache.valid = false; }
+
 		bool HandleEvent(Event* event) override;
 		void Update() override;
 		void Render(Renderer& renderer) override;
+		Rect GetOpaqueGlobalRect() override;
 
 	protected:
 		void EnteredComponentTree() override;
 		inline Vec2 GetContentSize() const override;
 
 	private:
+		struct ScrollCache final {
+			UniqueTexturePtr textures[2];
+			std::vector<Rect> damageRects;
+			Rect contentGRect;
+			Vec2 outputSize;
+			Vec2 scrollDelta;			// 上次绘制后子组件的位移
+			Vec2 residual;				// 复制纹理时取整产生的累计误差
+			Uint64 contentHash = 0;		// 完整重绘时子组件主层命令的指纹
+			int front = 0;
+			bool valid = false;
+		};
+
 		const int SCROLL_BAR_THICKNESS = 15;
+		const float KINETIC_FRICTION = 6.f;
+		const float KINETIC_STOP_SPEED = 5.f;
 
 		std::unique_ptr<ScrollBar> m_hScrollBar;
 		std::unique_ptr<ScrollBar> m_vScrollBar;
+		ScrollCache m_scrollCache;
+		Vec2 m_kineticVelocity;
 		bool m_shiftPressed;
+		bool m_blitScrollEnabled;
+		bool m_kineticScrollEnabled;
+
+		void UpdateKineticScroll();
+		// 更新滚动条的位置和滑块，拖动或滚轮滚动时平移子组件
+		void UpdateScrollBars();
+		bool RenderChildrenCached(Renderer& renderer);
+		// 清空gRect后重绘与其相交的子组件，每个子组件只绘制一次
+		void RenderChildrenInRect(Renderer& renderer, const Rect& gRect);
+		bool PrepareScrollCache(Renderer& renderer);
 	};
-}
\ No newline at end of file
+}
@@ -50,7 +50,6 @@ namespace SimpleGui {
 	private:
 		void UpdateHorizontalSlider(const Rect& boundaryGRect, const Rect& targetContentGRect);
 		void UpdateVerticalSlider(const Rect& boundaryGRect, const Rect& targetContentGRect);
-		void UpdateTargetChildrenPosition(BaseComponent* cmp, float distance) const;
 		void UpdateSliderPositionByWheel(float delta, int direction);
 		static Rect AdjustTargetChildrenBoundaryGlobalRect(const Rect& boundaryGRect, const Rect& targetContentGRect);
 	};
@@ -0,0 +1,200 @@
+#pragma once
+#include <future>
+#include <format>
+#include "base_component.hpp"
+#include "deleter.hpp"
+#include "common/virtual_scrollbar.hpp"
+
+
+namespace SimpleGui {
+	// 列式数据源中的一列，每列保存自己类型的数据数组
+	class TableColumn {
+	public:
+		explicit TableColumn(std::string_view title, float width = 100) : m_title(title), m_width(width) {}
+		virtual ~TableColumn() = default;
+
+		const std::string& GetTitle() const { return m_title; }
+		void SetTitle(std::string_view title) { m_title = title; }
+
+		float GetWidth() const { return m_width; }
+		void SetWidth(float width) { m_width = width; }
+
+		// 数据每次修改后递增，用于判断单元格缓存是否需要重新格式化
+		uint64_t GetVersion() const { return m_version; }
+
+		virtual size_t GetRowCount() const = 0;
+		virtual void FormatCell(size_t row, std::string& out) const = 0;
+		// 基于当前数据快照创建比较函数，返回的函数可以在后台线程中使用
+		virtual std::function<bool(size_t, size_t)> CreateSortComparator() const = 0;
+
+	protected:
+		std::string m_title;
+		float m_width;
+		uint64_t m_version = 0;
+	};
+
+
+	template<typename T>
+	class TypedTableColumn final : public TableColumn {
+	public:
+		using Formatter = std::function<void(const T&, std::string&)>;
+
+		explicit TypedTableColumn(std::string_view title, Formatter formatter = nullptr, float width = 100) :
+			TableColumn(title, width), m_formatter(std::move(formatter)) {}
+
+		size_t GetRowCount() const override { return m_values.size(); }
+
+		const T& GetValue(size_t row) const { return m_values[row]; }
+		void SetValue(size_t row, const T& value) {
+			m_values[row] = value;
+			++m_version;
+		}
+
+		const std::vector<T>& GetValues() const { return m_values; }
+		void SetValues(std::vector<T> values) {
+			m_values = std::move(values);
+			++m_version;
+		}
+
+		void AddValue(const T& value) {
+			m_values.push_back(value);
+			++m_version;
+		}
+
+		void SetFormatter(Formatter formatter) {
+			m_formatter = std::move(formatter);
+			++m_version;
+		}
+
+		void FormatCell(size_t row, std::string& out) const override {
+			out.clear();
+			if (row >= m_values.size()) return;
+			if (m_formatter) m_formatter(m_values[row], out);
+			else std::format_to(std::back_inserter(out), "{}", m_values[row]);
+		}
+
+		std::function<bool(size_t, size_t)> CreateSortComparator() const override {
+			auto snapshot = std::make_shared<const std::vector<T>>(m_values);
+			return [snapshot](size_t a, size_t b) {
+				return (*snapshot)[a] < (*snapshot)[b];
+				};
+		}
+
+	private:
+		std::vector<T> m_values;
+		Formatter m_formatter;
+	};
+
+
+	// 虚拟化表格，只渲染可见的单元格，排序在后台线程中对行索引的排列进行
+	class TableView final : public BaseComponent {
+	public:
+		static constexpr size_t INVALID_INDEX = static_cast<size_t>(-1);
+
+		TableView();
+		~TableView() override = default;
+
+		bool HandleEvent(Event* event) override;
+		void Update() override;
+		void Render(Renderer& renderer) override;
+
+		template<typename T>
+		TypedTableColumn<T>* AddColumn(std::string_view title, typename TypedTableColumn<T>::Formatter formatter = nullptr, float width = 100) {
+			auto column = std::make_unique<TypedTableColumn<T>>(title, std::move(formatter), width);
+			auto ptr = column.get();
+			AddColumn(std::move(column));
+			return ptr;
+		}
+
+		void AddColumn(std::unique_ptr<TableColumn> column);
+		TableColumn* GetColumn(size_t index) const { return index < m_columns.size() ? m_columns[index].get() : nullptr; }
+		size_t GetColumnCount() const { return m_columns.size(); }
+		size_t GetRowCount() const { return m_rowCount; }
+
+		float GetRowHeight() const { return m_rowHeight; }
+		void SetRowHeight(float height) { m_rowHeight = height; }
+
+		float GetMinColumnWidth() const { return m_minColumnWidth; }
+		void SetMinColumnWidth(float width) { m_minColumnWidth = width; }
+
+		void SortByColumn(size_t column, bool ascending = true);
+		void ClearSort();
+		bool IsSorting() const { return m_sortFuture.valid(); }
+		size_t GetSortColumn() const { return m_sortColumn; }
+		bool IsSortAscending() const { return m_sortAscending; }
+
+		// 视图中的行号与数据中的行号之间的映射（排序后不同）
+		size_t MapViewRowToDataRow(size_t viewRow) const {
+			return viewRow < m_order.size() ? m_order[viewRow] : viewRow;
+		}
+
+		void ScrollToRow(size_t viewRow);
+
+	public:
+		Signal<size_t, size_t> cellClicked;			// 数据行号，列号
+		Signal<size_t, bool> sorted;
+
+	protected:
+		void EnteredComponentTree() override;
+		void OnFontChanged() override;
+
+	private:
+		struct CellCache final {
+			UniqueTextPtr text;
+			std::string string;
+			uint64_t version = 0;
+			uint64_t frame = 0;
+		};
+
+		struct HeaderCache final {
+			UniqueTextPtr text;
+			std::string title;
+		};
+
+		struct SortRequest final {
+			size_t column;
+			bool ascending;
+		};
+
+		struct ResizeColumnData final {
+			size_t column = INVALID_INDEX;
+			float startMousePosX = 0;
+			float startWidth = 0;
+		};
+
+		std::vector<std::unique_ptr<TableColumn>> m_columns;
+		std::vector<HeaderCache> m_headerCaches;
+		std::unordered_map<uint64_t, CellCache> m_cellCaches;		// key: 数据行号 << 16 | 列号
+		std::vector<size_t> m_order;
+		std::future<std::vector<size_t>> m_sortFuture;
+		std::optional<SortRequest> m_pendingSort;
+		std::string m_formatBuffer;
+		VirtualScrollBar m_vScrollBar;
+		VirtualScrollBar m_hScrollBar;
+		ResizeColumnData m_resizeColumnData;
+		UniqueCursorPtr m_resizeCursor;
+		Rect m_headerGRect;
+		Rect m_cellsGRect;
+		size_t m_rowCount;
+		size_t m_firstRow;
+		size_t m_lastRow;
+		size_t m_sortColumn;
+		uint64_t m_frame;
+		float m_rowHeight;
+		float m_minColumnWidth;
+		bool m_sortAscending;
+
+		float GetTotalColumnsWidth() const;
+		size_t GetColumnAtPosition(float x, bool* onSeparator = nullptr) const;
+		void StartSort(size_t column, bool ascending);
+		void PollSortResult();
+		void UpdateScrollBars();
+		void UpdateHeaderTexts();
+		void UpdateCellCaches();
+		TTF_Text* GetCellText(size_t dataRow, size_t column) const;
+
+		static uint64_t MakeCellKey(size_t dataRow, size_t column) {
+			return (static_cast<uint64_t>(dataRow) << 16) | (column & 0xffff);
+		}
+	};
+}
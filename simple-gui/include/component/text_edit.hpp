@@ -0,0 +1,100 @@
+#pragma once
+#include "base_component.hpp"
+#include "deleter.hpp"
+#include "common/caret.hpp"
+#include "common/piece_table.hpp"
+#include "common/virtual_scrollbar.hpp"
+
+
+namespace SimpleGui {
+	// 多行文本编辑器，只为可见行创建TTF_Text，适用于编辑大文本
+	class TextEdit final : public BaseComponent {
+	public:
+		explicit TextEdit(std::string_view text = "");
+		~TextEdit() override = default;
+
+		bool HandleEvent(Event* event) override;
+		void Update() override;
+		void Render(Renderer& renderer) override;
+
+		std::string GetText() const { return m_document.GetText(); }
+		void SetText(std::string_view text);
+		std::string GetSelectedText() const;
+		size_t GetLineCount() const { return m_document.GetLineCount(); }
+
+		// 光标位置为文本中的字节偏移
+		size_t GetCaretPosition() const { return m_caretOffset; }
+		void SetCaretPosition(size_t offset);
+		void Select(size_t start, size_t end);
+		void SelectAll() { Select(0, m_document.GetLength()); }
+		bool HasSelection() const { return m_anchorOffset != m_caretOffset; }
+
+		void InsertText(std::string_view text);
+
+		bool IsEditable() const { return m_editable; }
+		void SetEditable(bool value) { m_editable = value; }
+
+		bool IsCaretBlink() const { return m_caret.IsBlink(); }
+		void SetCaretBlink(bool blink) { m_caret.SetBlink(blink); }
+		float GetCaretBlinkInterval() const { return m_caret.GetBlinkInterval(); }
+		void SetCaretBlinkInterval(float interval) { m_caret.SetBlinkInterval(interval); }
+
+	public:
+		Signal<> textChanged;
+
+	protected:
+		void EnteredComponentTree() override;
+		void OnFontChanged() override { m_lineCaches.clear(); }
+
+	private:
+		struct LineCache final {
+			UniqueTextPtr text;
+			float width;
+		};
+
+		PieceTable m_document;
+		std::unordered_map<size_t, LineCache> m_lineCaches;		// key: 行号，只保存可见行
+		std::vector<Rect> m_selectionGRects;
+		std::string m_lineBuffer;
+		VirtualScrollBar m_vScrollBar;
+		VirtualScrollBar m_hScrollBar;
+		UniqueCursorPtr m_cursor;
+		Caret m_caret;
+		Rect m_textViewGRect;
+		size_t m_caretOffset;
+		size_t m_anchorOffset;
+		size_t m_caretLine;
+		size_t m_firstVisibleLine;
+		size_t m_lastVisibleLine;
+		float m_lineHeight;
+		float m_contentWidth;
+		float m_caretX;
+		float m_preferredCaretX;
+		bool m_active;
+		bool m_editable;
+		bool m_selecting;
+		bool m_caretDirty;
+		bool m_ensureCaretVisible;
+
+		Vec2 GetTextOrigin() const;
+		float GetColumnX(size_t line, size_t column);
+		size_t MapXToColumn(size_t line, float x);
+		size_t MapPositionToOffset(const Vec2& pos);
+		size_t GetPrevCharOffset(size_t offset);
+		size_t GetNextCharOffset(size_t offset);
+
+		void MoveCaret(size_t offset, bool select, bool keepPreferredX = false);
+		void MoveCaretVertically(long long lines, bool select);
+		void EraseRange(size_t offset, size_t length);
+		void InvalidateLines(size_t line, bool lineCountChanged);
+		void UpdateScrollBars();
+		void UpdateLineCaches();
+		void UpdateCaret();
+		void UpdateSelectionRects();
+
+		bool HandleMouseCursor(Event* event) const;
+		bool HandleMouse(Event* event);
+		bool HandleInputText(Event* event);
+		bool HandleShortKey(Event* event);
+	};
+}
@@ -12,7 +12,8 @@ namespace SimpleGui {
 
 		std::shared_ptr<Texture> GetTexture() const;
 		void SetTexture(const std::shared_ptr<Texture> &texture);
-		void SetTexture(std::string_view path);
+		// 图片常被缩小显示时开启mipmaps，按显示尺寸使用缩小级别
+		void SetTexture(std::string_view path, bool mipmaps = false);
 
 		TextureStretchMode GetTextureStretchMode() const;
 		void SetTextureStretchMode(TextureStretchMode mode);
@@ -40,6 +41,5 @@ namespace SimpleGui {
 	private:
 		void SetupTipLabel() const;
 		void UpdateTextureStretchMode();
-		void RenderTexture(SDL_Renderer* renderer) const;
 	};
 }
\ No newline at end of file
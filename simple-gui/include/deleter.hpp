@@ -28,4 +28,5 @@ namespace SimpleGui {
     struct TextureDeleter final {
         void operator()(SDL_Texture* texture) const noexcept;
     };
+    using UniqueTexturePtr = std::unique_ptr<SDL_Texture, TextureDeleter>;
 }
\ No newline at end of file
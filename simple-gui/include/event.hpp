@@ -3,6 +3,7 @@
 #include <chrono>
 #include "math.hpp"
 #include "window.hpp"
+#include "slab_allocator.hpp"
 
 
 namespace SimpleGui {
@@ -51,6 +52,8 @@ namespace SimpleGui {
 		friend class EventManager;
 
 	public:
+		SG_SLAB_ALLOCATED
+
 		Event() = default;
 		virtual ~Event() = default;
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <unordered_map>
+#include "slab_allocator.hpp"
 
 
 namespace SimpleGui {
@@ -10,6 +11,8 @@ namespace SimpleGui {
 
 	class ExtendedFunctions {
 	public:
+		SG_SLAB_ALLOCATED
+
 		virtual ~ExtendedFunctions() = default;
 
 	protected:
@@ -25,6 +28,8 @@ namespace SimpleGui {
 	class ExtendedFunctionsManager final {
 		friend class BaseComponent;
 	public:
+		SG_SLAB_ALLOCATED
+
 		explicit ExtendedFunctionsManager(BaseComponent* target);
 		~ExtendedFunctionsManager() = default;
 
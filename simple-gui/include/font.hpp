@@ -25,7 +25,7 @@ namespace SimpleGui {
 		std::string GetPath() const { return m_path; }
 
 		float GetSize() const { return TTF_GetFontSize(m_font); }
-		void SetSize(float ptsize) const { TTF_SetFontSize(m_font, ptsize); }
+		void SetSize(float ptsize) { TTF_SetFontSize(m_font, ptsize); }
 		
 		int GetHeight() const { return TTF_GetFontHeight(m_font); }
 		Vec2 GetTextSize(std::string_view text) const {
@@ -41,7 +41,7 @@ namespace SimpleGui {
 		std::string GetFamilyName() const { return TTF_GetFontFamilyName(m_font); }
 
 		FontStyle GetStyle() const { return static_cast<FontStyle>(TTF_GetFontStyle(m_font)); }
-		void SetStyle(FontStyle style) const { TTF_SetFontStyle(m_font,  static_cast<TTF_FontStyleFlags>(style));  }
+		void SetStyle(FontStyle style) { TTF_SetFontStyle(m_font,  static_cast<TTF_FontStyleFlags>(style));  }
 
 		bool IsNull() const { return m_font == nullptr; }
 
@@ -6,6 +6,7 @@
 #include "framerate.hpp"
 #include "timer.hpp"
 #include "font.hpp"
+#include "job_system.hpp"
 
 
 #define SG_GuiManager SimpleGui::GuiManager::GetInstance()
@@ -75,6 +76,8 @@ namespace SimpleGui {
 
         Vec2 GetMousePosition() const;
 
+        JobSystem& GetJobSystem() const { return *m_jobSystem; }
+
     private:
         static std::unique_ptr<GuiManager> s_guiManager;
 
@@ -84,6 +87,7 @@ namespace SimpleGui {
         std::unique_ptr<EventManager> m_eventManager;
         std::unique_ptr<FrameRateController> m_fpsController;
         std::unique_ptr<TimerManager> m_timerManager;
+        std::unique_ptr<JobSystem> m_jobSystem;
 
         GuiManager() = default;
     };
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace SimpleGui {
+	// 工作窃取线程池。每个线程拥有自己的任务队列，从队尾取自己的任务，空闲时从其他队列的队首窃取
+	// 任务只是函数指针加下标，提交和执行都不产生堆分配
+	class JobSystem final {
+	public:
+		// workerCount为0时使用（硬件线程数 - 1）个工作线程，提交任务的线程本身也参与执行
+		explicit JobSystem(size_t workerCount = 0);
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		size_t GetWorkerCount() const { return m_queueCount - 1; }
+
+		// 对[0, count)中的每个下标并行调用fn(index)，全部完成后返回
+		template<typename Fn>
+		void ParallelFor(size_t count, Fn&& fn) {
+			if (count == 0) return;
+			if (count == 1 || m_queueCount == 1) {
+				for (size_t i = 0; i < count; ++i) fn(i);
+				return;
+			}
+
+			using Callable = std::remove_reference_t<Fn>;
+			Dispatch(count, [](void* context, size_t index) { (*static_cast<Callable*>(context))(index); },
+				const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+		}
+
+	private:
+		using JobFunction = void (*)(void* context, size_t index);
+
+		struct Job final {
+			JobFunction fn;
+			void* context;
+			size_t index;
+			std::atomic<size_t>* remaining;
+		};
+
+		// 固定容量的双端队列，所有者在队尾存取，窃取者从队首取
+		struct alignas(64) WorkQueue final {
+			static constexpr size_t CAPACITY = 1024;
+
+			std::mutex mutex;
+			Job jobs[CAPACITY];
+			size_t head = 0;
+			size_t tail = 0;
+
+			bool Push(const Job& job);
+			bool Pop(Job& job);
+			bool Steal(Job& job);
+		};
+
+		std::unique_ptr<WorkQueue[]> m_queues;		// 0号队列属于不是工作线程的调用者（主线程）
+		size_t m_queueCount = 1;
+		std::vector<std::thread> m_threads;
+		std::atomic<size_t> m_queuedJobs{};
+		std::atomic<bool> m_running{ true };
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+
+		void Dispatch(size_t count, JobFunction fn, void* context);
+		bool TryRunJob(size_t queueIndex);
+		void WorkerLoop(size_t queueIndex);
+	};
+}
@@ -1,15 +1,43 @@
 #pragma once
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <iostream>
 #include <vector>
 #include <format>
 #include <source_location>
-
-
-#define SG_INFO(x, ...) SimpleGui::Logger::GetInstance().Info(x, __VA_ARGS__);
-#define SG_WARN(x, ...) SimpleGui::Logger::GetInstance().Warn(x, __VA_ARGS__);
-#define SG_ERROR(x, ...) SimpleGui::Logger::GetInstance().Error(std::source_location::current(), x, __VA_ARGS__);
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+
+// 编译期过滤日志等级，低于该等级的日志调用不会生成任何代码。0: Info, 1: Warn, 2: Error, 3: None
+#ifndef SG_LOG_LEVEL
+#define SG_LOG_LEVEL 0
+#endif
+
+#if SG_LOG_LEVEL <= 0
+#define SG_INFO(x, ...) SimpleGui::Logger::GetInstance().Log(SimpleGui::LogLevel::Info, std::source_location::current(), x __VA_OPT__(,) __VA_ARGS__)
+#else
+#define SG_INFO(x, ...) ((void)0)
+#endif
+
+#if SG_LOG_LEVEL <= 1
+#define SG_WARN(x, ...) SimpleGui::Logger::GetInstance().Log(SimpleGui::LogLevel::Warn, std::source_location::current(), x __VA_OPT__(,) __VA_ARGS__)
+#else
+#define SG_WARN(x, ...) ((void)0)
+#endif
+
+#if SG_LOG_LEVEL <= 2
+#define SG_ERROR(x, ...) SimpleGui::Logger::GetInstance().Log(SimpleGui::LogLevel::Error, std::source_location::current(), x __VA_OPT__(,) __VA_ARGS__)
+#else
+#define SG_ERROR(x, ...) ((void)0)
+#endif
 
 
 namespace SimpleGui {
@@ -25,9 +53,12 @@ namespace SimpleGui {
         std::string message{};
     };
 
+    // 异步日志。调用处只把格式字符串和按值复制的参数写入无锁环形队列，格式化和输出在后台线程中进行
+    // 字符串类参数（const char*、std::string等）复制到记录内的定长缓冲区，其余参数按值保存，调用处不分配内存
+    // 队列已满时丢弃日志并计数，不会阻塞调用处
     class Logger final {
     public:
-        ~Logger() = default;
+        ~Logger();
 
         Logger(const Logger &) = delete;
         Logger &operator=(const Logger &) = delete;
@@ -37,64 +68,187 @@ namespace SimpleGui {
         static Logger& GetInstance();
 
         void Setup(bool consoleLog, bool retainLog);
-        const std::vector<LogAEntry>& GetLogEntries() const { return m_logEntries; }
+        // 同时追加写入到文件，path为空时关闭
+        bool SetLogFile(const std::string& path);
+        std::vector<LogAEntry> GetLogEntries() const;
         bool SaveToFile(const std::string& filePath) const;
         void Clear();
 
+        // 等待调用该函数之前记录的日志全部输出
+        void Flush() const;
+        size_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
         template<typename... Args>
-        void Info(const std::string &message, Args &&... args) {
-            std::stringstream ss;
-            ss << "SimpleGui [INFO]: "
-                    << CurrentDateTime() << " - " << std::vformat(
-                        message, std::make_format_args(std::forward<Args>(args)...)) << "\n";
-
-            OutputToConsole(LogLevel::Info, ss.str());
-            RetainLogs(LogLevel::Info, ss.str());
+        void Log(LogLevel level, std::source_location location, std::format_string<Args...> format, Args &&... args) {
+            using Pack = std::tuple<LogArgType<Args>...>;
+
+            bool pushed = m_queue.TryPush([&](LogRecord &record) {
+                record.level = level;
+                record.location = location;
+                record.time = std::chrono::system_clock::now();
+                record.format = format.get();
+
+                if constexpr (sizeof(Pack) <= LogRecord::STORAGE_SIZE && alignof(Pack) <= alignof(std::max_align_t)) {
+                    if ((FitsLogString(args) && ...)) {
+                        new (record.args) Pack(std::forward<Args>(args)...);
+                        record.formatFn = &FormatPack<Pack>;
+                        return;
+                    }
+                }
+                // 参数过大或字符串过长时退化为在调用处格式化
+                new (record.args) std::string(std::vformat(format.get(), std::make_format_args(args...)));
+                record.formatFn = &FormatPreformatted;
+            });
+
+            if (!pushed) m_dropped.fetch_add(1, std::memory_order_relaxed);
         }
 
-        template<typename... Args>
-        void Warn(const std::string &message, Args &&... args) {
-            std::stringstream ss;
-            ss << "SimpleGui [WARN]: "
-                    << CurrentDateTime() << " - " << std::vformat(
-                        message, std::make_format_args(std::forward<Args>(args)...)) << "\n";
-
-            OutputToConsole(LogLevel::Warn, ss.str());
-            RetainLogs(LogLevel::Warn, ss.str());
+    private:
+        // 记录内保存字符串参数的定长缓冲区
+        struct LogString final {
+            static constexpr size_t CAPACITY = 63;
+
+            char data[CAPACITY];
+            size_t length;
+
+            explicit LogString(std::string_view text) : length(text.size() < CAPACITY ? text.size() : CAPACITY) {
+                std::char_traits<char>::copy(data, text.data(), length);
+            }
+            std::string_view View() const { return { data, length }; }
+        };
+
+        template<typename T>
+        using LogArgType = std::conditional_t<std::is_convertible_v<T, std::string_view>, LogString, std::decay_t<T>>;
+
+        template<typename T>
+        static bool FitsLogString(const T& arg) {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>) return std::string_view(arg).size() <= LogString::CAPACITY;
+            else return true;
         }
 
-        template<typename... Args>
-        void Error(std::source_location location, const std::string &message, Args &&... args) {
-            std::stringstream ss;
-            ss << "SimpleGui [ERROR]: "
-                    << CurrentDateTime() << " - " << std::vformat(
-                        message, std::make_format_args(std::forward<Args>(args)...))
-                    << "\nFUNC: " << location.function_name()
-                    << "\nLINE: " << location.line() << "\n\n";
-
-            OutputToConsole(LogLevel::Error, ss.str());
-            RetainLogs(LogLevel::Error, ss.str());
+        template<typename T>
+        static decltype(auto) ToFormatArg(const T& arg) {
+            if constexpr (std::is_same_v<T, LogString>) return arg.View();
+            else return (arg);
         }
 
-    private:
-        std::vector<LogAEntry> m_logEntries {};
-        bool m_consoleLog{true};
-        bool m_retainLogs{false};
+        // 格式化参数并析构参数包
+        using FormatFunction = void (*)(std::string_view format, void* args, std::string& out);
 
-        struct LogTime final {
-            std::string day;
-            std::string dayNumber;
-            std::string month;
-            std::string year;
-            std::string time;
+        struct LogRecord final {
+            static constexpr size_t STORAGE_SIZE = 192;
+
+            LogLevel level;
+            std::source_location location;
+            std::chrono::system_clock::time_point time;
+            std::string_view format;
+            FormatFunction formatFn;
+            alignas(std::max_align_t) std::byte args[STORAGE_SIZE];
+        };
 
-            explicit LogTime(const std::string& date);
+        // 有界多生产者多消费者队列（Dmitry Vyukov），每个单元通过序号判断是否可写/可读
+        class RingBuffer final {
+        public:
+            static constexpr size_t CAPACITY = 1024;
+
+            RingBuffer();
+
+            template<typename Fn>
+            bool TryPush(Fn&& fill) {
+                size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+                Cell* cell;
+                for (;;) {
+                    cell = &m_cells[pos & (CAPACITY - 1)];
+                    size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                    if (diff == 0) {
+                        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                    }
+                    else if (diff < 0) {
+                        return false;
+                    }
+                    else {
+                        pos = m_enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                fill(cell->record);
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            template<typename Fn>
+            bool TryPop(Fn&& consume) {
+                size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+                Cell* cell;
+                for (;;) {
+                    cell = &m_cells[pos & (CAPACITY - 1)];
+                    size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                    if (diff == 0) {
+                        if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                    }
+                    else if (diff < 0) {
+                        return false;
+                    }
+                    else {
+                        pos = m_dequeuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                consume(cell->record);
+                cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+                return true;
+            }
+
+            size_t GetEnqueuePosition() const { return m_enqueuePos.load(std::memory_order_acquire); }
+
+        private:
+            struct Cell final {
+                std::atomic<size_t> sequence;
+                LogRecord record;
+            };
+
+            std::unique_ptr<Cell[]> m_cells;
+            alignas(64) std::atomic<size_t> m_enqueuePos{};
+            alignas(64) std::atomic<size_t> m_dequeuePos{};
         };
 
-        Logger() = default;
+        RingBuffer m_queue;
+        std::atomic<size_t> m_processed{};
+        std::atomic<size_t> m_dropped{};
+        std::atomic<bool> m_running{true};
+        std::atomic<bool> m_consoleLog{true};
+        std::atomic<bool> m_retainLogs{false};
+
+        mutable std::mutex m_mutex;             // 保护m_logEntries和m_logFile
+        std::vector<LogAEntry> m_logEntries {};
+        std::ofstream m_logFile;
+        std::thread m_thread;
+
+        Logger();
+
+        template<typename Pack>
+        static void FormatPack(std::string_view format, void* args, std::string& out) {
+            auto pack = static_cast<Pack*>(args);
+            try {
+                std::apply([&](auto &... a) {
+                    // LogString转为std::string_view，其余参数按引用传入
+                    std::tuple<decltype(ToFormatArg(a))...> formatArgs(ToFormatArg(a)...);
+                    std::apply([&](auto &... f) { out = std::vformat(format, std::make_format_args(f...)); }, formatArgs);
+                }, *pack);
+            }
+            catch (const std::format_error& e) {
+                out = std::string(format) + " <format error: " + e.what() + ">";
+            }
+            pack->~Pack();
+        }
+
+        static void FormatPreformatted(std::string_view format, void* args, std::string& out);
 
-        std::string CurrentDateTime() const;
+        void Run();
+        void Write(LogRecord& record, std::string& message, std::string& line);
+        static void FormatDateTime(std::chrono::system_clock::time_point time, std::string& out);
         void OutputToConsole(LogLevel level, const std::string& message) const;
-        void RetainLogs(LogLevel level, const std::string& message);
     };
-}
\ No newline at end of file
+}
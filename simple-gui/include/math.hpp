@@ -171,5 +171,13 @@ namespace SimpleGui {
         Vec2 center;
         float radius;
     };
+
+    // 九宫格四边不拉伸部分的宽度（纹理像素）
+    struct NineSliceInsets final {
+        float left = 0;
+        float top = 0;
+        float right = 0;
+        float bottom = 0;
+    };
 }
 
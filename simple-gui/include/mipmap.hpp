@@ -0,0 +1,9 @@
+#pragma once
+#include <SDL3/SDL_surface.h>
+
+
+namespace SimpleGui {
+	// 用2x2盒式滤波把每像素4字节的表面缩小为一半（向下取整，不小于1），奇数尺寸时舍弃最后一行/列
+	// 目标行分块后在JobSystem的工作线程上并行，支持SSE2时每次处理两个目标像素。失败时返回nullptr
+	SDL_Surface* DownscaleSurfaceHalf(SDL_Surface* src);
+}
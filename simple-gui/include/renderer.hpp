@@ -2,11 +2,16 @@
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_rect.h>
 #include <SDL3_ttf/SDL_ttf.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <variant>
-#include <queue>
+#include <vector>
 #include "math.hpp"
 #include "texture.hpp"
 #include "font.hpp"
+#include "deleter.hpp"
+#include "shape_tessellator.hpp"
 
 
 namespace SimpleGui {
@@ -44,6 +49,23 @@ namespace SimpleGui {
         SDL_FPoint center;
         float radius;
         bool fill;
+        bool antialias;
+    };
+
+    struct RenderArcCommandData final {
+        SDL_FPoint center;
+        float radius;
+        float startAngle;
+        float endAngle;
+        bool fill;
+        bool antialias;
+    };
+
+    struct RenderRoundRectCommandData final {
+        SDL_FRect rect;
+        float radius;
+        bool fill;
+        bool antialias;
     };
 
     struct RenderTextureCommandData final {
@@ -65,6 +87,49 @@ namespace SimpleGui {
         bool disable;
     };
 
+    struct RenderTargetCommandData final {
+        SDL_Texture* target;            // nullptr表示窗口
+    };
+
+    struct RenderCopyTextureCommandData final {
+        SDL_Texture* texture;
+        SDL_FRect srcRect;
+        SDL_FRect dstRect;
+        SDL_BlendMode blendMode;
+    };
+
+    // 不进行混合，直接用颜色覆盖区域内的像素
+    struct RenderClearRectCommandData final {
+        SDL_FRect rect;
+    };
+
+    // 渲染层，后面的层绘制在上面。同一层内按记录顺序绘制，帧末只在不改变结果时为合批重排
+    enum class RenderLayer : uint8 {
+        Main,               // 组件树
+        Popup,              // 下拉列表、菜单等弹出框
+        DragPreview,        // 拖拽预览
+        Tooltip,            // 提示框
+        Overlay             // 调试信息等覆盖在所有内容之上的绘制
+    };
+
+    // 九宫格的4x4顶点网格，记录时已经裁剪到可见范围内
+    struct RenderNineSliceCommandData final {
+        SDL_Texture* texture;
+        float xs[4];
+        float ys[4];
+        float us[4];
+        float vs[4];
+    };
+
+    // 以origin为原点、每块tileSize大小平铺纹理，只覆盖rect内的部分，rect在记录时已经裁剪到可见范围内
+    struct RenderTiledTextureCommandData final {
+        SDL_Texture* texture;
+        SDL_FRect rect;
+        SDL_FPoint origin;
+        SDL_FPoint tileSize;
+        SDL_FlipMode mode;
+    };
+
     struct RenderCommand final {
         std::variant<RenderLineCommandData,
             RenderLinesCommandData,
@@ -73,14 +138,34 @@ namespace SimpleGui {
             RenderTriangleCommandData,
             //RenderGeometryCommandData,
             RenderCircleCommandData,
+            RenderArcCommandData,
+            RenderRoundRectCommandData,
+            RenderNineSliceCommandData,
+            RenderTiledTextureCommandData,
             RenderTextureCommandData,
             RenderTextCommandData,
-            RenderClipCommandData> data;
+            RenderClipCommandData,
+            RenderTargetCommandData,
+            RenderCopyTextureCommandData,
+            RenderClearRectCommandData> data;
         SDL_Color color{};
+        uint32 sortKey = 0;             // 所在层 << 8 | 层内次序
+    };
+
+    // 一帧记录阶段的统计
+    struct RenderStats final {
+        size_t recordedCommands = 0;
+        size_t mutedCommands = 0;           // 静音时丢弃的命令
+        size_t occludedComponents = 0;      // 被上层不透明组件完全遮挡的组件
+        size_t occludedCommands = 0;        // 被遮挡的组件丢弃的命令，包含在mutedCommands中
+        size_t culledCommands = 0;          // 完全位于裁剪矩形之外而丢弃的命令
+        size_t trimmedCommands = 0;         // 填充矩形被裁剪到裁剪矩形内的命令
+        size_t reorderedCommands = 0;       // 为合批而提前到相同状态的命令之后的命令
     };
 
 
     class Renderer final {
+        friend class Texture;
     public:
         explicit Renderer(SDL_Window* window);
         ~Renderer();
@@ -91,6 +176,17 @@ namespace SimpleGui {
         Renderer& operator=(Renderer&&) = delete;
 
         void SetClearColor(const Color& color);
+
+        // 流水线渲染：UI线程记录第N帧的命令时，渲染线程提交并呈现第N-1帧，UI线程不再等待SDL_RenderPresent
+        // 命令队列双缓冲，只在渲染线程空闲时交换，交换后由渲染线程独占；UI线程在渲染线程执行完命令后才继续，
+        // 因此TTF_Text等被命令引用的资源在下一帧中可以照常修改，只有纹理的创建和销毁需要与呈现互斥
+        bool IsPipelined() const { return m_pipelined; }
+        void SetPipelined(bool pipelined);
+
+        // 直接访问SDL_Renderer之前加锁，流水线模式下渲染线程提交和呈现期间持有该锁
+        std::unique_lock<std::mutex> LockDevice() const { return std::unique_lock(m_deviceMutex); }
+        // 在纹理所属渲染器的锁内销毁纹理
+        static void DestroyTexture(SDL_Texture* texture);
         //void Clear();
         //void Present();
 
@@ -103,26 +199,73 @@ namespace SimpleGui {
         void SetRenderClipRect(const Rect& rect);
         void ClearRenderClipRect();
 
+        // 之后记录的命令绘制到target中，target需要以SDL_TEXTUREACCESS_TARGET创建，可以嵌套
+        void PushRenderTarget(SDL_Texture* target);
+        void PopRenderTarget();
+
+        // 之后设置的裁剪矩形都会与rect取交集，用于只重绘局部区域，只作用于主层的命令
+        void PushClipConstraint(const Rect& rect);
+        void PopClipConstraint();
+
+        // 之后记录的命令属于layer，同一层中order较大的绘制在上面（如多级菜单），可以嵌套
+        void PushRenderLayer(RenderLayer layer, uint8 order = 0);
+        void PopRenderLayer();
+        RenderLayer GetRenderLayer() const { return static_cast<RenderLayer>(m_sortKey >> 8); }
+
+        // 静音时丢弃主层的命令，组件在其他层的内容（弹出框等）仍然会被记录
+        bool IsMainLayerMuted() const { return m_mainLayerMuted; }
+        void SetMainLayerMuted(bool muted) { m_mainLayerMuted = muted; }
+
+        // 已记录的命令数，作为HashMainLayerCommands和DiscardMainLayerCommands的起点
+        size_t GetRecordedCommandCount() const { return m_renderQueue.size(); }
+        // 从begin开始记录的主层命令的指纹，用于判断一段内容与上一帧相比是否变化
+        Uint64 HashMainLayerCommands(size_t begin) const;
+        // 丢弃从begin开始记录的主层命令，其他层的命令保留
+        void DiscardMainLayerCommands(size_t begin);
+
+        // 上一帧的统计，在Render()时结算
+        const RenderStats& GetStats() const { return m_stats; }
+        // 正在记录的这一帧的统计
+        const RenderStats& GetFrameStats() const { return m_frameStats; }
+        // 组件被遮挡，记录期间静音丢弃了mutedCommands条命令
+        void RecordOccludedComponent(size_t mutedCommands) {
+            ++m_frameStats.occludedComponents;
+            m_frameStats.occludedCommands += mutedCommands;
+        }
+
         void RenderLine(const Vec2& p1, const Vec2& p2, const Color& color);
         void RenderLines(const std::vector<SDL_FPoint> points, const Color& color);
         void RenderRect(const Rect& rect, const Color& color, bool fill);
         void RenderRects(const std::vector<SDL_FRect> rects, const Color& color, bool fill);
         void RenderTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Color& color, bool fill);
-        void RenderCircle(const Vec2& center, float radius, const Color& color, bool fill);
+        // 圆、圆弧和圆角矩形细分为三角形后一次绘制，antialias时边缘有1像素的羽化
+        void RenderCircle(const Vec2& center, float radius, const Color& color, bool fill, bool antialias = false);
+        // 角度单位为度，从x轴正方向顺时针增加，填充时为扇形
+        void RenderArc(const Vec2& center, float radius, float startAngle, float endAngle, const Color& color, bool fill, bool antialias = false);
+        void RenderRoundRect(const Rect& rect, float radius, const Color& color, bool fill, bool antialias = false);
         void RenderTexture(Texture* texture, const Rect& srcRect, const Rect& dstRect, float angle, const Vec2& center, SDL_FlipMode mode);
         void RenderText(TTF_Text* text, const Vec2& pos, const Color& color);
+        void RenderTexture(SDL_Texture* texture, const Rect& srcRect, const Rect& dstRect, SDL_BlendMode blendMode);
+        void RenderClearRect(const Rect& rect, const Color& color);
+        // 九宫格：四个角保持原尺寸，四条边和中心拉伸，16个顶点一次绘制；相邻的使用同一纹理的九宫格合并为一次绘制
+        // 只绘制位于visibleRect内的部分，几何在CPU上裁剪，不需要设置裁剪矩形
+        void RenderNineSlice(Texture* texture, const NineSliceInsets& insets, const Rect& dstRect, const Color& color = Color::WHITE);
+        void RenderNineSlice(SDL_Texture* texture, const Rect& srcRect, const NineSliceInsets& insets, const Rect& dstRect,
+            const Rect& visibleRect, const Color& color = Color::WHITE);
+        // 在dstRect内以原尺寸平铺纹理，每块按mode翻转；所有块一次绘制，边缘不完整的块在CPU上裁剪
+        void RenderTiledTexture(Texture* texture, const Rect& dstRect, const Rect& visibleRect, SDL_FlipMode mode = SDL_FLIP_NONE,
+            const Color& color = Color::WHITE);
 
         void DrawLine(const Vec2& p1, const Vec2& p2, const Color& color) const;
         void DrawRect(const Rect& rect, const Color& color) const;
         void DrawTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Color& color) const;
-        void DrawCircle(const Vec2& center, float radius, const Color& color) const;                 //ʹ���е�Բ�㷨
+        void DrawCircle(const Vec2& center, float radius, const Color& color) const;
         void FillRect(const Rect& rect, const Color& color) const;
         void FillRect(const Rect& rect, const GradientColor& color) const;
         void FillTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Color& color) const;
-        void FillCircle(const Vec2& center, float radius, const Color& color) const;                //ɨ�����㷨
-
-        //void DrawRoundRect();
-        //void FillRoundRect();
+        void FillCircle(const Vec2& center, float radius, const Color& color) const;
+        void DrawRoundRect(const Rect& rect, float radius, const Color& color) const;
+        void FillRoundRect(const Rect& rect, float radius, const Color& color) const;
 
         void DrawTexture(SDL_Texture* texture, const Rect& srcRect, const Rect& dstRect, float angle, const Vec2 center, SDL_FlipMode mode) const;
         void DrawTexture(const Texture& texture, const Rect& srcRect, const Rect& dstRect, float angle, const Vec2 center, SDL_FlipMode mode) const;
@@ -137,29 +280,81 @@ namespace SimpleGui {
         Vec2 GetRenderOutputSize() const;
 
         std::shared_ptr<SDL_Texture> CreateSharedSDLTexture(std::string_view path) const;
-        std::shared_ptr<Texture> CreateSharedTexture(std::string_view path) const;
+        // mipmaps为true时加载时生成缩小级别，RenderTexture按目标尺寸选择级别，适合缩小显示的大图
+        std::shared_ptr<Texture> CreateSharedTexture(std::string_view path, bool mipmaps = false) const;
         SDL_Texture* CreateSDLTexture(std::string_view path) const;
-        Texture* CreateTexture(std::string_view path) const;
+        Texture* CreateTexture(std::string_view path, bool mipmaps = false) const;
+        UniqueTexturePtr CreateTargetTexture(int w, int h) const;
 
         SDL_Renderer& GetSDLRenderer() const { return *m_renderer; }
         TTF_TextEngine& GetTTFTextEngine() const { return *m_textEngine; }
 
-        bool IsTopRender() const { return m_topRender; }
-        void SetTopRender(bool top) { m_topRender = top; }
-
         void Render();
 
     private:
         SDL_Renderer* m_renderer;
         TTF_TextEngine* m_textEngine;
         Color m_clearColor;
-        bool m_topRender;
-
-        std::queue<RenderCommand> m_renderQueue;
-        std::queue<RenderCommand> m_topRenderQueue;
+        uint32 m_sortKey = 0;
+        std::vector<uint32> m_sortKeyStack;
+        bool m_mainLayerMuted;
+        RenderStats m_stats;
+        RenderStats m_frameStats;
+
+        // 记录时跟踪每个层（及层内次序）执行到当前位置时的裁剪矩形，未知（未设置、已禁用或切换了渲染目标）时不剔除
+        struct RecordClipState final {
+            Rect rect;
+            bool valid = false;
+        };
+        std::vector<std::pair<uint32, RecordClipState>> m_clipStates;
+
+        std::vector<SDL_Texture*> m_renderTargets;
+        std::vector<Rect> m_clipConstraints;
+        // 执行后只清空不释放，稳定的帧内不再分配内存
+        std::vector<RenderCommand> m_renderQueue;
+        std::vector<uint32> m_renderOrder;         // 排序后的执行顺序（命令下标）
+        std::vector<uint32> m_sortScratch;
+        std::vector<Rect> m_commandBounds;
+        std::vector<bool> m_commandBoundsKnown;
+        std::vector<Rect> m_batchScratch;
+        ShapeTessellator m_tessellator;                     // 执行命令的线程使用
+        mutable ShapeTessellator m_immediateTessellator;    // Draw/Fill系列函数使用
+
+        mutable std::mutex m_deviceMutex;
+        bool m_pipelined = false;
+
+        // 有缩小级别的纹理，每帧结束时释放其中闲置的级别
+        mutable std::vector<const Texture*> m_mipmapTextures;
+        Uint64 m_lastLevelReleaseTime = 0;
+        std::thread m_renderThread;
+        std::mutex m_frameMutex;
+        std::condition_variable m_frameCondition;
+        bool m_frameReady = false;              // 交换后的命令等待渲染线程执行
+        bool m_frameExecuted = true;            // 渲染线程已执行完交换后的命令
+        bool m_renderIdle = true;               // 渲染线程已呈现完上一帧
+        bool m_stopRenderThread = false;
+        Color m_submitClearColor;
+        // 渲染线程独占的命令队列
+        std::vector<RenderCommand> m_submitQueue;
+        std::vector<uint32> m_submitOrder;
        
         void SetRenderColor(const Color& color) const;
+        void DrawTessellatedGeometry() const;
         void AddRenderCommand(RenderCommand&& cmd);
-        void ExecuteRenderQueue(std::queue<RenderCommand>& queue);
+        // 根据记录时的裁剪矩形剔除或裁剪命令，返回false表示丢弃
+        bool ClipRenderCommand(RenderCommand& cmd, RecordClipState& clip);
+        RecordClipState& GetRecordClipState();
+        // 帧末按层稳定排序（基数排序），再在层内为合批重排互不重叠的命令
+        void SortRenderQueue();
+        void BatchRenderQueue(size_t begin, size_t end);
+        void ExecuteRenderQueue(std::vector<RenderCommand>& queue, std::vector<uint32>& order);
+        // 从order[begin]开始把连续的使用同一纹理的九宫格和平铺纹理合并为一次绘制，返回之后第一个命令的位置
+        size_t ExecuteTexturedGeometryBatch(std::vector<RenderCommand>& queue, std::vector<uint32>& order, size_t begin);
+        void SubmitFrame();
+        void RegisterMipmapTexture(const Texture* texture) const;
+        void UnregisterMipmapTexture(const Texture* texture) const;
+        // 上一帧的命令都已执行完，释放的纹理不会再被渲染线程访问
+        void ReleaseIdleTextureLevels();
+        void RenderThreadLoop();
     };
 }
\ No newline at end of file
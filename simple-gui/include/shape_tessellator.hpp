@@ -0,0 +1,69 @@
+#pragma once
+#include <SDL3/SDL_render.h>
+#include <unordered_map>
+#include <vector>
+#include "math.hpp"
+
+
+namespace SimpleGui {
+	// 把圆、圆弧、圆角矩形细分为三角扇/三角带，结果追加到顶点和索引缓冲中，每个形状用一次SDL_RenderGeometry绘制
+	// 分段数随半径自适应，单位圆的顶点按分段数缓存；antialias为true时在边缘外加一圈1像素宽、透明度渐变为0的羽化环
+	// 不是线程安全的，每个绘制线程使用自己的实例
+	class ShapeTessellator final {
+	public:
+		ShapeTessellator() = default;
+		~ShapeTessellator() = default;
+
+		// 整圆的分段数，使弦与圆弧的最大距离不超过MAX_CHORD_ERROR像素，总是4的倍数
+		static int GetSegmentCount(float radius);
+
+		void FillCircle(const Vec2& center, float radius, const SDL_FColor& color, bool antialias);
+		void StrokeCircle(const Vec2& center, float radius, float thickness, const SDL_FColor& color, bool antialias);
+		// 角度单位为度，从x轴正方向顺时针（屏幕坐标）增加；填充时为扇形
+		void FillArc(const Vec2& center, float radius, float startAngle, float endAngle, const SDL_FColor& color, bool antialias);
+		void StrokeArc(const Vec2& center, float radius, float startAngle, float endAngle, float thickness, const SDL_FColor& color, bool antialias);
+		// radius会被限制在矩形短边的一半以内，为0时就是普通矩形
+		void FillRoundRect(const Rect& rect, float radius, const SDL_FColor& color, bool antialias);
+		void StrokeRoundRect(const Rect& rect, float radius, float thickness, const SDL_FColor& color, bool antialias);
+		// 4x4顶点网格组成的九个四边形，16个顶点、54个索引
+		void AddNineSlice(const float (&xs)[4], const float (&ys)[4], const float (&us)[4], const float (&vs)[4], const SDL_FColor& color);
+		// 以origin为原点平铺tileSize大小的块，只生成rect内的部分，边缘的块按比例裁剪纹理坐标
+		void AddTiles(const SDL_FRect& rect, const SDL_FPoint& origin, const SDL_FPoint& tileSize, SDL_FlipMode mode, const SDL_FColor& color);
+
+		void Clear();
+		const std::vector<SDL_Vertex>& GetVertices() const { return m_vertices; }
+		const std::vector<int>& GetIndices() const { return m_indices; }
+
+	private:
+		static constexpr float MAX_CHORD_ERROR = 0.25f;
+		static constexpr int MIN_SEGMENTS = 8;
+		static constexpr int MAX_SEGMENTS = 256;
+
+		// 轮廓上的点。沿normal偏移d时两侧的边都向外移动d，尖角处是斜接向量而不是单位向量；normal为0的点不羽化
+		struct ContourPoint final {
+			SDL_FPoint pos;
+			SDL_FPoint normal;
+		};
+
+		std::unordered_map<int, std::vector<SDL_FPoint>> m_unitCircles;
+		std::vector<ContourPoint> m_contour;
+		std::vector<SDL_Vertex> m_vertices;
+		std::vector<int> m_indices;
+
+		// 单位圆上segments + 1个点（首尾相同），从x轴正方向开始
+		const std::vector<SDL_FPoint>& GetUnitCircle(int segments);
+
+		void BuildArcContour(const Vec2& center, float radius, float startAngle, float endAngle);
+		void BuildRoundRectContour(const Rect& rect, float radius);
+
+		// 凸轮廓，以fanCenter为扇心填充
+		void FillContour(const SDL_FPoint& fanCenter, const SDL_FColor& color, bool antialias);
+		void StrokeContour(float thickness, bool closed, const SDL_FColor& color, bool antialias);
+
+		int AddVertex(const SDL_FPoint& pos, const SDL_FColor& color);
+		// 轮廓上的点沿法线偏移offset后作为顶点，返回第一个顶点的下标
+		int AddContourRing(float offset, const SDL_FColor& color);
+		// 连接两圈顶点，closed时首尾相连
+		void AddQuadStrip(int ring1, int ring2, bool closed, bool skipUnfeathered);
+	};
+}
@@ -6,4 +6,6 @@
 #include "deleter.hpp"
 #include "logger.hpp"
 #include "extended_functions.hpp"
+#include "slab_allocator.hpp"
+#include "alloc_tracker.hpp"
 #include "component/component.hpp"
@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+// 在类中使用该宏，使该类（及其派生类）的对象从SlabAllocator分配
+// 通过基类指针delete时，虚析构函数会传入实际类型的大小，因此派生类无需重复声明
+#define SG_SLAB_ALLOCATED \
+	static void* operator new(size_t size) { return SimpleGui::SlabAllocator::GetInstance().Allocate(size); } \
+	static void operator delete(void* ptr, size_t size) noexcept { SimpleGui::SlabAllocator::GetInstance().Deallocate(ptr, size); }
+
+
+namespace SimpleGui {
+	// 小对象的分级内存池。按16字节对齐分级，同一级（同一大小的组件类）共用一个空闲链表
+	// 内存按块（slab）批量申请，释放的对象进入空闲链表供下次复用，块本身不归还
+	// 超过MAX_SIZE的对象直接使用全局的operator new。非线程安全，只在主线程中创建和销毁组件
+	class SlabAllocator final {
+	public:
+		static constexpr size_t ALIGNMENT = 16;
+		static constexpr size_t MAX_SIZE = 2048;
+		static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+		~SlabAllocator();
+
+		SlabAllocator(const SlabAllocator&) = delete;
+		SlabAllocator& operator=(const SlabAllocator&) = delete;
+		SlabAllocator(SlabAllocator&&) = delete;
+		SlabAllocator& operator=(SlabAllocator&&) = delete;
+
+		static SlabAllocator& GetInstance();
+
+		void* Allocate(size_t size);
+		void Deallocate(void* ptr, size_t size) noexcept;
+
+		size_t GetSlabCount() const { return m_slabs.size(); }
+		// 当前被对象占用的字节数（按分级后的大小计算）
+		size_t GetUsedBytes() const { return m_usedBytes; }
+
+	private:
+		struct FreeNode final {
+			FreeNode* next;
+		};
+
+		static constexpr size_t CLASS_COUNT = MAX_SIZE / ALIGNMENT;
+
+		std::array<FreeNode*, CLASS_COUNT> m_freeLists{};
+		std::vector<std::byte*> m_slabs;
+		std::byte* m_cursor = nullptr;
+		std::byte* m_end = nullptr;
+		size_t m_usedBytes = 0;
+
+		SlabAllocator() = default;
+
+		static size_t GetClassIndex(size_t size) { return (size + ALIGNMENT - 1) / ALIGNMENT - 1; }
+		void NewSlab();
+	};
+}
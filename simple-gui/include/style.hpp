@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <optional>
 #include "math.hpp"
+#include "texture.hpp"
 #include "component/common/types.hpp"
 
 
@@ -60,6 +61,13 @@ namespace SimpleGui {
 		LineEditSelectedBackground,
 		LineEditSelectedForeground,
 
+		TextEditBackground,
+		TextEditForeground,
+		TextEditBorder,
+		TextEditActivatedBorder,
+		TextEditCaret,
+		TextEditSelectedBackground,
+
 		ProgressBarSlot,
 		ProgressBarProgress,
 		ProgressBarForeground,
@@ -83,6 +91,17 @@ namespace SimpleGui {
 		ComboBoxItemSelected,
 		ComboBoxItemHovered,
 
+		ListViewBackground,
+		ListViewBorder,
+
+		TableViewBackground,
+		TableViewForeground,
+		TableViewAlternateRow,
+		TableViewGrid,
+		TableViewHeaderBackground,
+		TableViewHeaderForeground,
+		TableViewBorder,
+
 		FlagsTotal
 	};
 
@@ -108,12 +127,23 @@ namespace SimpleGui {
 	};
 
 
+	// 九宫格皮肤，四个角保持原尺寸，四条边和中心拉伸
+	struct NineSliceSkin final {
+		std::shared_ptr<Texture> texture;
+		Rect srcRect;						// 使用的纹理区域，为空时使用整张纹理
+		NineSliceInsets insets;
+		Color color = Color::WHITE;			// 与纹理颜色相乘
+	};
+
+
 	struct Style final {
 		ComponentPadding componentPadding{ 5,5,5,5 };
 		int itemSpacing = 5;
 		// ......
 
 		ThemeColors  colors;
+		// 设置了皮肤的主题颜色槽位改用皮肤绘制（目前支持按钮和可拖拽面板的背景）
+		std::unordered_map<ThemeColorFlags, NineSliceSkin> skins;
 	};
 
 
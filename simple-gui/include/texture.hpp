@@ -1,34 +1,80 @@
 #pragma once
 #include <SDL3/SDL_render.h>
+#include <future>
 #include <string>
 #include <string_view>
+#include <vector>
 #include "math.hpp"
 
 
 namespace SimpleGui {
 	class Renderer;
 
+	// 可以在加载时生成缩小级别（mipmap）：级别i的尺寸是原图的1/2^i，最后一级为1x1
+	// 各级纹理在第一次使用时才上传，上传后释放该级别及更大级别的像素，只在内存中保留更小级别的像素
+	// 每帧结束时释放超过LEVEL_RELEASE_DELAY没有使用的级别，缩略图只占用接近显示尺寸的内存和显存
+	// 需要的级别已经没有像素时在后台线程中重新从文件生成，生成完成前使用最接近的已上传级别
 	class Texture final {
 		friend class Renderer;
 	public:
 		~Texture();
 
-		SDL_Texture& GetSDLTexture() const { return *m_texture; }
-		
-		int GetWidth() const { return m_texture->w; }
-		int GetHeight() const { return m_texture->h; }
+		// 原图的纹理
+		SDL_Texture& GetSDLTexture() const { return GetLevelTexture(0); }
+		// 宽高都不小于size的最小级别的纹理，没有生成缩小级别时就是原图。只能在主线程中调用，不会读取文件
+		SDL_Texture& GetSDLTexture(const Vec2& size) const;
+
+		// 原图的尺寸，与使用的级别无关
+		int GetWidth() const { return m_width; }
+		int GetHeight() const { return m_height; }
 		Rect GetRect() const {
-			return Rect{0.f, 0.f, static_cast<float>(m_texture->w), static_cast<float>(m_texture->h) };
+			return Rect{0.f, 0.f, static_cast<float>(m_width), static_cast<float>(m_height) };
 		}
 
 		std::string GetPath() const { return m_path; }
 
-		bool IsNull() const { return m_texture == nullptr; }
+		bool IsNull() const { return m_levels.empty(); }
+		bool HasMipmaps() const { return m_levels.size() > 1; }
+
+		// 应用到所有级别，包括之后上传的级别
+		void SetScaleMode(SDL_ScaleMode mode);
 
 	private:
-		SDL_Texture* m_texture;
+		static constexpr Uint64 LEVEL_RELEASE_DELAY = 1000;		// 毫秒
+
+		struct Level final {
+			int w = 0;
+			int h = 0;
+			SDL_Texture* texture = nullptr;
+			Uint64 lastUsedTime = 0;
+			bool uploadFailed = false;		// 上传失败后不再重试
+		};
+
+		const Renderer& m_renderer;
 		std::string m_path;
+		int m_width = 0;
+		int m_height = 0;
+		SDL_ScaleMode m_scaleMode = SDL_SCALEMODE_LINEAR;
+		// 纹理按需上传、闲置时释放。最后一级加载时就上传并且一直保留，需要的级别不可用时使用最接近的已上传级别
+		mutable std::vector<Level> m_levels;
+		// 各级像素，与m_levels一一对应，已释放的级别为nullptr
+		mutable std::vector<SDL_Surface*> m_surfaces;
+		mutable std::future<std::vector<SDL_Surface*>> m_rebuildFuture;
+		mutable bool m_rebuildFailed = false;
+		mutable size_t m_registryIndex = 0;	// 在渲染器的缩小级别纹理列表中的下标
+
+		Texture(const Renderer& renderer, std::string_view path, bool mipmaps = false);
 
-		Texture(const Renderer& renderer, std::string_view path);
+		SDL_Texture& GetLevelTexture(size_t level) const;
+		SDL_Texture& GetNearestUploadedLevel(size_t level) const;
+		// 从文件加载原图并生成所有级别的像素，小于keepLevel的级别生成后即释放（为nullptr），失败时返回空
+		static std::vector<SDL_Surface*> BuildSurfaces(const std::string& path, size_t keepLevel);
+		void RequestRebuild(size_t level) const;
+		void PollRebuildResult() const;
+		bool UploadLevel(size_t level) const;
+		// 释放[0, lastLevel]级别的像素
+		void ReleaseSurfaces(size_t lastLevel) const;
+		// 由渲染器在每帧结束时调用
+		void ReleaseIdleLevels(Uint64 now) const;
 	};
-}
\ No newline at end of file
+}
@@ -2,12 +2,15 @@
 #include <SDL3/SDL_timer.h>
 #include <memory>
 #include "signal.hpp"
+#include "slab_allocator.hpp"
 
 
 namespace SimpleGui {
 	class Timer final {
 		friend class TimerManager;
 	public:
+		SG_SLAB_ALLOCATED
+
 		Signal<> timeout;
 
 		Timer() = default;
@@ -95,6 +95,7 @@ namespace SimpleGui {
 		SDL_Renderer& GetSDLRenderer() const { return m_renderer->GetSDLRenderer(); }
 		TTF_TextEngine& GetTTFTextEngine() const { return m_renderer->GetTTFTextEngine(); }
 		Renderer& GetRenderer() const { return *m_renderer; }
+		GeometryStore& GetGeometryStore() const { return *m_geometryStore; }
 
 	private:
 		friend class GuiManager;
@@ -104,6 +105,7 @@ namespace SimpleGui {
 		std::unique_ptr<Renderer> m_renderer;
 		std::unique_ptr<StyleManager> m_styleManager;
 		std::unique_ptr<Font> m_font;
+		std::unique_ptr<GeometryStore> m_geometryStore;
 		std::unique_ptr<RootComponent> m_rootCmp;
 
 	private:
@@ -0,0 +1,180 @@
+#include "alloc_tracker.hpp"
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SG_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define SG_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+
+namespace SimpleGui {
+	namespace {
+		struct CallSiteSlot final {
+			std::atomic<void*> address{};
+			std::atomic<size_t> count{};
+			std::atomic<size_t> bytes{};
+		};
+
+		// 记录过程中不能再进行堆分配，调用点使用固定大小的开放寻址表
+		std::atomic<bool> s_recording{};
+		std::atomic<size_t> s_count{};
+		std::atomic<size_t> s_bytes{};
+		CallSiteSlot s_callSites[AllocTracker::MAX_CALL_SITES];
+
+		[[maybe_unused]] void Record(size_t size, void* caller) {
+			if (!s_recording.load(std::memory_order_relaxed)) return;
+			s_count.fetch_add(1, std::memory_order_relaxed);
+			s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+			size_t hash = (reinterpret_cast<uintptr_t>(caller) >> 4) % AllocTracker::MAX_CALL_SITES;
+			for (size_t i = 0; i < AllocTracker::MAX_CALL_SITES; ++i) {
+				auto& slot = s_callSites[(hash + i) % AllocTracker::MAX_CALL_SITES];
+				void* expected = nullptr;
+				if (slot.address.compare_exchange_strong(expected, caller) || expected == caller) {
+					slot.count.fetch_add(1, std::memory_order_relaxed);
+					slot.bytes.fetch_add(size, std::memory_order_relaxed);
+					return;
+				}
+			}
+		}
+
+#ifdef SG_ALLOC_TRACKING
+		SDL_malloc_func s_sdlMalloc;
+		SDL_calloc_func s_sdlCalloc;
+		SDL_realloc_func s_sdlRealloc;
+		SDL_free_func s_sdlFree;
+
+		void* SDLCALL TrackedMalloc(size_t size) {
+			Record(size, SG_RETURN_ADDRESS());
+			return s_sdlMalloc(size);
+		}
+
+		void* SDLCALL TrackedCalloc(size_t count, size_t size) {
+			Record(count * size, SG_RETURN_ADDRESS());
+			return s_sdlCalloc(count, size);
+		}
+
+		void* SDLCALL TrackedRealloc(void* ptr, size_t size) {
+			if (size) Record(size, SG_RETURN_ADDRESS());
+			return s_sdlRealloc(ptr, size);
+		}
+
+		void SDLCALL TrackedFree(void* ptr) {
+			s_sdlFree(ptr);
+		}
+
+		void* AlignedAlloc(size_t size, std::align_val_t align) {
+			auto alignment = static_cast<size_t>(align);
+			size = (size + alignment - 1) / alignment * alignment;
+#ifdef _MSC_VER
+			return _aligned_malloc(size ? size : alignment, alignment);
+#else
+			return std::aligned_alloc(alignment, size ? size : alignment);
+#endif
+		}
+
+		void AlignedFree(void* ptr) {
+#ifdef _MSC_VER
+			_aligned_free(ptr);
+#else
+			std::free(ptr);
+#endif
+		}
+#endif // SG_ALLOC_TRACKING
+	}
+
+	bool AllocTracker::IsAvailable() {
+#ifdef SG_ALLOC_TRACKING
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void AllocTracker::InstallSDLHooks() {
+#ifdef SG_ALLOC_TRACKING
+		SDL_GetOriginalMemoryFunctions(&s_sdlMalloc, &s_sdlCalloc, &s_sdlRealloc, &s_sdlFree);
+		SDL_SetMemoryFunctions(TrackedMalloc, TrackedCalloc, TrackedRealloc, TrackedFree);
+#endif
+	}
+
+	void AllocTracker::Begin() {
+		s_recording.store(false);
+		s_count.store(0);
+		s_bytes.store(0);
+		for (auto& slot : s_callSites) {
+			slot.address.store(nullptr);
+			slot.count.store(0);
+			slot.bytes.store(0);
+		}
+		s_recording.store(true);
+	}
+
+	void AllocTracker::End() {
+		s_recording.store(false);
+	}
+
+	bool AllocTracker::IsRecording() {
+		return s_recording.load();
+	}
+
+	size_t AllocTracker::GetCount() {
+		return s_count.load();
+	}
+
+	size_t AllocTracker::GetBytes() {
+		return s_bytes.load();
+	}
+
+	std::vector<AllocTracker::CallSite> AllocTracker::GetCallSites() {
+		std::vector<CallSite> sites;
+		for (const auto& slot : s_callSites) {
+			if (void* address = slot.address.load()) sites.push_back({ address, slot.count.load(), slot.bytes.load() });
+		}
+		std::ranges::sort(sites, [](const CallSite& a, const CallSite& b) { return a.count > b.count; });
+		return sites;
+	}
+}
+
+
+#ifdef SG_ALLOC_TRACKING
+void* operator new(size_t size) {
+	SimpleGui::Record(size, SG_RETURN_ADDRESS());
+	if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+	SimpleGui::Record(size, SG_RETURN_ADDRESS());
+	if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+	SimpleGui::Record(size, SG_RETURN_ADDRESS());
+	if (void* ptr = SimpleGui::AlignedAlloc(size, align)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t align) {
+	SimpleGui::Record(size, SG_RETURN_ADDRESS());
+	if (void* ptr = SimpleGui::AlignedAlloc(size, align)) return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { SimpleGui::AlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { SimpleGui::AlignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { SimpleGui::AlignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { SimpleGui::AlignedFree(ptr); }
+#endif // SG_ALLOC_TRACKING
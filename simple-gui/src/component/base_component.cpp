@@ -1,37 +1,79 @@
 #include "component/base_component.hpp"
 #include <algorithm>
 #include <memory>
+#include <typeinfo>
 #include "deleter.hpp"
 #include "gui_manager.hpp"
 #include "logger.hpp"
 
 
 namespace SimpleGui {
+    // 边界由浮点数计算得到，判断子组件是否位于边界上时允许一定误差
+    static constexpr float CHILDREN_BOUNDS_EPSILON = 0.01f;
+
     BaseComponent::BaseComponent() {
         m_padding = {0};
-        m_extFunctionsManager = std::make_unique<ExtendedFunctionsManager>(this);
-        m_toolTip = std::make_unique<ToolTip>(this);
+    }
+
+    BaseComponent::~BaseComponent() {
+        if (m_geometryStore) m_geometryStore->Release(m_geometryIndex);
     }
 
     void BaseComponent::PreparationOfUpdateChildren() {
         // add caches of children to m_children, and clear caches
-        for (auto &child: m_childCaches) {
-            m_children.push_back(std::move(child));
+        if (!m_childCaches.empty()) {
+            m_children.reserve(m_children.size() + m_childCaches.size());
+            for (auto &child: m_childCaches) {
+                if (!child) continue;
+                child->m_inChildCaches = false;
+                child->m_indexInParent = m_children.size();
+                m_children.push_back(std::move(child));
+            }
+            m_childCaches.clear();
         }
-        m_childCaches.clear();
 
-        // remove NeedRemove children from m_children
-        for (auto it = m_children.begin(); it != m_children.end();) {
-            if (!(*it) || (*it)->m_needRemove) {
-                if ((*it) && (*it)->m_needRemove) (*it)->ExitedComponentTree();
-                it = m_children.erase(it);
-            } else {
-                ++it;
+        if (!m_childrenNeedCompact) return;
+        m_childrenNeedCompact = false;
+
+        // 移除空位和NeedRemove的子组件，一次保持顺序的线性压缩，同时更新剩余子组件的下标
+        bool removed = false;
+        size_t count = 0;
+        for (size_t i = 0; i < m_children.size(); ++i) {
+            auto &child = m_children[i];
+            if (child && child->m_needRemove) {
+                child->m_ownedByParent = false;
+                child->UnregisterGeometry();
+                OnChildRemoved(child->GetRect());
+                if (!DiscardBulkEnteredChild(child.get())) child->ExitedComponentTree();
+                child.reset();
+                --m_childrenCount;
+                removed = true;
             }
+            if (!child) continue;
+
+            child->m_indexInParent = count;
+            if (i != count) m_children[count] = std::move(child);
+            ++count;
         }
+        m_children.resize(count);
+        if (removed) OnChildrenChanged();
     }
 
     void BaseComponent::CalcVisibleGlobalRect(BaseComponent *parent, BaseComponent *target) const {
+        // 自身和父组件的几何数据在上次扫描之后都没有变化时，直接使用扫描的结果
+        // 否则重新计算，并标记为已变化，使其子组件也重新计算
+        if (GeometryStore *store = target->m_geometryStore; store && parent == target->m_parent) {
+            uint32_t idx = target->m_geometryIndex;
+            store->SetContentRect(idx, target->GetLocalCoordinateOriginOffset(), target->GetContentSize());
+            bool changed = store->HasFlag(idx, GeometryStore::Changed) ||
+                           (parent && store->HasFlag(parent->m_geometryIndex, GeometryStore::Changed));
+            if (!changed) {
+                target->m_visibleGRect = store->GetVisibleGlobalRect(idx);
+                return;
+            }
+            store->MarkChanged(idx);
+        }
+
         if (!parent) {
             target->m_visibleGRect = target->GetGlobalRect();
             return;
@@ -56,6 +98,8 @@ namespace SimpleGui {
     }
 
     void BaseComponent::UpdateChildSizeConfigs(BaseComponent *cmp) const {
+        Rect oldRect = cmp->GetRect();
+
         if (cmp->m_sizeConfigs.first == ComponentSizeConfig::Expanding) {
             cmp->m_position.x = 0;
             cmp->m_size.w = GetContentSize().w;
@@ -65,22 +109,133 @@ namespace SimpleGui {
             cmp->m_position.y = 0;
             cmp->m_size.h = GetContentSize().h;
         }
+
+        cmp->NotifyGeometryChanged(oldRect);
     }
 
     Rect BaseComponent::CalcChildrenBoundaryGlobalRect(BaseComponent *cmp) const {
-        // 在Update中准备工作之后调用，不需要考虑m_childCaches
-        if (cmp->GetChildrenCount() == 0) return {};
-        Rect rect = cmp->GetChildAt(0)->GetGlobalRect();
-        Vec2 bottomRight = rect.BottomRight();
-        for (auto &child: cmp->m_children) {
-            Rect globalRect = child->GetGlobalRect();
-            rect.position = rect.position.Min(globalRect.position);
-            bottomRight = bottomRight.Max(globalRect.BottomRight());
-        }
-        rect.size = bottomRight - rect.position;
+        Rect rect = cmp->GetChildrenBounds();
+        if (!cmp->m_hasChildrenBounds) return {};
+        rect.position += cmp->GetGlobalPosition() + cmp->GetLocalCoordinateOriginOffset();
         return rect;
     }
 
+    Rect BaseComponent::GetChildrenBounds() {
+        if (m_childrenBoundsDirty) RecalcChildrenBounds();
+        return m_hasChildrenBounds ? m_childrenBounds : Rect();
+    }
+
+    void BaseComponent::TranslateChildren(const Vec2 &delta) {
+        for (auto &child: m_children) {
+            if (!child) continue;
+            child->m_position += delta;
+            if (child->m_geometryStore) child->m_geometryStore->SetLocalRect(child->m_geometryIndex, child->GetRect());
+        }
+        for (auto &child: m_childCaches) {
+            if (!child) continue;
+            child->m_position += delta;
+            if (child->m_geometryStore) child->m_geometryStore->SetLocalRect(child->m_geometryIndex, child->GetRect());
+        }
+        m_childrenBounds.position += delta;
+    }
+
+    void BaseComponent::NotifyGeometryChanged(const Rect &oldRect) {
+        if (oldRect.position == m_position && oldRect.size == m_size) return;
+        if (!(oldRect.size == m_size)) m_layoutDirty = true;
+        if (m_geometryStore) SyncGeometry();
+        if (!m_parent || !m_ownedByParent) return;
+        m_parent->OnChildGeometryChanged(oldRect, GetRect());
+        InvalidateParentLayout();
+    }
+
+    void BaseComponent::RegisterGeometry(GeometryStore *store, uint32_t parentIndex) {
+        if (!store || m_geometryStore) return;
+        m_geometryStore = store;
+        m_geometryIndex = store->Allocate(this, parentIndex);
+        SyncGeometry();
+        for (auto &child: m_children) {
+            if (child) child->RegisterGeometry(store, m_geometryIndex);
+        }
+        for (auto &child: m_childCaches) {
+            if (child) child->RegisterGeometry(store, m_geometryIndex);
+        }
+    }
+
+    void BaseComponent::UnregisterGeometry() {
+        if (!m_geometryStore) return;
+        m_geometryStore->Release(m_geometryIndex);
+        m_geometryStore = nullptr;
+        m_geometryIndex = GeometryStore::INVALID_INDEX;
+        for (auto &child: m_children) {
+            if (child) child->UnregisterGeometry();
+        }
+        for (auto &child: m_childCaches) {
+            if (child) child->UnregisterGeometry();
+        }
+    }
+
+    void BaseComponent::SyncGeometry() const {
+        m_geometryStore->SetLocalRect(m_geometryIndex, GetRect());
+        m_geometryStore->SetContentRect(m_geometryIndex, GetLocalCoordinateOriginOffset(), GetContentSize());
+        m_geometryStore->SetFlag(m_geometryIndex, GeometryStore::Visible, m_visible);
+        m_geometryStore->SetFlag(m_geometryIndex, GeometryStore::Disabled, m_disabled);
+    }
+
+    void BaseComponent::InvalidateLayout() {
+        for (auto cmp = this; cmp; cmp = cmp->m_parent) {
+            // 布局正在排列子组件，变化由布局自身引起
+            if (cmp->m_layoutArranging) return;
+            cmp->m_layoutDirty = true;
+            if (!cmp->m_parent || !cmp->m_parent->m_isLayout) return;
+        }
+    }
+
+    void BaseComponent::OnChildAdded(const Rect &rect) {
+        if (m_childrenBoundsDirty) return;
+        if (!m_hasChildrenBounds) {
+            m_childrenBounds = rect;
+            m_hasChildrenBounds = true;
+            return;
+        }
+
+        Vec2 bottomRight = m_childrenBounds.BottomRight().Max(rect.BottomRight());
+        m_childrenBounds.position = m_childrenBounds.position.Min(rect.position);
+        m_childrenBounds.size = bottomRight - m_childrenBounds.position;
+    }
+
+    void BaseComponent::OnChildRemoved(const Rect &rect) {
+        if (m_childrenBoundsDirty || !m_hasChildrenBounds) return;
+
+        // 只有位于边界上的子组件被移除时边界才可能收缩
+        const Rect &bounds = m_childrenBounds;
+        if (rect.Left() <= bounds.Left() + CHILDREN_BOUNDS_EPSILON || rect.Top() <= bounds.Top() + CHILDREN_BOUNDS_EPSILON ||
+            rect.Right() >= bounds.Right() - CHILDREN_BOUNDS_EPSILON || rect.Bottom() >= bounds.Bottom() - CHILDREN_BOUNDS_EPSILON) {
+            m_childrenBoundsDirty = true;
+        }
+    }
+
+    void BaseComponent::OnChildGeometryChanged(const Rect &oldRect, const Rect &newRect) {
+        if (m_childrenBoundsDirty || !m_hasChildrenBounds) return;
+
+        // 原矩形位于边界上，而新矩形不再到达该边界时，边界可能收缩
+        const Rect &bounds = m_childrenBounds;
+        if ((oldRect.Left() <= bounds.Left() + CHILDREN_BOUNDS_EPSILON && newRect.Left() > oldRect.Left()) ||
+            (oldRect.Top() <= bounds.Top() + CHILDREN_BOUNDS_EPSILON && newRect.Top() > oldRect.Top()) ||
+            (oldRect.Right() >= bounds.Right() - CHILDREN_BOUNDS_EPSILON && newRect.Right() < oldRect.Right()) ||
+            (oldRect.Bottom() >= bounds.Bottom() - CHILDREN_BOUNDS_EPSILON && newRect.Bottom() < oldRect.Bottom())) {
+            m_childrenBoundsDirty = true;
+            return;
+        }
+
+        OnChildAdded(newRect);
+    }
+
+    void BaseComponent::RecalcChildrenBounds() {
+        m_childrenBoundsDirty = false;
+        m_hasChildrenBounds = false;
+        ForEachChild([this](BaseComponent *child) { OnChildAdded(child->GetRect()); });
+    }
+
     inline Vec2 BaseComponent::GetLocalCoordinateOriginOffset() const {
         return Vec2(m_padding.left, m_padding.top);
     }
@@ -96,10 +251,10 @@ namespace SimpleGui {
     bool BaseComponent::HandleEvent(Event *event) {
         SG_CMP_HANDLE_EVENT_CONDITIONS_FALSE;
 
-        m_toolTip->HandleEvent(event);
+        if (m_toolTip) m_toolTip->HandleEvent(event);
 
         // update extended functions
-        m_extFunctionsManager->HandleEvent(event);
+        if (m_extFunctionsManager) m_extFunctionsManager->HandleEvent(event);
 
         // handle events of m_children
         for (auto it = m_children.rbegin(); it != m_children.rend(); ++it) {
@@ -120,15 +275,61 @@ namespace SimpleGui {
         // calc visible size
         CalcVisibleGlobalRect(m_parent, this);
 
-        m_toolTip->Update();
+        if (m_toolTip) m_toolTip->Update();
 
         // update extended functions
-        m_extFunctionsManager->Update();
+        if (m_extFunctionsManager) m_extFunctionsManager->Update();
 
         // update child, and size configs of child
+        UpdateChildren(true);
+    }
+
+    void BaseComponent::UpdateChildren(bool applySizeConfigs) {
+        if (applySizeConfigs) {
+            for (auto &child: m_children) {
+                if (child) UpdateChildSizeConfigs(child.get());
+            }
+        }
+
+        Rect contentGRect = GetContentGlobalRect();
+        Rect cullGRect = contentGRect.GetIntersection(m_visibleGRect);
+        // 缓存的子组件边界与可见内容区域不重叠时，所有子组件都被剔除，不需要逐个判断
+        Rect boundsGRect = GetChildrenBounds();
+        boundsGRect.position += contentGRect.position;
+        bool allCulled = m_hasChildrenBounds && !boundsGRect.IsIntersect(cullGRect);
+
         for (auto &child: m_children) {
-            UpdateChildSizeConfigs(child.get());
-            child->Update();
+            if (child && !CullChild(child.get(), contentGRect.position, cullGRect, allCulled)) child->Update();
+        }
+    }
+
+    bool BaseComponent::CullChild(BaseComponent *child, const Vec2 &contentOrigin, const Rect &cullGRect, bool allCulled) const {
+        // 子孙组件的可见矩形总是被祖先的可见矩形裁剪，所以子组件自身的矩形不可见时整个子树都不可见
+        bool culled = allCulled || !Rect(contentOrigin + child->m_position, child->m_size).IsIntersect(cullGRect);
+        if (!culled || child->m_updateWhenHidden) {
+            child->m_culled = culled;
+            return false;
+        }
+
+        // 跳过更新的子树保留着旧的可见矩形，刚被剔除时清空，使其不再响应鼠标事件
+        if (!child->m_culled) {
+            child->m_culled = true;
+            child->ClearVisibleGlobalRects();
+        }
+        return true;
+    }
+
+    void BaseComponent::ClearVisibleGlobalRects() {
+        m_visibleGRect = Rect();
+        for (auto &child: m_children) {
+            if (child) child->ClearVisibleGlobalRects();
+        }
+    }
+
+    void BaseComponent::UpdateLayoutParallel() {
+        if (!m_visible || HasPendingChildChanges()) return;
+        for (auto &child: m_children) {
+            if (child) child->UpdateLayoutParallel();
         }
     }
 
@@ -139,14 +340,58 @@ namespace SimpleGui {
             renderer.FillRect(m_visibleRect, GetThemeColor(ThemeColorFlags::Disabled));
         }*/
 
-        m_toolTip->Render(renderer);
+        RenderToolTipAndExtendedFunctions(renderer);
+
+        // render m_children, 本帧更新之后被移除的子组件在下次更新前留下空位
+        for (auto &child: m_children) {
+            if (child && !child->m_culled) child->Render(renderer);
+        }
+    }
+
+    void BaseComponent::RenderToolTipAndExtendedFunctions(Renderer &renderer) const {
+        if (m_toolTip) m_toolTip->Render(renderer);
 
         // render extended functions
-        m_extFunctionsManager->Render(renderer);
+        if (m_extFunctionsManager) m_extFunctionsManager->Render(renderer);
+    }
 
-        // render m_children
+    BaseComponent::ToolTip &BaseComponent::GetOrCreateToolTip() {
+        if (!m_toolTip) m_toolTip = std::make_unique<ToolTip>(this);
+        return *m_toolTip;
+    }
+
+    ExtendedFunctionsManager &BaseComponent::GetOrCreateExtendedFunctionsManager() {
+        if (!m_extFunctionsManager) m_extFunctionsManager = std::make_unique<ExtendedFunctionsManager>(this);
+        return *m_extFunctionsManager;
+    }
+
+    void BaseComponent::CollectMemoryReport(std::unordered_map<std::string, ComponentMemoryInfo> &report) const {
+        auto &info = report[typeid(*this).name()];
+        ++info.count;
+        if (m_toolTip) {
+            ++info.toolTipCount;
+            info.attachedBytes += sizeof(ToolTip) + sizeof(Timer);
+        }
+        if (m_extFunctionsManager) {
+            ++info.extFunctionsManagerCount;
+            info.attachedBytes += sizeof(ExtendedFunctionsManager);
+        }
+        if (m_font) {
+            ++info.fontCount;
+            info.attachedBytes += sizeof(Font);
+        }
+        if (m_themeColorCaches) {
+            ++info.themeColorMapCount;
+            info.attachedBytes += sizeof(*m_themeColorCaches) +
+                                  m_themeColorCaches->size() * sizeof(std::pair<const ThemeColorFlags, Color>);
+        }
+
+        if (m_toolTip && m_toolTip->cmp) m_toolTip->cmp->CollectMemoryReport(report);
         for (auto &child: m_children) {
-            child->Render(renderer);
+            if (child) child->CollectMemoryReport(report);
+        }
+        for (auto &child: m_childCaches) {
+            if (child) child->CollectMemoryReport(report);
         }
     }
 
@@ -155,49 +400,43 @@ namespace SimpleGui {
         return {pos, GetContentSize()};
     }
 
+    void BaseComponent::SetPosition(const Vec2 pos) {
+        Rect oldRect = GetRect();
+        m_position = pos;
+        NotifyGeometryChanged(oldRect);
+    }
+
+    void BaseComponent::SetPosition(float x, float y) {
+        SetPosition(Vec2(x, y));
+    }
+
+    void BaseComponent::SetPositionX(float x) {
+        SetPosition(Vec2(x, m_position.y));
+    }
+
+    void BaseComponent::SetPositionY(float y) {
+        SetPosition(Vec2(m_position.x, y));
+    }
+
     Vec2 BaseComponent::GetGlobalPosition() const {
         if (m_parent) return m_position + m_parent->GetGlobalPosition() + m_parent->GetLocalCoordinateOriginOffset();
         return m_position;
     }
 
     void BaseComponent::SetGlobalPosition(const Vec2 &pos) {
-        if (m_parent) {
-            m_position = pos - m_parent->GetGlobalPosition() - m_parent->GetLocalCoordinateOriginOffset();
-            return;
-        }
-
-        m_position = pos;
+        SetPosition(MapGlobalPositionToLocal(pos));
     }
 
     void BaseComponent::SetGlobalPosition(float x, float y) {
-        if (m_parent) {
-            Vec2 parentGlobalPos = m_parent->GetGlobalPosition();
-            Vec2 parentOriginOfs = m_parent->GetLocalCoordinateOriginOffset();
-            m_position.x = x - parentGlobalPos.x - parentOriginOfs.x;
-            m_position.y = y - parentGlobalPos.y - parentOriginOfs.y;
-            return;
-        }
-
-        m_position.x = x;
-        m_position.y = y;
+        SetPosition(MapGlobalPositionToLocal(Vec2(x, y)));
     }
 
     void BaseComponent::SetGlobalPositionX(float x) {
-        if (m_parent) {
-            m_position.x = x - m_parent->GetGlobalPosition().x - m_parent->GetLocalCoordinateOriginOffset().x;
-            return;
-        }
-
-        m_position.x = x;
+        SetPositionX(MapGlobalPositionToLocal(Vec2(x, 0)).x);
     }
 
     void BaseComponent::SetGlobalPositionY(float y) {
-        if (m_parent) {
-            m_position.y = y - m_parent->GetGlobalPosition().y - m_parent->GetLocalCoordinateOriginOffset().y;
-            return;
-        }
-
-        m_position.y = y;
+        SetPositionY(MapGlobalPositionToLocal(Vec2(0, y)).y);
     }
 
     Vec2 BaseComponent::MapPositionToGlobal(const Vec2 &pos) const {
@@ -221,11 +460,15 @@ namespace SimpleGui {
     }
 
     void BaseComponent::SetWidth(float w) {
+        Rect oldRect = GetRect();
         m_size.w = w < m_minSize.w ? m_minSize.w : w;
+        NotifyGeometryChanged(oldRect);
     }
 
     void BaseComponent::SetHeight(float h) {
+        Rect oldRect = GetRect();
         m_size.h = h < m_minSize.h ? m_minSize.h : h;
+        NotifyGeometryChanged(oldRect);
     }
 
     void BaseComponent::SetMinSize(const Vec2 &size) {
@@ -239,13 +482,22 @@ namespace SimpleGui {
     }
 
     void BaseComponent::SetMinWidth(float w) {
+        Rect oldRect = GetRect();
+        float oldMin = m_minSize.w;
         m_minSize.w = w < 0 ? 0 : w;
+        // 弹性布局和网格布局以最小大小作为子组件的内容大小
+        if (oldMin != m_minSize.w && m_ownedByParent) InvalidateParentLayout();
         m_size.w = m_size.w < m_minSize.w ? m_minSize.w : m_size.w;
+        NotifyGeometryChanged(oldRect);
     }
 
     void BaseComponent::SetMinHeight(float h) {
+        Rect oldRect = GetRect();
+        float oldMin = m_minSize.h;
         m_minSize.h = h < 0 ? 0 : h;
+        if (oldMin != m_minSize.h && m_ownedByParent) InvalidateParentLayout();
         m_size.h = m_size.h < m_minSize.h ? m_minSize.h : m_size.h;
+        NotifyGeometryChanged(oldRect);
     }
 
     //void BaseComponent::PresetChildrenCount(size_t count) {
@@ -255,9 +507,16 @@ namespace SimpleGui {
     void BaseComponent::SetVisible(bool visible) {
         if (m_visible == visible) return;
         m_visible = visible;
+        if (m_geometryStore) m_geometryStore->SetFlag(m_geometryIndex, GeometryStore::Visible, visible);
+        if (m_ownedByParent) InvalidateParentLayout();
         visibleChanged.Emit(visible);
     }
 
+    void BaseComponent::SetDisabled(bool disabled) {
+        m_disabled = disabled;
+        if (m_geometryStore) m_geometryStore->SetFlag(m_geometryIndex, GeometryStore::Disabled, disabled);
+    }
+
     void BaseComponent::AddChild(std::unique_ptr<BaseComponent> child) {
         if (!child || child->GetParent() == this) {
             SG_WARN("AddChild: this child is null or parent of child already is this.");
@@ -270,12 +529,54 @@ namespace SimpleGui {
 
         SetComponentOwner(child.get(), m_window, this);
         child->m_needRemove = false;
+        child->m_ownedByParent = true;
+        child->RegisterGeometry(m_geometryStore, m_geometryIndex);
+        OnChildAdded(child->GetRect());
         auto temp = child.get();
+        temp->m_inChildCaches = false;
+        temp->m_indexInParent = m_children.size();
         m_children.push_back(std::move(child));
+        ++m_childrenCount;
+        if (m_bulkUpdateDepth) {
+            m_bulkChildrenChanged = true;
+            AddBulkEnteredChild(temp);
+            return;
+        }
+        OnChildrenChanged();
         temp->EnteredComponentTree();
         SG_INFO("AddChild: child entered component tree");
     }
 
+    void BaseComponent::EndBulkUpdate() {
+        if (m_bulkUpdateDepth == 0) return;
+        if (m_bulkUpdateDepth > 1) {
+            --m_bulkUpdateDepth;
+            return;
+        }
+
+        // 子组件进入组件树时（如Label创建文本并调整大小）引起的布局失效仍然合并到最后一次
+        // 批量更新期间已被移除的子组件不在列表中
+        size_t enteredCount = 0;
+        for (size_t i = 0; i < m_bulkEnteredChildren.size(); ++i) {
+            BaseComponent *child = m_bulkEnteredChildren[i];
+            if (!child) continue;
+            child->m_bulkEnterIndex = NOT_BULK_ENTERING;
+            child->EnteredComponentTree();
+            ++enteredCount;
+        }
+        m_bulkUpdateDepth = 0;
+        if (enteredCount) {
+            SG_INFO("AddChildren: {} children entered component tree", enteredCount);
+        }
+        m_bulkEnteredChildren.clear();
+        m_bulkEnteredChildren.shrink_to_fit();
+
+        if (m_bulkChildrenChanged) {
+            m_bulkChildrenChanged = false;
+            OnChildrenChanged();
+        }
+    }
+
     void BaseComponent::AddChildDeferred(std::unique_ptr<BaseComponent> child) {
         if (!child || child->GetParent() == this) return;
         if (child->GetParent()) {
@@ -285,11 +586,36 @@ namespace SimpleGui {
 
         SetComponentOwner(child.get(), m_window, this);
         child->m_needRemove = false;
+        child->m_ownedByParent = true;
+        child->RegisterGeometry(m_geometryStore, m_geometryIndex);
+        OnChildAdded(child->GetRect());
         auto temp = child.get();
+        temp->m_inChildCaches = true;
+        temp->m_indexInParent = m_childCaches.size();
         m_childCaches.push_back(std::move(child));
+        ++m_childrenCount;
+        if (m_bulkUpdateDepth) {
+            m_bulkChildrenChanged = true;
+            AddBulkEnteredChild(temp);
+            return;
+        }
+        OnChildrenChanged();
         temp->EnteredComponentTree();
     }
 
+    void BaseComponent::AddBulkEnteredChild(BaseComponent *child) {
+        child->m_bulkEnterIndex = m_bulkEnteredChildren.size();
+        m_bulkEnteredChildren.push_back(child);
+    }
+
+    bool BaseComponent::DiscardBulkEnteredChild(BaseComponent *child) {
+        // 通过子组件记录的下标直接留下空位，批量移除时不需要逐个查找
+        if (child->m_bulkEnterIndex == NOT_BULK_ENTERING) return false;
+        m_bulkEnteredChildren[child->m_bulkEnterIndex] = nullptr;
+        child->m_bulkEnterIndex = NOT_BULK_ENTERING;
+        return true;
+    }
+
     BaseComponent *BaseComponent::GetChildAt(size_t idx) const {
         if (idx < m_children.size()) {
             return m_children[idx].get();
@@ -303,125 +629,169 @@ namespace SimpleGui {
         return nullptr;
     }
 
-    std::unique_ptr<BaseComponent> BaseComponent::RemoveChild(BaseComponent *cmp) {
-        auto it = std::ranges::find_if(m_children,
-                                       [cmp](auto &child) {
-                                           return child.get() == cmp;
-                                       });
-
-        if (it != m_children.end()) {
-            std::unique_ptr<BaseComponent> child = std::move(*it);
-            m_children.erase(it);
-            child->m_parent = nullptr;
-            child->m_window = nullptr;
-            child->ExitedComponentTree();
-            return child;
-        }
+    std::unique_ptr<BaseComponent> *BaseComponent::FindChildSlot(BaseComponent *cmp) {
+        if (!cmp || cmp->m_parent != this) return nullptr;
+        auto &list = cmp->m_inChildCaches ? m_childCaches : m_children;
+        if (cmp->m_indexInParent >= list.size() || list[cmp->m_indexInParent].get() != cmp) return nullptr;
+        return &list[cmp->m_indexInParent];
+    }
 
-        return nullptr;
+    std::unique_ptr<BaseComponent> BaseComponent::RemoveChild(BaseComponent *cmp) {
+        auto slot = FindChildSlot(cmp);
+        if (!slot) return nullptr;
+
+        // 原位置留下空位，在下次更新子组件之前统一压缩
+        std::unique_ptr<BaseComponent> child = std::move(*slot);
+        m_childrenNeedCompact = true;
+        --m_childrenCount;
+        child->m_ownedByParent = false;
+        child->UnregisterGeometry();
+        OnChildRemoved(child->GetRect());
+        OnChildrenChanged();
+        child->m_parent = nullptr;
+        child->m_window = nullptr;
+        if (!DiscardBulkEnteredChild(child.get())) child->ExitedComponentTree();
+        return child;
     }
 
     std::unique_ptr<BaseComponent> BaseComponent::RemoveChildDeferred(BaseComponent *cmp) {
-        auto it = std::ranges::find_if(m_children,
-                                       [cmp](auto &child) {
-                                           return child.get() == cmp;
-                                       });
+        // 移除只留下空位，遍历子组件期间也可以安全地移除
+        return BaseComponent::RemoveChild(cmp);
+    }
 
-        if (it != m_children.end()) {
-            std::unique_ptr<BaseComponent> child = std::move(*it);
-            child->m_parent = nullptr;
-            child->m_window = nullptr;
-            //child->m_needRemove = true;			// 其实不需要使用need_remove标记，移动后，原位置上为nullptr
-            child->ExitedComponentTree();
-            return child;
-        }
+    bool BaseComponent::MoveChildToTop(BaseComponent *cmp) {
+        if (!FindChildSlot(cmp) || cmp->m_inChildCaches) return false;
 
-        return nullptr;
+        size_t idx = cmp->m_indexInParent;
+        if (idx + 1 == m_children.size()) return false;
+        std::rotate(m_children.begin() + idx, m_children.begin() + idx + 1, m_children.end());
+        for (size_t i = idx; i < m_children.size(); ++i) {
+            if (m_children[i]) m_children[i]->m_indexInParent = i;
+        }
+        return true;
     }
 
     size_t BaseComponent::GetChildrenCount() const {
-        auto count1 = std::ranges::count_if(m_children,
-                                            [](auto &child) {
-                                                return child != nullptr;
-                                            });
-        return count1 + m_childCaches.size();
+        return m_childrenCount;
     }
 
     bool BaseComponent::HasChild(BaseComponent *cmp) {
-        auto it = std::ranges::find_if(m_children,
-                                       [cmp](auto &child) {
-                                           return child.get() == cmp;
-                                       });
-
-        auto cachesIt = std::ranges::find_if(m_childCaches,
-                                             [cmp](auto &child) {
-                                                 return child.get() == cmp;
-                                             });
-
-        return it != m_children.end() || cachesIt != m_childCaches.end();
+        return FindChildSlot(cmp) != nullptr;
     }
 
     void BaseComponent::ClearAllChildren() {
+        // 先移出子组件，通知它们离开组件树后再统一销毁
+        auto children = std::move(m_children);
+        auto childCaches = std::move(m_childCaches);
         m_children.clear();
         m_childCaches.clear();
-
-        for (auto &child: m_children) {
-            child->ExitedComponentTree();
+        m_childrenCount = 0;
+        m_childrenNeedCompact = false;
+        m_hasChildrenBounds = false;
+        m_childrenBoundsDirty = false;
+        OnChildrenChanged();
+
+        // 批量更新期间添加的子组件还没有进入组件树，不需要通知
+        for (auto *list: { &children, &childCaches }) {
+            for (auto &child: *list) {
+                if (!child) continue;
+                child->m_ownedByParent = false;
+                if (!DiscardBulkEnteredChild(child.get())) child->ExitedComponentTree();
+            }
         }
+        m_bulkEnteredChildren.clear();
     }
 
     void BaseComponent::ClearAllChildrenDeferred() const {
+        m_childrenNeedCompact = true;
         for (auto &child: m_children) {
-            child->m_needRemove = true;
+            if (child) child->m_needRemove = true;
         }
 
         for (auto &child: m_childCaches) {
-            child->m_needRemove = true;
+            if (child) child->m_needRemove = true;
         }
     }
 
-    void BaseComponent::ForEachChild(const std::function<void(BaseComponent *)> &fn) {
-        for (auto &child: m_children) {
-            if (!child || child->m_needRemove) continue;
-            fn(child.get());
-        }
-
-        for (auto &child: m_childCaches) {
-            if (!child || child->m_needRemove) continue;
-            fn(child.get());
-        }
+    const Font &BaseComponent::GetFont() const {
+        if (m_font && !m_font->IsNull()) return *m_font;
+        if (m_window) return m_window->GetFont();
+        return SG_GuiManager.GetDefaultFont();
     }
 
-    Font &BaseComponent::GetFont() {
-        if (!m_font || m_font->IsNull()) {
-            const Font &font = m_window ? m_window->GetFont() : SG_GuiManager.GetDefaultFont();
-            m_font = std::make_unique<Font>(font.GetPath(), font.GetSize());
-        }
+    Font &BaseComponent::GetOrCreateFont() {
+        if (m_font && !m_font->IsNull()) return *m_font;
+
+        const Font &font = GetFont();
+        auto copy = std::make_unique<Font>(font.GetPath(), font.GetSize());
+        copy->SetStyle(font.GetStyle());
+        SetFont(std::move(copy));
         return *m_font;
     }
 
+    void BaseComponent::SetFont(std::unique_ptr<Font> font) {
+        // 旧字体在组件切换到新字体之后才关闭
+        auto oldFont = std::move(m_font);
+        m_font = std::move(font);
+        OnFontChanged();
+    }
+
     void BaseComponent::SetFont(std::string_view path, int size) {
-        m_font = std::make_unique<Font>(path, size);
+        SetFont(std::make_unique<Font>(path, size));
+    }
+
+    void BaseComponent::NotifyWindowFontChanged() {
+        if (!m_font || m_font->IsNull()) OnFontChanged();
+        if (m_toolTip && m_toolTip->cmp) m_toolTip->cmp->NotifyWindowFontChanged();
+        for (auto &child: m_children) {
+            if (child) child->NotifyWindowFontChanged();
+        }
+        for (auto &child: m_childCaches) {
+            if (child) child->NotifyWindowFontChanged();
+        }
     }
 
     Color BaseComponent::GetThemeColor(ThemeColorFlags flag) {
-        if (m_themeColorCaches.contains(flag)) return m_themeColorCaches[flag];
+        if (m_themeColorCaches) {
+            if (auto it = m_themeColorCaches->find(flag); it != m_themeColorCaches->end()) return it->second;
+        }
         if (m_parent) return m_parent->GetThemeColor(flag);
         if (m_window) return m_window->GetCurrentStyle()->colors[flag];
         return SG_GuiManager.GetDefaultStyle().colors[flag];
     }
 
+    const NineSliceSkin *BaseComponent::GetThemeSkin(ThemeColorFlags flag) {
+        if (m_themeColorCaches && m_themeColorCaches->contains(flag)) return nullptr;
+        if (m_parent) return m_parent->GetThemeSkin(flag);
+
+        const Style &style = m_window ? *m_window->GetCurrentStyle() : SG_GuiManager.GetDefaultStyle();
+        auto it = style.skins.find(flag);
+        if (it == style.skins.end() || !it->second.texture || it->second.texture->IsNull()) return nullptr;
+        return &it->second;
+    }
+
+    void BaseComponent::RenderThemeBackground(Renderer &renderer, ThemeColorFlags flag) {
+        const NineSliceSkin *skin = GetThemeSkin(flag);
+        if (!skin) {
+            renderer.RenderRect(m_visibleGRect, GetThemeColor(flag), true);
+            return;
+        }
+
+        Rect srcRect = skin->srcRect.size.w > 0 && skin->srcRect.size.h > 0 ? skin->srcRect : skin->texture->GetRect();
+        renderer.RenderNineSlice(&skin->texture->GetSDLTexture(), srcRect, skin->insets, GetGlobalRect(), m_visibleGRect, skin->color);
+    }
+
     void BaseComponent::CustomThemeColor(ThemeColorFlags flag, const Color &color) {
-        if (m_themeColorCaches[flag] == color) return;
-        m_themeColorCaches[flag] = color;
+        if (!m_themeColorCaches) m_themeColorCaches = std::make_unique<std::unordered_map<ThemeColorFlags, Color>>();
+        (*m_themeColorCaches)[flag] = color;
     }
 
     void BaseComponent::ClearCustomThemeColor(ThemeColorFlags flag) {
-        m_themeColorCaches.erase(flag);
+        if (m_themeColorCaches) m_themeColorCaches->erase(flag);
     }
 
     void BaseComponent::ClearCustomThemeColors() {
-        m_themeColorCaches.clear();
+        m_themeColorCaches.reset();
     }
 
     BaseComponent::ToolTip::ToolTip(BaseComponent *target) {
@@ -472,9 +842,9 @@ namespace SimpleGui {
     void BaseComponent::ToolTip::Render(Renderer &renderer) const {
         if (!enabled || !cmp) return;
 
-        renderer.SetTopRender(true);
+        renderer.PushRenderLayer(RenderLayer::Tooltip);
         cmp->Render(renderer);
-        renderer.SetTopRender(false);
+        renderer.PopRenderLayer();
     }
 
     void BaseComponent::ToolTip::SetSafePositionForComponent() const {
@@ -88,17 +88,17 @@ namespace SimpleGui {
 
 		renderer.RenderRect(m_visibleGRect, GetThemeColor(ThemeColorFlags::Background), true);
 
-		Color color;
+		ThemeColorFlags flag;
 		if (m_mouseState == MouseState::Normal) {
-			color = GetThemeColor(ThemeColorFlags::ButtonNormal);
+			flag = ThemeColorFlags::ButtonNormal;
 		}
 		else if (m_mouseState == MouseState::Hovering) {
-			color = GetThemeColor(ThemeColorFlags::ButtonHovered);
+			flag = ThemeColorFlags::ButtonHovered;
 		}
 		else {
-			color = GetThemeColor(ThemeColorFlags::ButtonPressed);
+			flag = ThemeColorFlags::ButtonPressed;
 		}
-		renderer.RenderRect(m_visibleGRect, color, true);
+		RenderThemeBackground(renderer, flag);
 
 		m_lbl->CustomThemeColor(ThemeColorFlags::LabelForeground, GetThemeColor(ThemeColorFlags::ButtonForeground));
 		m_lbl->Render(renderer);
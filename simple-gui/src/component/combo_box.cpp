@@ -1,3 +1,4 @@
+#include <numeric>
 #include "component/combo_box.hpp"
 
 #include "event.hpp"
@@ -5,6 +6,56 @@
 
 
 namespace SimpleGui {
+	static std::string ToLower(std::string_view text) {
+		std::string lower(text);
+		for (auto& c : lower) {
+			c = static_cast<char>(SDL_tolower(static_cast<unsigned char>(c)));
+		}
+		return lower;
+	}
+
+
+	class ComboBox::ItemsListModel final : public ListViewModel {
+	public:
+		explicit ItemsListModel(ComboBox* comboBox) : m_comboBox(comboBox) {}
+
+		size_t GetRowCount() const override { return m_comboBox->GetFilteredItemCount(); }
+
+	private:
+		ComboBox* m_comboBox;
+	};
+
+
+	class ComboBox::ItemsListDelegate final : public ListViewDelegate {
+	public:
+		explicit ItemsListDelegate(ComboBox* comboBox) : m_comboBox(comboBox) {}
+
+		std::unique_ptr<BaseComponent> CreateRowComponent() override {
+			auto lbl = std::make_unique<Label>("");
+			lbl->SetTextAlignments(TextAlignment::Left, TextAlignment::Center);
+			return lbl;
+		}
+
+		void BindRowComponent(BaseComponent* cmp, size_t row) override {
+			auto lbl = static_cast<Label*>(cmp);
+			size_t index = m_comboBox->GetItemIndex(row);
+			lbl->SetText(m_comboBox->m_items[index]);
+
+			Color bgColor = Color::TRANSPARENT;
+			if (m_comboBox->m_hasCurrentItem && index == m_comboBox->m_currIndex) {
+				bgColor = m_comboBox->GetThemeColor(ThemeColorFlags::ComboBoxItemSelected);
+			}
+			else if (row == m_comboBox->m_hoveredRow) {
+				bgColor = m_comboBox->GetThemeColor(ThemeColorFlags::ComboBoxItemHovered);
+			}
+			lbl->CustomThemeColor(ThemeColorFlags::LabelBackground, bgColor);
+		}
+
+	private:
+		ComboBox* m_comboBox;
+	};
+
+
 	ComboBox::ComboBox(const std::vector<std::string>& items) {
 		m_maxItemsListHeight = 120.f;
 
@@ -12,22 +63,34 @@ namespace SimpleGui {
 		m_masterItemLbl->CustomThemeColor(ThemeColorFlags::LabelBackground, Color::TRANSPARENT);
 		m_masterItemLbl->SetSizeConfigs(ComponentSizeConfig::Expanding, ComponentSizeConfig::Expanding);
 
-		m_itemsPanel = std::make_unique<ScrollPanel>();
-		m_itemsPanel->SetVisible(false);
-		m_itemsPanel->SetWidth(m_maxItemsListWidth);
-		m_itemsPanel->SetHeight(m_maxItemsListHeight);
-		m_itemsPanel->CustomThemeColor(ThemeColorFlags::ScrollPanelBackground, GetThemeColor(ThemeColorFlags::ComboBoxBackground));
-		m_itemsPanel->CustomThemeColor(ThemeColorFlags::ScrollPanelBorder, GetThemeColor(ThemeColorFlags::ComboBoxBorder));
-		m_itemsPanel->CustomThemeColor(ThemeColorFlags::ScrollbarBorder_V, Color::TRANSPARENT);
+		m_items = items;
+		m_lowerItems.reserve(m_items.size());
+		for (const auto& item : m_items) {
+			m_lowerItems.push_back(ToLower(item));
+		}
+
+		m_itemsList = std::make_unique<ListView>();
+		m_itemsList->SetVisible(false);
+		m_itemsList->SetModel(std::make_shared<ItemsListModel>(this));
+		m_itemsList->SetDelegate(std::make_unique<ItemsListDelegate>(this));
+		m_itemsList->CustomThemeColor(ThemeColorFlags::ListViewBackground, GetThemeColor(ThemeColorFlags::ComboBoxBackground));
+		m_itemsList->CustomThemeColor(ThemeColorFlags::ListViewBorder, GetThemeColor(ThemeColorFlags::ComboBoxBorder));
+		m_itemsList->rowClicked.Connect("on_rowClicked",
+			[this](size_t row) {
+				SetCurrentItem(GetItemIndex(row));
+				if (m_autoHideItemsList) {
+					ShowItemsList(false);
+				}
+			});
 
 		m_toggleRect.gRect.size.x = 15;
 		SetSize(85, 25);
 		SetMinWidth(25);
 
-		m_items = items;
 		if (!m_items.empty()) {
 			m_masterItemLbl->SetText(m_items[0]);
 			m_currIndex = 0;
+			m_hasCurrentItem = true;
 		}
 	}
 
@@ -36,12 +99,15 @@ namespace SimpleGui {
 		SetComponentOwner(m_masterItemLbl.get(), m_window, this);
 		BaseComponent::EnteredComponentTree(m_masterItemLbl.get());
 
-		SetComponentOwner(m_itemsPanel.get(), m_window, &m_window->GetRootComponent());
-		BaseComponent::EnteredComponentTree(m_itemsPanel.get());
+		SetComponentOwner(m_itemsList.get(), m_window, &m_window->GetRootComponent());
+		BaseComponent::EnteredComponentTree(m_itemsList.get());
 
+		m_maxItemsListWidth = 0;
 		for (const auto& item : m_items) {
-			AddItem(item, false);
+			MeasureItem(item);
 		}
+		m_itemsList->SetWidth(m_maxItemsListWidth);
+		RefreshItemsList();
 	}
 
 	bool ComboBox::HandleEvent(Event* event) {
@@ -49,7 +115,8 @@ namespace SimpleGui {
 
 		if (BaseComponent::HandleEvent(event)) return true;
 		if (HandleToggleItemsList(event)) return true;
-		if (m_itemsPanel->HandleEvent(event)) return true;
+		if (HandleTypeAhead(event)) return true;
+		if (m_itemsList->HandleEvent(event)) return true;
 		if (HandleSelectItem(event)) return true;
 
 		return false;
@@ -57,7 +124,7 @@ namespace SimpleGui {
 
 	void ComboBox::Update() {
 		SG_CMP_UPDATE_CONDITIONS;
-		
+
 		BaseComponent::Update();
 
 		m_masterItemLbl->Update();
@@ -68,7 +135,7 @@ namespace SimpleGui {
 		m_toggleRect.gRect.size.h = m_size.h;
 		m_toggleRect.visibleGRect = CalcVisibleGlobalRect(m_visibleGRect, m_visibleGRect, m_toggleRect.gRect);
 
-		m_itemsPanel->Update();
+		m_itemsList->Update();
 	}
 
 	void ComboBox::Render(Renderer& renderer) {
@@ -93,85 +160,218 @@ namespace SimpleGui {
 		BaseComponent::Render(renderer);
 	}
 
-	void ComboBox::AddItem(const std::string &item, bool addToItems) {
-		if (addToItems) m_items.push_back(item);
+	size_t ComboBox::GetItemRow(size_t index) const {
+		if (m_filterText.empty()) return index < m_items.size() ? index : INVALID_INDEX;
+
+		auto it = std::ranges::lower_bound(m_filteredItems, index);
+		if (it == m_filteredItems.end() || *it != index) return INVALID_INDEX;
+		return it - m_filteredItems.begin();
+	}
 
-		const float y = m_itemLbls.empty() ? 0 : m_itemLbls.back()->GetRect().Bottom();
-		const auto lbl = m_itemsPanel->AddChildDeferred<Label>(item);
-		lbl->SetSizeConfigW(ComponentSizeConfig::Expanding);
-		lbl->SetPosition(0, y);
-		m_itemLbls.push_back(lbl);
+	void ComboBox::MeasureItem(const std::string& item) {
+		if (!m_window) return;
 
-		const float w = lbl->GetSize().w;
+		auto padding = m_window->GetCurrentStyle()->componentPadding;
+		float w = GetFont().GetTextSize(item).w + padding.left + padding.right + 30;
 		if (m_maxItemsListWidth < w) {
-			m_maxItemsListWidth = w + 30;
-			m_itemsPanel->SetWidth(m_maxItemsListWidth);
+			m_maxItemsListWidth = w;
+			m_itemsList->SetWidth(m_maxItemsListWidth);
 		}
+	}
+
+	void ComboBox::ShowItemsList(bool show) {
+		if (show == m_itemsList->IsVisible()) return;
+
+		m_itemsList->SetVisible(show);
+		m_hoveredRow = INVALID_INDEX;
+
+		if (show) {
+			RefreshItemsList();
+			SetSafePositionForItemList();
+			if (m_hasCurrentItem) m_itemsList->ScrollToRow(GetItemRow(m_currIndex));
+			// 其他组件已经开启了文本输入时不接管
+			if (!SDL_TextInputActive(&m_window->GetSDLWindow())) {
+				m_textInputStarted = SDL_StartTextInput(&m_window->GetSDLWindow());
+			}
+		}
+		else {
+			if (m_textInputStarted) SDL_StopTextInput(&m_window->GetSDLWindow());
+			m_textInputStarted = false;
+			if (!m_filterText.empty()) SetFilterText("");
+		}
+	}
+
+	void ComboBox::SetFilterText(std::string_view text) {
+		if (text == m_filterText) return;
 
-		auto height = y + lbl->GetSize().h;
-		if (height <= m_maxItemsListHeight) {
-			m_itemsPanel->SetHeight(height);
+		// 在原过滤文本后追加字符时只需在上一次的匹配范围内查找
+		bool narrowing = !m_filterText.empty() && text.starts_with(m_filterText);
+		m_filterText = text;
+		m_masterItemLbl->SetText(m_filterText.empty() ? GetCurrentItem() : m_filterText);
+
+		UpdateFilter(narrowing);
+		RefreshItemsList();
+	}
+
+	void ComboBox::UpdateFilter(bool narrowing) {
+		if (m_filterText.empty()) {
+			m_lowerFilterText.clear();
+			m_filteredItems.clear();
+			return;
+		}
+
+		if (m_prefixIndexDirty) {
+			RebuildPrefixIndex();
+			narrowing = false;
+		}
+
+		m_lowerFilterText = ToLower(m_filterText);
+		std::string_view key = m_lowerFilterText;
+		auto Prefix = [this, &key](size_t index) {
+			return std::string_view(m_lowerItems[index]).substr(0, key.length());
+			};
+
+		auto begin = m_prefixIndex.begin() + (narrowing ? m_matchFirst : 0);
+		auto end = m_prefixIndex.begin() + (narrowing ? m_matchLast : m_prefixIndex.size());
+		auto first = std::lower_bound(begin, end, key, [&Prefix](size_t index, std::string_view k) { return Prefix(index) < k; });
+		auto last = std::upper_bound(first, end, key, [&Prefix](std::string_view k, size_t index) { return k < Prefix(index); });
+		m_matchFirst = first - m_prefixIndex.begin();
+		m_matchLast = last - m_prefixIndex.begin();
+
+		m_filteredItems.assign(first, last);
+		std::ranges::sort(m_filteredItems);
+	}
+
+	void ComboBox::RebuildPrefixIndex() {
+		m_prefixIndex.resize(m_items.size());
+		std::iota(m_prefixIndex.begin(), m_prefixIndex.end(), 0);
+		std::ranges::stable_sort(m_prefixIndex, [this](size_t a, size_t b) { return m_lowerItems[a] < m_lowerItems[b]; });
+		m_prefixIndexDirty = false;
+	}
+
+	void ComboBox::InsertPrefixIndex(size_t index) {
+		const std::string& lowerItem = m_lowerItems[index];
+		auto pos = std::ranges::upper_bound(m_prefixIndex, lowerItem, {}, [this](size_t i) -> const std::string& { return m_lowerItems[i]; });
+		size_t offset = pos - m_prefixIndex.begin();
+		m_prefixIndex.insert(pos, index);
+		if (m_filterText.empty()) return;
+
+		// 新项的下标最大，匹配时直接追加到过滤结果末尾；不匹配时位于匹配范围之前或之后
+		if (lowerItem.starts_with(m_lowerFilterText)) {
+			++m_matchLast;
+			m_filteredItems.push_back(index);
+		}
+		else if (offset <= m_matchFirst) {
+			++m_matchFirst;
+			++m_matchLast;
 		}
 	}
 
+	void ComboBox::RefreshItemsList() {
+		m_hoveredRow = INVALID_INDEX;
+		m_itemsList->ResetModel();
+
+		auto padding = m_itemsList->GetPadding();
+		size_t rowCount = SDL_max(GetFilteredItemCount(), static_cast<size_t>(1));
+		float height = rowCount * m_itemsList->GetDefaultRowHeight() + padding.top + padding.bottom;
+		m_itemsList->SetHeight(SDL_min(height, m_maxItemsListHeight));
+
+		if (m_itemsList->IsVisible()) SetSafePositionForItemList();
+	}
+
+	void ComboBox::SetHoveredRow(size_t row) {
+		if (row == m_hoveredRow) return;
+
+		size_t lastRow = m_hoveredRow;
+		m_hoveredRow = row;
+		if (lastRow != INVALID_INDEX) m_itemsList->UpdateRows(lastRow, 1);
+		if (row != INVALID_INDEX) m_itemsList->UpdateRows(row, 1);
+	}
+
 	bool ComboBox::HandleToggleItemsList(Event* event) {
 		if (auto ev = event->Convert<MouseButtonEvent>();
 			ev && ev->IsPressed(MouseButton::Left) &&
 			(m_toggleRect.visibleGRect.ContainPoint(ev->GetPosition()) ||
 			m_visibleGRect.ContainPoint(ev->GetPosition()))) {
-			m_itemsPanel->SetVisible(!m_itemsPanel->IsVisible());
-			if (m_itemsPanel->IsVisible()) {
-				SetSafePositionForItemList();
-				m_hoveringLbl = nullptr;
-				m_lastHoveredLbl = nullptr;
-			}
+			ShowItemsList(!m_itemsList->IsVisible());
 			return true;
 		}
 		return false;
 	}
 
 	bool ComboBox::HandleSelectItem(Event* event) {
-		if (!m_itemsPanel->IsVisible()) return false;
+		if (!m_itemsList->IsVisible()) return false;
 
 		if (auto ev = event->Convert<MouseButtonEvent>();
 			ev && ev->IsPressed(MouseButton::Left)) {
-			if (!m_itemsPanel->GetGlobalRect().ContainPoint(ev->GetPosition())) {
-				m_itemsPanel->SetVisible(false);
+			if (!m_itemsList->GetGlobalRect().ContainPoint(ev->GetPosition())) {
+				ShowItemsList(false);
 				return false;
 			}
+			return true;
+		}
 
-			for (int i = 0; i < m_itemLbls.size(); ++i) {
-				if (!m_itemLbls[i]->GetGlobalRect().ContainPoint(ev->GetPosition())) continue;
-				SetCurrentItem(i);
-				if (m_autoHideItemsList) {
-					m_itemsPanel->SetVisible(false);
-				}
-				break;
-			}
+		if (auto ev = event->Convert<MouseMotionEvent>()) {
+			size_t row = m_itemsList->GetRowAtPosition(ev->GetPosition());
+			SetHoveredRow(row == ListView::INVALID_ROW ? INVALID_INDEX : row);
+			return m_hoveredRow != INVALID_INDEX;
+		}
 
+		return false;
+	}
+
+	bool ComboBox::HandleTypeAhead(Event* event) {
+		if (!m_itemsList->IsVisible()) return false;
+
+		if (auto ev = event->Convert<KeyBoardTextInputEvent>()) {
+			SetFilterText(m_filterText + ev->GetInputText());
 			return true;
 		}
 
-		if (auto ev = event->Convert<MouseMotionEvent>()) {
-			if (!m_itemsPanel->GetContentGlobalRect().ContainPoint(ev->GetPosition())) {
-				m_lastHoveredLbl = m_hoveringLbl;
-				m_hoveringLbl = nullptr;
-				return false;
-			}
+		auto ev = event->Convert<KeyBoardButtonEvent>();
+		if (!ev || !ev->IsPressed()) return false;
+
+		size_t rowCount = GetFilteredItemCount();
+		switch (ev->GetKeyCode()) {
+		case SDLK_BACKSPACE: {
+			if (m_filterText.empty()) return true;
+			// 删除最后一个utf8字符
+			std::string text = m_filterText;
+			while (!text.empty() && (static_cast<unsigned char>(text.back()) & 0xc0) == 0x80) text.pop_back();
+			if (!text.empty()) text.pop_back();
+			SetFilterText(text);
+			return true;
+		}
 
-			if (m_hoveringLbl && m_hoveringLbl->GetGlobalRect().ContainPoint(ev->GetPosition())) return false;
+		case SDLK_ESCAPE:
+			ShowItemsList(false);
+			return true;
 
-			int index = -1;
-			for (const auto& lbl : m_itemLbls) {
-				index++;
-				if (!lbl->GetGlobalRect().ContainPoint(ev->GetPosition())) continue;
-				if (lbl != m_hoveringLbl) m_lastHoveredLbl = m_hoveringLbl;
-				m_hoveringLbl = lbl;
-				return true;
-			}
+		case SDLK_UP:
+		case SDLK_DOWN: {
+			if (rowCount == 0) return true;
+			bool down = ev->GetKeyCode() == SDLK_DOWN;
+			size_t row = m_hoveredRow;
+			if (row == INVALID_INDEX) row = down ? 0 : rowCount - 1;
+			else if (down) row = SDL_min(row + 1, rowCount - 1);
+			else if (row > 0) --row;
+			SetHoveredRow(row);
+			m_itemsList->ScrollToRow(row);
+			return true;
 		}
 
-		return false;
+		case SDLK_RETURN:
+		case SDLK_KP_ENTER: {
+			size_t row = m_hoveredRow;
+			if (row == INVALID_INDEX && rowCount == 1) row = 0;
+			if (row != INVALID_INDEX) SetCurrentItem(GetItemIndex(row));
+			if (row != INVALID_INDEX && m_autoHideItemsList) ShowItemsList(false);
+			return true;
+		}
+
+		default:
+			return false;
+		}
 	}
 
 	void ComboBox::RenderToggleRect(Renderer &renderer) {
@@ -181,7 +381,7 @@ namespace SimpleGui {
 			m_toggleRect.gRect.position.y + (m_toggleRect.gRect.size.h - 10) / 2,
 			10, 10
 		);
-		if (!m_itemsPanel->IsVisible()) {
+		if (!m_itemsList->IsVisible()) {
 			Vec2 bottomCenter(
 					centerRect.position.x + centerRect.size.x / 2,
 					centerRect.position.y + centerRect.size.y
@@ -211,38 +411,22 @@ namespace SimpleGui {
 	}
 
 	void ComboBox::RenderItemsList(Renderer& renderer) {
-		if (!m_itemsPanel->IsVisible()) return;
+		if (!m_itemsList->IsVisible()) return;
 
-		renderer.SetTopRender(true);
-		if (m_lastSelectedLbl) {
-			m_lastSelectedLbl->CustomThemeColor(ThemeColorFlags::LabelBackground, Color::TRANSPARENT);
-		}
+		renderer.PushRenderLayer(RenderLayer::Popup);
 
-		//draw hovered
-		if (m_hoveringLbl) {
-			m_hoveringLbl->CustomThemeColor(ThemeColorFlags::LabelBackground, GetThemeColor(ThemeColorFlags::ComboBoxItemHovered));
-		}
-		if (m_lastHoveredLbl) {
-			m_lastHoveredLbl->CustomThemeColor(ThemeColorFlags::LabelBackground, Color::TRANSPARENT);
-		}
-
-		//draw selected
-		if (m_selectedLbl) {
-			m_selectedLbl->CustomThemeColor(ThemeColorFlags::LabelBackground, GetThemeColor(ThemeColorFlags::ComboBoxItemSelected));
-		}
-
-		m_itemsPanel->CustomThemeColor(ThemeColorFlags::ScrollPanelBackground, GetThemeColor(ThemeColorFlags::ComboBoxBackground));
-		m_itemsPanel->CustomThemeColor(ThemeColorFlags::ScrollPanelBorder, GetThemeColor(ThemeColorFlags::ComboBoxBorder));
-		m_itemsPanel->CustomThemeColor(ThemeColorFlags::LabelForeground, GetThemeColor(ThemeColorFlags::ComboBoxForeground));
-		m_itemsPanel->Render(renderer);
+		m_itemsList->CustomThemeColor(ThemeColorFlags::ListViewBackground, GetThemeColor(ThemeColorFlags::ComboBoxBackground));
+		m_itemsList->CustomThemeColor(ThemeColorFlags::ListViewBorder, GetThemeColor(ThemeColorFlags::ComboBoxBorder));
+		m_itemsList->CustomThemeColor(ThemeColorFlags::LabelForeground, GetThemeColor(ThemeColorFlags::ComboBoxForeground));
+		m_itemsList->Render(renderer);
 
-		renderer.SetTopRender(false);
+		renderer.PopRenderLayer();
 	}
 
 	void ComboBox::SetSafePositionForItemList() const {
 		const Rect rootContentGRect = m_window->GetRootComponent().GetContentGlobalRect();
 		const Rect gRect = GetGlobalRect();
-		Rect panelGRect = m_itemsPanel->GetGlobalRect();
+		Rect panelGRect = m_itemsList->GetGlobalRect();
 		panelGRect.position.x = gRect.position.x;
 		panelGRect.position.y = gRect.Bottom() + 3;
 
@@ -250,7 +434,7 @@ namespace SimpleGui {
 		if (panelGRect.Right() > rootContentGRect.Right()) panelGRect.position.x = rootContentGRect.Right() - panelGRect.size.w;
 		if (panelGRect.Bottom() > rootContentGRect.Bottom()) panelGRect.position.y = gRect.Top() - panelGRect.size.h - 3;
 
-		m_itemsPanel->SetGlobalPosition(panelGRect.position);
+		m_itemsList->SetGlobalPosition(panelGRect.position);
 	}
 
 	std::string ComboBox::GetItem(size_t index) const {
@@ -267,16 +451,26 @@ namespace SimpleGui {
 	}
 
 	void ComboBox::SetCurrentItem(size_t index) {
+		if (m_items.empty()) return;
 		index = SDL_clamp(index, 0, m_items.size() - 1);
-		auto lbl = m_itemLbls[index];
+		if (m_hasCurrentItem && index == m_currIndex) return;
 
-		if (lbl == m_selectedLbl) return;
-		m_lastSelectedLbl = m_selectedLbl;
-		m_selectedLbl = lbl;
-		m_masterItemLbl->SetText(lbl->GetText());
+		size_t lastIndex = m_currIndex;
+		bool hadCurrentItem = m_hasCurrentItem;
 		m_currIndex = index;
+		m_hasCurrentItem = true;
+		if (m_filterText.empty()) m_masterItemLbl->SetText(m_items[m_currIndex]);
 
-		currentItemChanged.Emit(m_currIndex, m_masterItemLbl->GetText());
+		// 重新绑定选中状态发生变化的行
+		if (hadCurrentItem && lastIndex < m_items.size()) {
+			size_t row = GetItemRow(lastIndex);
+			if (row != INVALID_INDEX) m_itemsList->UpdateRows(row, 1);
+		}
+		if (size_t row = GetItemRow(m_currIndex); row != INVALID_INDEX) {
+			m_itemsList->UpdateRows(row, 1);
+		}
+
+		currentItemChanged.Emit(m_currIndex, m_items[m_currIndex]);
 	}
 
 	void ComboBox::SetCurrentItem(const std::string& item) {
@@ -286,59 +480,56 @@ namespace SimpleGui {
 	}
 
 	void ComboBox::AddItem(const std::string& item) {
-		AddItem(item, true);
+		size_t index = m_items.size();
+		m_items.push_back(item);
+		m_lowerItems.push_back(ToLower(item));
+		MeasureItem(item);
+
+		// 索引有效时把新项插入到有序位置，逐个添加时不需要每次重新排序；索引失效时只在过滤时重建一次
+		if (!m_prefixIndexDirty) InsertPrefixIndex(index);
+		else if (!m_filterText.empty()) UpdateFilter(false);
+		RefreshItemsList();
 	}
 
 	void ComboBox::AddItems(const std::vector<std::string> &items) {
+		m_items.reserve(m_items.size() + items.size());
+		m_lowerItems.reserve(m_lowerItems.size() + items.size());
 		for (const auto& item : items) {
-			AddItem(item);
+			m_items.push_back(item);
+			m_lowerItems.push_back(ToLower(item));
+			MeasureItem(item);
 		}
+		m_prefixIndexDirty = true;
+
+		if (!m_filterText.empty()) UpdateFilter(false);
+		RefreshItemsList();
 	}
 
 	void ComboBox::RemoveItem(size_t index) {
 		if (index >= m_items.size()) return;
-		if (m_items.empty() || m_itemLbls.empty()) return;
-
-		const auto lbl = m_itemLbls[index];
-
-		if (lbl == m_lastSelectedLbl) m_lastSelectedLbl = nullptr;
 
 		m_items.erase(m_items.begin() + index);
-		m_itemLbls.erase(m_itemLbls.begin() + index);
-		m_itemsPanel->RemoveChildDeferred(lbl);
-
+		m_lowerItems.erase(m_lowerItems.begin() + index);
+		m_prefixIndexDirty = true;
+		if (!m_filterText.empty()) UpdateFilter(false);
 
-		if (m_itemLbls.empty()) {
-			m_masterItemLbl->SetText("");
-			m_selectedLbl = nullptr;
-			m_lastSelectedLbl = nullptr;
+		if (m_items.empty()) {
+			m_masterItemLbl->SetText(m_filterText);
+			m_hasCurrentItem = false;
 			m_currIndex = 0;
 			m_maxItemsListWidth = 0;
 		}
-		else {
+		else if (m_hasCurrentItem) {
 			if (index == m_currIndex) {
-				if (m_currIndex == m_items.size()) {
-					SetCurrentItem(m_currIndex - 1);
-				}
-				else {
-					SetCurrentItem(m_currIndex);
-				}
-				m_lastSelectedLbl = nullptr;
+				m_hasCurrentItem = false;
+				SetCurrentItem(SDL_min(m_currIndex, m_items.size() - 1));
 			}
 			else if (index < m_currIndex) {
 				m_currIndex--;
 			}
 		}
 
-		// update item lbl position
-		float startY = 0;
-		for (const auto& label : m_itemLbls) {
-			label->SetPositionY(startY);
-			startY += label->GetSize().h;
-		}
-		if (startY < m_maxItemsListHeight) {
-			m_itemLbls.empty() ? m_itemsPanel->SetHeight(m_maxItemsListHeight) : m_itemsPanel->SetHeight(startY);
-		}
+		RefreshItemsList();
 	}
 
 	void ComboBox::RemoveItem(const std::string &item) {
@@ -349,21 +540,22 @@ namespace SimpleGui {
 
 	void ComboBox::ClearItems() {
 		m_items.clear();
-		m_itemLbls.clear();
-		m_itemsPanel->ClearAllChildrenDeferred();
-
-		m_lastHoveredLbl = nullptr;
-		m_hoveringLbl = nullptr;
-		m_lastSelectedLbl = nullptr;
-		m_selectedLbl = nullptr;
+		m_lowerItems.clear();
+		m_prefixIndex.clear();
+		m_filteredItems.clear();
+		m_filterText.clear();
+		m_lowerFilterText.clear();
+		m_prefixIndexDirty = true;
+
+		m_hasCurrentItem = false;
 		m_currIndex = 0;
 		m_maxItemsListWidth = 0;
 		m_masterItemLbl->SetText("");
-		m_itemsPanel->SetHeight(m_maxItemsListHeight);
+		RefreshItemsList();
 	}
 
 	void ComboBox::SetMaxItemsListHeight(float height) {
 		m_maxItemsListHeight = height;
-		m_itemsPanel->SetHeight(m_maxItemsListHeight);
+		RefreshItemsList();
 	}
 }
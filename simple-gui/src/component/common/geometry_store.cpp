@@ -0,0 +1,171 @@
+#include "component/common/geometry_store.hpp"
+#include <algorithm>
+#include "component/base_component.hpp"
+
+
+namespace SimpleGui {
+	uint32_t GeometryStore::Allocate(BaseComponent* owner, uint32_t parent) {
+		auto index = static_cast<uint32_t>(m_flags.size());
+		m_localX.push_back(0);
+		m_localY.push_back(0);
+		m_width.push_back(0);
+		m_height.push_back(0);
+		m_originX.push_back(0);
+		m_originY.push_back(0);
+		m_contentW.push_back(0);
+		m_contentH.push_back(0);
+		m_globalX.push_back(0);
+		m_globalY.push_back(0);
+		m_visibleX.push_back(0);
+		m_visibleY.push_back(0);
+		m_visibleW.push_back(0);
+		m_visibleH.push_back(0);
+		m_flags.push_back(Alive | Visible | Changed);
+		m_parents.push_back(parent);
+		m_owners.push_back(owner);
+		return index;
+	}
+
+	void GeometryStore::Release(uint32_t index) {
+		if (index >= m_flags.size() || !(m_flags[index] & Alive)) return;
+		m_flags[index] = 0;
+		m_owners[index] = nullptr;
+		++m_deadCount;
+	}
+
+	void GeometryStore::SetLocalRect(uint32_t index, const Rect& rect) {
+		m_localX[index] = rect.position.x;
+		m_localY[index] = rect.position.y;
+		m_width[index] = rect.size.w;
+		m_height[index] = rect.size.h;
+		m_flags[index] |= Changed;
+	}
+
+	bool GeometryStore::SetContentRect(uint32_t index, const Vec2& origin, const Vec2& size) {
+		if (m_originX[index] == origin.x && m_originY[index] == origin.y &&
+			m_contentW[index] == size.w && m_contentH[index] == size.h) return false;
+
+		m_originX[index] = origin.x;
+		m_originY[index] = origin.y;
+		m_contentW[index] = size.w;
+		m_contentH[index] = size.h;
+		m_flags[index] |= Changed;
+		return true;
+	}
+
+	void GeometryStore::SetFlag(uint32_t index, Flags flag, bool value) {
+		if (value) m_flags[index] |= flag;
+		else m_flags[index] &= ~flag;
+		m_flags[index] |= Changed;
+	}
+
+	Rect GeometryStore::GetVisibleGlobalRect(uint32_t index) const {
+		return Rect(m_visibleX[index], m_visibleY[index], m_visibleW[index], m_visibleH[index]);
+	}
+
+	void GeometryStore::UpdateVisibleRects() {
+		if (m_deadCount > COMPACT_THRESHOLD && m_deadCount * 2 > m_flags.size()) Compact();
+
+		const size_t count = m_flags.size();
+		for (size_t i = 0; i < count; ++i) {
+			uint8_t flags = m_flags[i];
+			m_flags[i] = flags & ~Changed;
+			if (!(flags & Alive)) continue;
+
+			uint32_t p = m_parents[i];
+			if (p == INVALID_INDEX) {
+				m_globalX[i] = m_localX[i];
+				m_globalY[i] = m_localY[i];
+				m_visibleX[i] = m_localX[i];
+				m_visibleY[i] = m_localY[i];
+				m_visibleW[i] = m_width[i];
+				m_visibleH[i] = m_height[i];
+				continue;
+			}
+
+			float originX = m_globalX[p] + m_originX[p];
+			float originY = m_globalY[p] + m_originY[p];
+			float x = originX + m_localX[i];
+			float y = originY + m_localY[i];
+			m_globalX[i] = x;
+			m_globalY[i] = y;
+
+			// 父组件的可见内容矩形，父组件不可见时为空
+			bool parentShown = (m_flags[p] & (Visible | Hidden)) == Visible;
+			float parentVisible = parentShown ? 1.f : 0.f;
+			float clipL = std::max(originX, m_visibleX[p]);
+			float clipT = std::max(originY, m_visibleY[p]);
+			float clipR = std::min(originX + m_contentW[p], m_visibleX[p] + m_visibleW[p]);
+			float clipB = std::min(originY + m_contentH[p], m_visibleY[p] + m_visibleH[p]);
+			clipR = std::max(clipR, clipL);
+			clipB = std::max(clipB, clipT);
+			clipR = clipL + (clipR - clipL) * parentVisible;
+			clipB = clipT + (clipB - clipT) * parentVisible;
+
+			float l = std::max(clipL, x);
+			float t = std::max(clipT, y);
+			float r = std::min(clipR, x + m_width[i]);
+			float b = std::min(clipB, y + m_height[i]);
+
+			// 与Rect::GetIntersection一致：不相交时为空矩形
+			bool intersect = r >= l && b >= t;
+			m_visibleX[i] = intersect ? l : 0;
+			m_visibleY[i] = intersect ? t : 0;
+			m_visibleW[i] = intersect ? r - l : 0;
+			m_visibleH[i] = intersect ? b - t : 0;
+
+			// 不可见的组件不会更新其子组件，子组件的可见矩形随之为空
+			if (parentShown) m_flags[i] &= ~Hidden;
+			else m_flags[i] |= Hidden;
+		}
+	}
+
+	void GeometryStore::Compact() {
+		std::vector<uint32_t> remap(m_flags.size(), INVALID_INDEX);
+		size_t dst = 0;
+		for (size_t src = 0; src < m_flags.size(); ++src) {
+			if (!(m_flags[src] & Alive)) continue;
+
+			remap[src] = static_cast<uint32_t>(dst);
+			uint32_t parent = m_parents[src];
+			m_localX[dst] = m_localX[src];
+			m_localY[dst] = m_localY[src];
+			m_width[dst] = m_width[src];
+			m_height[dst] = m_height[src];
+			m_originX[dst] = m_originX[src];
+			m_originY[dst] = m_originY[src];
+			m_contentW[dst] = m_contentW[src];
+			m_contentH[dst] = m_contentH[src];
+			m_globalX[dst] = m_globalX[src];
+			m_globalY[dst] = m_globalY[src];
+			m_visibleX[dst] = m_visibleX[src];
+			m_visibleY[dst] = m_visibleY[src];
+			m_visibleW[dst] = m_visibleW[src];
+			m_visibleH[dst] = m_visibleH[src];
+			m_flags[dst] = m_flags[src];
+			m_parents[dst] = parent == INVALID_INDEX ? INVALID_INDEX : remap[parent];
+			m_owners[dst] = m_owners[src];
+			m_owners[dst]->m_geometryIndex = static_cast<uint32_t>(dst);
+			++dst;
+		}
+
+		m_localX.resize(dst);
+		m_localY.resize(dst);
+		m_width.resize(dst);
+		m_height.resize(dst);
+		m_originX.resize(dst);
+		m_originY.resize(dst);
+		m_contentW.resize(dst);
+		m_contentH.resize(dst);
+		m_globalX.resize(dst);
+		m_globalY.resize(dst);
+		m_visibleX.resize(dst);
+		m_visibleY.resize(dst);
+		m_visibleW.resize(dst);
+		m_visibleH.resize(dst);
+		m_flags.resize(dst);
+		m_parents.resize(dst);
+		m_owners.resize(dst);
+		m_deadCount = 0;
+	}
+}
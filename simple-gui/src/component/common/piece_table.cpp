@@ -0,0 +1,173 @@
+#include <algorithm>
+#include "component/common/piece_table.hpp"
+
+
+namespace SimpleGui {
+	PieceTable::PieceTable(std::string_view text) {
+		m_length = 0;
+		SetText(text);
+	}
+
+	std::string PieceTable::GetText() const {
+		std::string text;
+		GetText(0, m_length, text);
+		return text;
+	}
+
+	void PieceTable::GetText(size_t offset, size_t length, std::string& out) const {
+		out.clear();
+		if (offset >= m_length || length == 0) return;
+		length = std::min(length, m_length - offset);
+		out.reserve(length);
+
+		for (size_t i = FindPiece(offset); i < m_pieces.size() && length > 0; ++i) {
+			const auto& piece = m_pieces[i];
+			size_t start = offset - m_pieceOffsets[i];
+			size_t count = std::min(piece.length - start, length);
+			out.append(GetBuffer(piece.buffer), piece.start + start, count);
+			offset += count;
+			length -= count;
+		}
+	}
+
+	void PieceTable::SetText(std::string_view text) {
+		m_original = text;
+		m_add.clear();
+		m_pieces.clear();
+		m_pieceOffsets.clear();
+		m_length = text.length();
+		if (m_length) {
+			m_pieces.emplace_back(BufferType::Original, 0, m_length);
+			m_pieceOffsets.emplace_back(0);
+		}
+
+		m_lineStarts.assign(1, 0);
+		for (size_t i = 0; i < text.length(); ++i) {
+			if (text[i] == '\n') m_lineStarts.emplace_back(i + 1);
+		}
+	}
+
+	void PieceTable::Insert(size_t offset, std::string_view text) {
+		if (text.empty()) return;
+		offset = std::min(offset, m_length);
+
+		size_t addStart = m_add.length();
+		m_add.append(text);
+
+		// 连续输入时直接扩展上一个piece，避免piece数量增长
+		size_t idx = m_pieces.size();
+		bool merged = false;
+		if (offset > 0) {
+			size_t prev = FindPiece(offset - 1);
+			auto& piece = m_pieces[prev];
+			if (piece.buffer == BufferType::Add &&
+				piece.start + piece.length == addStart &&
+				m_pieceOffsets[prev] + piece.length == offset) {
+				piece.length += text.length();
+				idx = prev;
+				merged = true;
+			}
+		}
+
+		if (!merged) {
+			Piece newPiece{ BufferType::Add, addStart, text.length() };
+			idx = FindPiece(offset);
+			if (idx == m_pieces.size()) {
+				m_pieces.emplace_back(newPiece);
+			}
+			else if (m_pieceOffsets[idx] == offset) {
+				m_pieces.insert(m_pieces.begin() + idx, newPiece);
+			}
+			else {
+				// split
+				Piece left = m_pieces[idx];
+				Piece right = left;
+				left.length = offset - m_pieceOffsets[idx];
+				right.start += left.length;
+				right.length -= left.length;
+				m_pieces[idx] = left;
+				m_pieces.insert(m_pieces.begin() + idx + 1, { newPiece, right });
+			}
+		}
+		m_length += text.length();
+		UpdatePieceOffsets(idx);
+
+		// update line index
+		size_t line = GetLineFromOffset(offset);
+		for (size_t i = line + 1; i < m_lineStarts.size(); ++i) {
+			m_lineStarts[i] += text.length();
+		}
+
+		auto it = m_lineStarts.begin() + line + 1;
+		for (size_t i = 0; i < text.length(); ++i) {
+			if (text[i] == '\n') {
+				it = m_lineStarts.insert(it, offset + i + 1) + 1;
+			}
+		}
+	}
+
+	void PieceTable::Erase(size_t offset, size_t length) {
+		if (offset >= m_length || length == 0) return;
+		length = std::min(length, m_length - offset);
+		size_t end = offset + length;
+
+		size_t first = FindPiece(offset);
+		size_t last = first;
+		while (last < m_pieces.size() && m_pieceOffsets[last] < end) ++last;
+
+		Piece pieces[2];
+		size_t count = 0;
+		const auto& firstPiece = m_pieces[first];
+		if (m_pieceOffsets[first] < offset) {
+			pieces[count++] = { firstPiece.buffer, firstPiece.start, offset - m_pieceOffsets[first] };
+		}
+
+		const auto& lastPiece = m_pieces[last - 1];
+		size_t lastEnd = m_pieceOffsets[last - 1] + lastPiece.length;
+		if (lastEnd > end) {
+			size_t cut = end - m_pieceOffsets[last - 1];
+			pieces[count++] = { lastPiece.buffer, lastPiece.start + cut, lastPiece.length - cut };
+		}
+
+		m_pieces.erase(m_pieces.begin() + first, m_pieces.begin() + last);
+		m_pieces.insert(m_pieces.begin() + first, pieces, pieces + count);
+		m_length -= length;
+		UpdatePieceOffsets(first);
+
+		// update line index
+		auto begin = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+		auto it = m_lineStarts.erase(begin, std::upper_bound(begin, m_lineStarts.end(), end));
+		for (; it != m_lineStarts.end(); ++it) {
+			*it -= length;
+		}
+	}
+
+	size_t PieceTable::GetLineLength(size_t line) const {
+		size_t end = line + 1 < m_lineStarts.size() ? m_lineStarts[line + 1] - 1 : m_length;
+		return end - m_lineStarts[line];
+	}
+
+	size_t PieceTable::GetLineFromOffset(size_t offset) const {
+		auto it = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+		return it - m_lineStarts.begin() - 1;
+	}
+
+	void PieceTable::GetLineText(size_t line, std::string& out) const {
+		GetText(m_lineStarts[line], GetLineLength(line), out);
+	}
+
+	size_t PieceTable::FindPiece(size_t offset) const {
+		if (offset >= m_length) return m_pieces.size();
+		auto it = std::upper_bound(m_pieceOffsets.begin(), m_pieceOffsets.end(), offset);
+		return it - m_pieceOffsets.begin() - 1;
+	}
+
+	void PieceTable::UpdatePieceOffsets(size_t fromPiece) {
+		m_pieceOffsets.resize(m_pieces.size());
+		size_t offset = fromPiece ? m_pieceOffsets[fromPiece - 1] + m_pieces[fromPiece - 1].length : 0;
+		for (size_t i = fromPiece; i < m_pieces.size(); ++i) {
+			m_pieceOffsets[i] = offset;
+			offset += m_pieces[i].length;
+		}
+	}
+}
@@ -0,0 +1,86 @@
+#include <bit>
+#include "component/common/row_height_index.hpp"
+
+
+namespace SimpleGui {
+	void RowHeightIndex::Reset(size_t count, float defaultHeight) {
+		m_count = count;
+		m_defaultHeight = defaultHeight;
+		m_totalHeight = static_cast<double>(count) * defaultHeight;
+		m_heights.clear();
+		m_tree.clear();
+	}
+
+	void RowHeightIndex::Reset(std::vector<float> heights, float defaultHeight) {
+		Reset(heights.size(), defaultHeight);
+		m_heights = std::move(heights);
+		m_totalHeight = 0;
+		for (float height : m_heights) {
+			m_totalHeight += height;
+		}
+		BuildTree();
+	}
+
+	float RowHeightIndex::GetHeight(size_t row) const {
+		if (row >= m_count) return 0;
+		return IsUniform() ? m_defaultHeight : m_heights[row];
+	}
+
+	void RowHeightIndex::SetHeight(size_t row, float height) {
+		if (row >= m_count) return;
+		if (IsUniform()) {
+			if (height == m_defaultHeight) return;
+			m_heights.assign(m_count, m_defaultHeight);
+			BuildTree();
+		}
+
+		double delta = static_cast<double>(height) - m_heights[row];
+		m_heights[row] = height;
+		m_totalHeight += delta;
+		for (size_t i = row + 1; i <= m_count; i += i & (~i + 1)) {
+			m_tree[i] += delta;
+		}
+	}
+
+	float RowHeightIndex::GetOffset(size_t row) const {
+		if (row > m_count) row = m_count;
+		if (IsUniform()) return static_cast<float>(static_cast<double>(row) * m_defaultHeight);
+
+		double sum = 0;
+		for (size_t i = row; i > 0; i -= i & (~i + 1)) {
+			sum += m_tree[i];
+		}
+		return static_cast<float>(sum);
+	}
+
+	size_t RowHeightIndex::FindRow(float y) const {
+		if (m_count == 0 || y <= 0) return 0;
+
+		if (IsUniform()) {
+			if (m_defaultHeight <= 0) return 0;
+			size_t row = static_cast<size_t>(y / m_defaultHeight);
+			return row < m_count ? row : m_count - 1;
+		}
+
+		// 在树状数组上二分，找到前缀和不超过y的最大行数
+		size_t pos = 0;
+		double remaining = y;
+		for (size_t step = std::bit_floor(m_count); step > 0; step >>= 1) {
+			size_t next = pos + step;
+			if (next <= m_count && m_tree[next] <= remaining) {
+				pos = next;
+				remaining -= m_tree[next];
+			}
+		}
+		return pos < m_count ? pos : m_count - 1;
+	}
+
+	void RowHeightIndex::BuildTree() {
+		m_tree.assign(m_count + 1, 0);
+		for (size_t i = 1; i <= m_count; ++i) {
+			m_tree[i] += m_heights[i - 1];
+			size_t parent = i + (i & (~i + 1));
+			if (parent <= m_count) m_tree[parent] += m_tree[i];
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#include "component/common/virtual_scrollbar.hpp"
+#include "renderer.hpp"
+#include "event.hpp"
+
+
+namespace SimpleGui {
+	VirtualScrollBar::VirtualScrollBar(Direction direction) :
+		m_direction(direction), m_sliderState(MouseState::Normal),
+		m_offset(0), m_contentLength(0), m_viewLength(0),
+		m_thickness(10), m_minSliderLength(10),
+		m_dragStartMousePos(0), m_dragStartOffset(0), m_dragging(false) {
+	}
+
+	bool VirtualScrollBar::HandleEvent(Event* event) {
+		if (!IsNeeded()) {
+			m_dragging = false;
+			return false;
+		}
+
+		if (auto ev = event->Convert<MouseButtonEvent>()) {
+			if (ev->IsReleased(MouseButton::Left) && m_dragging) {
+				m_dragging = false;
+				m_sliderState = MouseState::Normal;
+				return true;
+			}
+
+			if (!ev->IsPressed(MouseButton::Left) || !m_clipGRect.ContainPoint(ev->GetPosition())) return false;
+			if (m_sliderGRect.ContainPoint(ev->GetPosition())) {
+				m_dragging = true;
+				m_dragStartMousePos = GetAxis(ev->GetPosition());
+				m_dragStartOffset = m_offset;
+				m_sliderState = MouseState::Pressed;
+				return true;
+			}
+
+			// 点击滑槽时翻页
+			if (m_slotGRect.ContainPoint(ev->GetPosition())) {
+				float pos = GetAxis(ev->GetPosition());
+				ScrollBy(pos < GetAxis(m_sliderGRect.position) ? -m_viewLength : m_viewLength);
+				return true;
+			}
+		}
+		else if (auto ev = event->Convert<MouseMotionEvent>()) {
+			if (m_dragging) {
+				float range = GetSlotLength() - GetSliderLength();
+				if (range > 0) {
+					float distance = GetAxis(ev->GetPosition()) - m_dragStartMousePos;
+					SetOffset(m_dragStartOffset + distance / range * GetMaxOffset());
+				}
+				return true;
+			}
+
+			bool hovered = m_clipGRect.ContainPoint(ev->GetPosition()) && m_sliderGRect.ContainPoint(ev->GetPosition());
+			m_sliderState = hovered ? MouseState::Hovering : MouseState::Normal;
+		}
+
+		return false;
+	}
+
+	void VirtualScrollBar::Update(const Rect& slotGRect, const Rect& clipGRect, float contentLength, float viewLength) {
+		m_slotGRect = slotGRect;
+		m_clipGRect = clipGRect.GetIntersection(slotGRect);
+		m_contentLength = contentLength;
+		m_viewLength = viewLength;
+		SetOffset(m_offset);
+
+		m_sliderGRect = m_slotGRect;
+		if (!IsNeeded()) return;
+
+		float slotLength = GetSlotLength();
+		float sliderLength = SDL_max(slotLength * m_viewLength / m_contentLength, m_minSliderLength);
+		sliderLength = SDL_min(sliderLength, slotLength);
+		float sliderPos = (slotLength - sliderLength) * m_offset / GetMaxOffset();
+
+		if (m_direction == Direction::Vertical) {
+			m_sliderGRect.position.y += sliderPos;
+			m_sliderGRect.size.h = sliderLength;
+		}
+		else {
+			m_sliderGRect.position.x += sliderPos;
+			m_sliderGRect.size.w = sliderLength;
+		}
+	}
+
+	void VirtualScrollBar::Render(Renderer& renderer, const Color& slotColor, const Color& sliderColor) const {
+		if (!IsNeeded() || m_clipGRect.size.IsZeroApprox()) return;
+
+		renderer.SetRenderClipRect(m_clipGRect);
+		renderer.RenderRect(m_slotGRect, slotColor, true);
+		renderer.RenderRect(m_sliderGRect, sliderColor, true);
+		renderer.ClearRenderClipRect();
+	}
+}
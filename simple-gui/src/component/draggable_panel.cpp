@@ -94,10 +94,17 @@ namespace SimpleGui {
         SetComponentVisibleGlobalRect(m_titleLbl.get(), visibleRect);
     }
 
+    Rect DraggablePanel::GetOpaqueGlobalRect() {
+        // 皮肤纹理可能有透明部分
+        if (!m_visible || GetThemeSkin(ThemeColorFlags::DraggablePanelBackground)) return {};
+        if (GetThemeColor(ThemeColorFlags::DraggablePanelBackground).a != 255) return {};
+        return m_visibleGRect;
+    }
+
     void DraggablePanel::Render(Renderer &renderer) {
         SG_CMP_RENDER_CONDITIONS;
 
-        renderer.RenderRect(m_visibleGRect, GetThemeColor(ThemeColorFlags::DraggablePanelBackground), true);
+        RenderThemeBackground(renderer, ThemeColorFlags::DraggablePanelBackground);
 
         BaseComponent::Render(renderer);
 
@@ -202,7 +209,9 @@ namespace SimpleGui {
         if (max.x < 0) max.x = min.x;
         if (max.y < 0) max.y = min.y;
 
+        Rect oldRect = GetRect();
         m_position.Clamp(min, max);
+        NotifyGeometryChanged(oldRect);
     }
 
     // TODO 使用焦点系统解决
@@ -210,18 +219,7 @@ namespace SimpleGui {
         if (auto ev = event->Convert<MouseButtonEvent>();
             ev && m_visibleGRect.ContainPoint(ev->GetPosition()) && ev->IsPressed(MouseButton::Left)) {
             if (!m_parent) return false;
-
-            auto &children = GetComponentChildren(m_parent);
-            if (children[children.size() - 1].get() == this) return false;
-
-            auto rit = std::find_if(children.rbegin(), children.rend(),
-                                           [this](auto &child) {
-                                               return child.get() == this;
-                                           });
-            if (rit == children.rend()) return false;
-            auto it = rit.base() - 1;
-            std::rotate(it, it + 1, children.end());
-            return true;
+            return m_parent->MoveChildToTop(this);
         }
 
         return false;
@@ -246,7 +244,7 @@ namespace SimpleGui {
                 m_dragData.dragging = false;
                 m_window->GetRootComponent().SetHandlingComponent(nullptr);
             } else if (event->IsMouseMotionEvent()) {
-                m_position = m_dragData.startData + mousePos - m_dragData.startMousePos;
+                SetPosition(m_dragData.startData + mousePos - m_dragData.startMousePos);
                 dragging.Emit();
             }
             return true;
@@ -288,16 +286,19 @@ namespace SimpleGui {
         if (m_dragData.dragGRect.ContainPoint(mousePos) && m_foldData.toggleGRect.ContainPoint(mousePos)) {
             if (auto ev = event->Convert<MouseButtonEvent>();
                 ev && ev->IsPressed(MouseButton::Left)) {
+                Rect oldRect = GetRect();
                 if (!m_foldData.isFolded) {
                     m_foldData.unfoldSize = m_size;
                     m_foldData.isFolded = true;
                     m_size.h = m_handleThickness;
+                    NotifyGeometryChanged(oldRect);
                     folded.Emit(true);
                     return true;
                 }
 
                 m_foldData.isFolded = false;
                 m_size.h = m_foldData.unfoldSize.h;
+                NotifyGeometryChanged(oldRect);
                 folded.Emit(false);
                 return true;
             }
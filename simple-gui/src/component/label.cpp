@@ -25,6 +25,10 @@ namespace SimpleGui {
 		m_text.shrink_to_fit();
 	}
 
+	void Label::OnFontChanged() {
+		if (m_ttfText) TTF_SetTextFont(m_ttfText.get(), &GetFont().GetTTFFont());
+	}
+
 	void Label::Update() {
 		SG_CMP_UPDATE_CONDITIONS;
 
@@ -69,8 +73,10 @@ namespace SimpleGui {
 		w += m_padding.left + m_padding.right;
 		h += m_padding.top + m_padding.bottom;
 
+		Rect oldRect = GetRect();
 		if (m_size.w < w) m_size.w = w;
 		if (m_size.h < h) m_size.h = h;
+		NotifyGeometryChanged(oldRect);
 
 		SetMinSize(m_size);
 	}
@@ -117,6 +123,9 @@ namespace SimpleGui {
 	}
 
 	void Label::SetText(std::string_view text) {
+		// 文本没有变化时不重新排版，避免每帧设置相同文本时的分配
+		auto ttfText = m_ttfText.get();
+		if (ttfText && ttfText->text && text == ttfText->text) return;
 		TTF_SetTextString(m_ttfText.get(), text.data(), text.size());
 		AdjustSize(m_ttfText.get());
 	}
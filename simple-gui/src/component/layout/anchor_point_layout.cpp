@@ -13,13 +13,18 @@ namespace SimpleGui {
 		PreparationOfUpdateChildren();
 		CalcVisibleGlobalRect(m_parent, this);
 
+		ArrangeIfDirty();
+
+		UpdateChildren(false);
+	}
+
+	void AnchorPointLayout::Arrange() {
 		for (auto& child : m_children) {
 			auto it = m_anchorPoints.find(child.get());
 			if (it != m_anchorPoints.end()) {
 				UpdateAnchorPointLocation(it->first, it->second);
 			}
 			UpdateChildSizeConfigs(child.get());
-			child->Update();
 		}
 	}
 
@@ -36,6 +41,7 @@ namespace SimpleGui {
 	void AnchorPointLayout::SetAnchorPoint(BaseComponent* cmp, const AnchorPoint& point) {
 		if (!HasChild(cmp)) return;
 		m_anchorPoints.insert_or_assign(cmp, point);
+		InvalidateLayout();
 	}
 
 	void AnchorPointLayout::SetAnchorPoint(BaseComponent* cmp, AnchorPointType type, const Vec2& distance,
@@ -7,6 +7,9 @@ namespace SimpleGui {
 	BoxLayout::BoxLayout(Direction direction) : Layout(), m_spacing(0) {
 		m_direction = direction;
 		m_alignment = Alignment::Begin;
+		m_totalFixedLength = 0;
+		m_totalWeight = 0;
+		m_visibleChildrenCount = 0;
 		//m_padding = SG_GuiManager.GetCurrentStyle().componentPadding;
 		//m_spacing = SG_GuiManager.GetCurrentStyle().itemSpacing;
 	}
@@ -16,7 +19,9 @@ namespace SimpleGui {
 	}
 
 	void BoxLayout::SetSpacing(int spacing) {
+		if (m_spacing == spacing) return;
 		m_spacing = spacing;
+		InvalidateLayout();
 	}
 
 	Direction BoxLayout::GetDirection() const {
@@ -24,7 +29,9 @@ namespace SimpleGui {
 	}
 
 	void BoxLayout::SetDirection(Direction direction) {
+		if (m_direction == direction) return;
 		m_direction = direction;
+		InvalidateLayout();
 	}
 
 	Alignment BoxLayout::GetAlignment() const {
@@ -32,7 +39,9 @@ namespace SimpleGui {
 	}
 
 	void BoxLayout::SetAlignment(Alignment alignment) {
+		if (m_alignment == alignment) return;
 		m_alignment = alignment;
+		InvalidateLayout();
 	}
 
 	const std::vector<int>& BoxLayout::GetWeights() const {
@@ -46,6 +55,7 @@ namespace SimpleGui {
 			int weight = i < 0 ? 1 : i;
 			m_weights.push_back(weight);
 		}
+		InvalidateLayout();
 	}
 
 	void BoxLayout::Update() {
@@ -57,65 +67,77 @@ namespace SimpleGui {
 		//SetMinSize(CalcAllChildrenMinSize());
 		//CalcVisibleRect();
 		CalcVisibleGlobalRect(m_parent, this);
-		
-		if (m_direction == Direction::Horizontal) UpdateHorizontalDirection();
-		else UpdateVerticalDirection();
-	}
 
-	void BoxLayout::UpdateHorizontalDirection() const {
-		int count = GetVisibleChildrenCount();
-		if (!count) return;
+		// 只有大小、可见性、权重、间距或子组件发生变化后才重新布局
+		ArrangeIfDirty();
 
-		Rect contentGRect = GetContentGlobalRect();
+		UpdateChildren(false);
+	}
 
-		Vec2 startPos;
-		Vec2 maxChildSize((contentGRect.size.w - (count - 1) * m_spacing) / count, contentGRect.size.h);
+	void BoxLayout::Arrange() {
+		Measure();
+		if (m_direction == Direction::Horizontal) ArrangeHorizontalDirection();
+		else ArrangeVerticalDirection();
+	}
 
-		std::vector<BaseComponent*> fixedSizeComponets;
-		std::vector<BaseComponent*> expandingSizeComponents;
-		float totalFixedWidth = 0.0f;
-		int totalWeight = 0;
+	void BoxLayout::Measure() {
+		m_fixedSizeChildren.clear();
+		m_expandingSizeChildren.clear();
+		m_totalFixedLength = 0;
+		m_totalWeight = 0;
+		m_visibleChildrenCount = 0;
 
 		for (int i = 0; i < m_children.size(); ++i) {
-			if (m_children[i]->IsVisible()) {
-				if (m_children[i]->GetSizeConfigs().first == ComponentSizeConfig::Fixed) {
-					fixedSizeComponets.push_back(m_children[i].get());
-					totalFixedWidth += m_children[i]->GetSize().w;
+			auto child = m_children[i].get();
+			if (child->IsVisible()) {
+				++m_visibleChildrenCount;
+
+				ComponentSizeConfig config = m_direction == Direction::Horizontal ? child->GetSizeConfigs().first : child->GetSizeConfigs().second;
+				if (config == ComponentSizeConfig::Fixed) {
+					m_fixedSizeChildren.push_back(child);
+					m_totalFixedLength += m_direction == Direction::Horizontal ? child->GetSize().w : child->GetSize().h;
 				}
-				else if (m_children[i]->GetSizeConfigs().first == ComponentSizeConfig::Expanding) {
-					expandingSizeComponents.push_back(m_children[i].get());
+				else {
+					m_expandingSizeChildren.push_back(child);
 				}
 			}
 
 			// 若权重数组中的值的数量少于子组件的数量时，缺少指定权重值的组件的权重值设为1
-			totalWeight += (i < m_weights.size() ? (!m_children[i]->IsVisible() ? 0 : m_weights[i]) : 1);
+			m_totalWeight += (i < m_weights.size() ? (!child->IsVisible() ? 0 : m_weights[i]) : 1);
 		}
+	}
+
+	void BoxLayout::ArrangeHorizontalDirection() const {
+		int count = m_visibleChildrenCount;
+		if (!count) return;
+
+		Vec2 contentSize = GetContentSize();
+
+		Vec2 startPos;
+		Vec2 maxChildSize((contentSize.w - (count - 1) * m_spacing) / count, contentSize.h);
 
 		// 更新子组件的位置和大小
 		// 所有子组件x轴方向上的sizeconfig皆为expanding时，权重数组生效
-		if (fixedSizeComponets.empty()) {
+		if (m_fixedSizeChildren.empty()) {
 			// 权重数组为空时，默认所有组件的权重都为1
 			if (m_weights.empty() || (m_weights.size() == 1 && m_weights[0] == 1)) {
-				for (int i = 0; i < expandingSizeComponents.size(); ++i) {
-					auto child = expandingSizeComponents[i];
+				for (int i = 0; i < m_expandingSizeChildren.size(); ++i) {
+					auto child = m_expandingSizeChildren[i];
 					float x = i * (maxChildSize.w + m_spacing);
 					child->SetPosition(x, 0);
 					child->SetSize(maxChildSize);
-
-					child->Update();
 				}
 			}
 			else {
 				float offsetX = 0.0;
-				float totalChildrenWidth = contentGRect.size.w - (count - 1) * m_spacing;
-				for (int i = 0; i < expandingSizeComponents.size(); ++i) {
-					auto child = expandingSizeComponents[i];
-					float w = static_cast<float>(m_weights[i]) / totalWeight * totalChildrenWidth;
+				float totalChildrenWidth = contentSize.w - (count - 1) * m_spacing;
+				for (int i = 0; i < m_expandingSizeChildren.size(); ++i) {
+					auto child = m_expandingSizeChildren[i];
+					int weight = i < m_weights.size() ? m_weights[i] : 1;
+					float w = static_cast<float>(weight) / m_totalWeight * totalChildrenWidth;
 					child->SetPosition(offsetX, 0);
 					child->SetSize(w, maxChildSize.h);
 					offsetX += w + m_spacing;
-
-					child->Update();
 				}
 			}
 		}
@@ -123,16 +145,16 @@ namespace SimpleGui {
 		// 权重无效
 		else {
 			// 没有Expanding，都是Fixed,实现Alignment, 默认为Alignment::Begin
-			if (expandingSizeComponents.empty()) {
+			if (m_expandingSizeChildren.empty()) {
 				if (m_alignment == Alignment::Center) {
-					startPos.x = (contentGRect.size.w - totalFixedWidth - (count - 1) * m_spacing) / 2;
+					startPos.x = (contentSize.w - m_totalFixedLength - (count - 1) * m_spacing) / 2;
 				}
 				else if (m_alignment == Alignment::End) {
-					startPos.x = contentGRect.size.w - totalFixedWidth - (count - 1) * m_spacing;
+					startPos.x = contentSize.w - m_totalFixedLength - (count - 1) * m_spacing;
 				}
 			}
 
-			float expandingWidth = (contentGRect.size.w - totalFixedWidth - (count - 1) * m_spacing) / expandingSizeComponents.size();
+			float expandingWidth = (contentSize.w - m_totalFixedLength - (count - 1) * m_spacing) / m_expandingSizeChildren.size();
 
 			// 更新子组件的矩形数据
 			float offsetX = 0.0;
@@ -152,67 +174,40 @@ namespace SimpleGui {
 
 				child->SetPosition(x, startPos.y);
 				child->SetHeight(maxChildSize.h);
-
-				child->Update();
 			}
 		}
 	}
 
-	void BoxLayout::UpdateVerticalDirection() const {
-		int count = GetVisibleChildrenCount();
+	void BoxLayout::ArrangeVerticalDirection() const {
+		int count = m_visibleChildrenCount;
 		if (!count) return;
 
-		Rect contentGRect = GetContentGlobalRect();
+		Vec2 contentSize = GetContentSize();
 
 		Vec2 startPos;
-		Vec2 maxChildSize(contentGRect.size.w, (contentGRect.size.h - (count - 1) * m_spacing) / count);
-
-		std::vector<BaseComponent*> fixedSizeComponets;
-		std::vector<BaseComponent*> expandingSizeComponents;
-		float totalFixedHeight = 0.0f;
-		int totalWeight = 0;
-
-		for (int i = 0; i < m_children.size(); ++i) {
-
-			if (m_children[i]->IsVisible()) {
-				if (m_children[i]->GetSizeConfigs().second == ComponentSizeConfig::Fixed) {
-					fixedSizeComponets.push_back(m_children[i].get());
-					totalFixedHeight += m_children[i]->GetSize().h;
-				}
-				else if (m_children[i]->GetSizeConfigs().second == ComponentSizeConfig::Expanding) {
-					expandingSizeComponents.push_back(m_children[i].get());
-				}
-			}
-
-			// 若权重数组中的值的数量少于子组件的数量时，缺少指定权重值的组件的权重值设为1
-			totalWeight += (i < m_weights.size() ? (!m_children[i]->IsVisible() ? 0 : m_weights[i]) : 1);
-		}
+		Vec2 maxChildSize(contentSize.w, (contentSize.h - (count - 1) * m_spacing) / count);
 
 		// 更新子组件的位置和大小
 		// 所有子组件y轴方向上的sizeconfig皆为expanding时，权重数组生效
-		if (fixedSizeComponets.empty()) {
+		if (m_fixedSizeChildren.empty()) {
 			// 权重数组为空时，默认所有组件的权重都为1
 			if (m_weights.empty() || (m_weights.size() == 1 && m_weights[0] == 1)) {
-				for (int i = 0; i < expandingSizeComponents.size(); ++i) {
-					auto child = expandingSizeComponents[i];
+				for (int i = 0; i < m_expandingSizeChildren.size(); ++i) {
+					auto child = m_expandingSizeChildren[i];
 					child->SetPosition(0, i * (maxChildSize.h + m_spacing));
 					child->SetSize(maxChildSize);
-
-					child->Update();
 				}
 			}
 			else {
 				float offsetY = 0.0;
-				float totalChildrenHeight = contentGRect.size.h - (count - 1) * m_spacing;
-				for (int i = 0; i < expandingSizeComponents.size(); ++i) {
-					auto child = expandingSizeComponents[i];
-					float h = static_cast<float>(m_weights[i]) / totalWeight * totalChildrenHeight;
-					float y = offsetY;
-					child->SetPosition(0, y);
+				float totalChildrenHeight = contentSize.h - (count - 1) * m_spacing;
+				for (int i = 0; i < m_expandingSizeChildren.size(); ++i) {
+					auto child = m_expandingSizeChildren[i];
+					int weight = i < m_weights.size() ? m_weights[i] : 1;
+					float h = static_cast<float>(weight) / m_totalWeight * totalChildrenHeight;
+					child->SetPosition(0, offsetY);
 					child->SetSize(maxChildSize.w, h);
 					offsetY += h + m_spacing;
-
-					child->Update();
 				}
 			}
 		}
@@ -220,16 +215,16 @@ namespace SimpleGui {
 		// 权重无效
 		else {
 			// 没有Expanding，都是Fixed,实现Alignment
-			if (expandingSizeComponents.empty()) {
+			if (m_expandingSizeChildren.empty()) {
 				if (m_alignment == Alignment::Center) {
-					startPos.y = (contentGRect.size.h - totalFixedHeight - (count - 1) * m_spacing) / 2;
+					startPos.y = (contentSize.h - m_totalFixedLength - (count - 1) * m_spacing) / 2;
 				}
 				else if (m_alignment == Alignment::End) {
-					startPos.y = contentGRect.size.h - totalFixedHeight - (count - 1) * m_spacing;
+					startPos.y = contentSize.h - m_totalFixedLength - (count - 1) * m_spacing;
 				}
 			}
 
-			float expandingHeight = (contentGRect.size.h - totalFixedHeight - (count - 1) * m_spacing) / expandingSizeComponents.size();
+			float expandingHeight = (contentSize.h - m_totalFixedLength - (count - 1) * m_spacing) / m_expandingSizeChildren.size();
 
 			// 更新子组件的矩形数据
 			float offsetY = 0.0;
@@ -239,7 +234,6 @@ namespace SimpleGui {
 
 				if (!child->IsVisible()) continue;
 
-
 				if (child->GetSizeConfigs().second == ComponentSizeConfig::Fixed) {
 					offsetY += child->GetSize().h + m_spacing;
 				}
@@ -250,16 +244,7 @@ namespace SimpleGui {
 
 				child->SetPosition(startPos.x, y);
 				child->SetWidth(maxChildSize.w);
-
-				child->Update();
 			}
 		}
 	}
-
-	int BoxLayout::GetVisibleChildrenCount() const {
-		return std::count_if(m_children.begin(), m_children.end(),
-			[](const auto& cmp) {
-				return cmp->IsVisible();
-			});
-	}
 }
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "component/layout/flex_layout.hpp"
+#include "gui_manager.hpp"
+#include <limits>
+
+
+namespace SimpleGui {
+	static constexpr float FLEX_UNLIMITED = std::numeric_limits<float>::max();
+
+	FlexLayout::FlexLayout(Direction direction) : Layout() {
+		m_direction = direction;
+		m_justify = FlexJustify::Begin;
+		m_alignItems = FlexAlign::Stretch;
+		m_spacing = 0;
+		m_lineSpacing = 0;
+		m_wrap = false;
+	}
+
+	void FlexLayout::Update() {
+		SG_CMP_UPDATE_CONDITIONS;
+
+		PreparationOfUpdateChildren();
+		CalcVisibleGlobalRect(m_parent, this);
+
+		ArrangeIfDirty();
+
+		UpdateChildren(false);
+	}
+
+	void FlexLayout::Arrange() {
+		CollectNodes();
+
+		Vec2 contentSize = GetContentSize();
+		if (auto rects = m_resultCache.Find(contentSize)) {
+			m_rects = *rects;
+		}
+		else {
+			Solve(contentSize);
+			m_resultCache.Store(contentSize, m_rects);
+		}
+
+		ApplyRects();
+	}
+
+	std::unique_ptr<BaseComponent> FlexLayout::RemoveChild(BaseComponent* cmp) {
+		m_items.erase(cmp);
+		return BaseComponent::RemoveChild(cmp);
+	}
+
+	std::unique_ptr<BaseComponent> FlexLayout::RemoveChildDeferred(BaseComponent* cmp) {
+		m_items.erase(cmp);
+		return BaseComponent::RemoveChildDeferred(cmp);
+	}
+
+	void FlexLayout::SetDirection(Direction direction) {
+		if (m_direction == direction) return;
+		m_direction = direction;
+		InvalidateLayout();
+	}
+
+	void FlexLayout::SetWrap(bool wrap) {
+		if (m_wrap == wrap) return;
+		m_wrap = wrap;
+		InvalidateLayout();
+	}
+
+	void FlexLayout::SetJustify(FlexJustify justify) {
+		if (m_justify == justify) return;
+		m_justify = justify;
+		InvalidateLayout();
+	}
+
+	void FlexLayout::SetAlignItems(FlexAlign align) {
+		if (m_alignItems == align) return;
+		m_alignItems = align;
+		InvalidateLayout();
+	}
+
+	void FlexLayout::SetSpacing(float spacing) {
+		if (m_spacing == spacing) return;
+		m_spacing = spacing;
+		InvalidateLayout();
+	}
+
+	void FlexLayout::SetLineSpacing(float spacing) {
+		if (m_lineSpacing == spacing) return;
+		m_lineSpacing = spacing;
+		InvalidateLayout();
+	}
+
+	void FlexLayout::SetFlexItem(BaseComponent* cmp, const FlexItem& item) {
+		if (!HasChild(cmp)) return;
+		m_items.insert_or_assign(cmp, item);
+		InvalidateLayout();
+	}
+
+	const FlexItem* FlexLayout::GetFlexItem(BaseComponent* cmp) const {
+		auto it = m_items.find(cmp);
+		return it != m_items.end() ? &it->second : nullptr;
+	}
+
+	void FlexLayout::CollectNodes() {
+		static const FlexItem defaultItem;
+		bool horizontal = m_direction == Direction::Horizontal;
+
+		m_nodes.clear();
+		m_resultCache.BeginInputs();
+		m_resultCache.AddInput(static_cast<uint64_t>(m_direction));
+		m_resultCache.AddInput(static_cast<uint64_t>(m_justify));
+		m_resultCache.AddInput(static_cast<uint64_t>(m_alignItems));
+		m_resultCache.AddInput(static_cast<uint64_t>(m_wrap));
+		m_resultCache.AddInput(m_spacing);
+		m_resultCache.AddInput(m_lineSpacing);
+
+		for (auto& child : m_children) {
+			if (!child->IsVisible()) continue;
+
+			auto it = m_items.find(child.get());
+			const FlexItem& item = it != m_items.end() ? it->second : defaultItem;
+
+			Vec2 minSize = item.minSize.Max(child->GetMinSize());
+			float minMain = horizontal ? minSize.w : minSize.h;
+			float minCross = horizontal ? minSize.h : minSize.w;
+			float maxMain = horizontal ? item.maxSize.w : item.maxSize.h;
+			float maxCross = horizontal ? item.maxSize.h : item.maxSize.w;
+			maxMain = maxMain < 0 ? FLEX_UNLIMITED : SDL_max(maxMain, minMain);
+			maxCross = maxCross < 0 ? FLEX_UNLIMITED : SDL_max(maxCross, minCross);
+
+			Node node{};
+			node.cmp = child.get();
+			node.basis = item.basis < 0 ? minMain : item.basis;
+			node.grow = SDL_max(item.grow, 0.f);
+			node.shrink = SDL_max(item.shrink, 0.f);
+			node.minMain = minMain;
+			node.maxMain = maxMain;
+			node.minCross = minCross;
+			node.maxCross = maxCross;
+			node.align = item.alignSelf.value_or(m_alignItems);
+			m_nodes.push_back(node);
+
+			m_resultCache.AddInput(node.cmp);
+			m_resultCache.AddInput(node.basis);
+			m_resultCache.AddInput(node.grow);
+			m_resultCache.AddInput(node.shrink);
+			m_resultCache.AddInput(node.minMain);
+			m_resultCache.AddInput(node.maxMain);
+			m_resultCache.AddInput(node.minCross);
+			m_resultCache.AddInput(node.maxCross);
+			m_resultCache.AddInput(static_cast<uint64_t>(node.align));
+		}
+		m_resultCache.EndInputs();
+	}
+
+	void FlexLayout::Solve(const Vec2& contentSize) {
+		bool horizontal = m_direction == Direction::Horizontal;
+		float availableMain = horizontal ? contentSize.w : contentSize.h;
+		float availableCross = horizontal ? contentSize.h : contentSize.w;
+
+		for (auto& node : m_nodes) {
+			node.main = Clamp(node.basis, node.minMain, node.maxMain);
+			node.cross = Clamp(node.minCross, node.minCross, node.maxCross);
+		}
+
+		// 分行
+		m_lines.clear();
+		size_t begin = 0;
+		float lineMain = 0;
+		for (size_t i = 0; i < m_nodes.size(); ++i) {
+			float size = m_nodes[i].main;
+			if (m_wrap && i > begin && lineMain + m_spacing + size > availableMain) {
+				m_lines.push_back({ begin, i, 0 });
+				begin = i;
+				lineMain = size;
+			}
+			else {
+				lineMain += (i > begin ? m_spacing : 0) + size;
+			}
+		}
+		if (begin < m_nodes.size()) m_lines.push_back({ begin, m_nodes.size(), 0 });
+
+		for (auto& line : m_lines) {
+			ResolveFlexibleLengths(line, availableMain);
+
+			// 不换行时唯一的一行占据整个交叉轴
+			line.crossSize = m_wrap ? 0 : availableCross;
+			for (size_t i = line.begin; i < line.end; ++i) {
+				line.crossSize = SDL_max(line.crossSize, m_nodes[i].cross);
+			}
+		}
+
+		// 计算位置
+		m_rects.resize(m_nodes.size());
+		float crossOffset = 0;
+		for (const auto& line : m_lines) {
+			size_t count = line.end - line.begin;
+			float used = m_spacing * (count - 1);
+			for (size_t i = line.begin; i < line.end; ++i) used += m_nodes[i].main;
+
+			float freeSpace = availableMain - used;
+			float offset = 0;
+			float spacing = m_spacing;
+			if (m_justify == FlexJustify::Center) {
+				offset = freeSpace / 2;
+			}
+			else if (m_justify == FlexJustify::End) {
+				offset = freeSpace;
+			}
+			else if (m_justify == FlexJustify::SpaceBetween && freeSpace > 0 && count > 1) {
+				spacing += freeSpace / (count - 1);
+			}
+			else if (m_justify == FlexJustify::SpaceAround && freeSpace > 0) {
+				spacing += freeSpace / count;
+				offset = freeSpace / count / 2;
+			}
+
+			for (size_t i = line.begin; i < line.end; ++i) {
+				auto& node = m_nodes[i];
+				float cross = node.cross;
+				float crossPos = 0;
+				if (node.align == FlexAlign::Stretch) cross = Clamp(line.crossSize, node.minCross, node.maxCross);
+				else if (node.align == FlexAlign::Center) crossPos = (line.crossSize - cross) / 2;
+				else if (node.align == FlexAlign::End) crossPos = line.crossSize - cross;
+
+				if (horizontal) m_rects[i] = Rect(offset, crossOffset + crossPos, node.main, cross);
+				else m_rects[i] = Rect(crossOffset + crossPos, offset, cross, node.main);
+				offset += node.main + spacing;
+			}
+
+			crossOffset += line.crossSize + m_lineSpacing;
+		}
+	}
+
+	void FlexLayout::ResolveFlexibleLengths(const Line& line, float availableMain) {
+		float gaps = m_spacing * (line.end - line.begin - 1);
+		float hypothetical = gaps;
+		for (size_t i = line.begin; i < line.end; ++i) hypothetical += m_nodes[i].main;
+
+		bool growing = hypothetical < availableMain;
+		for (size_t i = line.begin; i < line.end; ++i) {
+			auto& node = m_nodes[i];
+			node.frozen = growing ? node.grow <= 0 : node.shrink <= 0 || node.basis <= 0;
+		}
+
+		// 每轮按比例分配剩余空间，超出最小/最大限制的节点被冻结后重新分配，最多进行节点数量轮
+		for (size_t round = line.begin; round < line.end; ++round) {
+			float freeSpace = availableMain - gaps;
+			float factorSum = 0;
+			for (size_t i = line.begin; i < line.end; ++i) {
+				const auto& node = m_nodes[i];
+				freeSpace -= node.frozen ? node.main : node.basis;
+				if (!node.frozen) factorSum += growing ? node.grow : node.shrink * node.basis;
+			}
+			if (factorSum <= 0) break;
+
+			auto target = [&](const Node& node) {
+				float factor = growing ? node.grow : node.shrink * node.basis;
+				return node.basis + freeSpace * factor / factorSum;
+				};
+
+			float violation = 0;
+			for (size_t i = line.begin; i < line.end; ++i) {
+				auto& node = m_nodes[i];
+				if (node.frozen) continue;
+				float size = target(node);
+				node.main = Clamp(size, node.minMain, node.maxMain);
+				violation += node.main - size;
+			}
+			if (IsZeroApprox(violation)) break;
+
+			// 总量偏大时冻结受最小限制的节点，偏小时冻结受最大限制的节点
+			bool anyFrozen = false;
+			for (size_t i = line.begin; i < line.end; ++i) {
+				auto& node = m_nodes[i];
+				if (node.frozen) continue;
+				float size = target(node);
+				if (violation > 0 ? node.main > size : node.main < size) {
+					node.frozen = true;
+					anyFrozen = true;
+				}
+			}
+			if (!anyFrozen) break;
+		}
+	}
+
+	void FlexLayout::ApplyRects() {
+		for (size_t i = 0; i < m_nodes.size(); ++i) {
+			m_nodes[i].cmp->SetPosition(m_rects[i].position);
+			m_nodes[i].cmp->SetSize(m_rects[i].size);
+		}
+	}
+}
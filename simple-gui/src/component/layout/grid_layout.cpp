@@ -0,0 +1,324 @@
+#include "component/layout/grid_layout.hpp"
+#include "gui_manager.hpp"
+#include <limits>
+
+
+namespace SimpleGui {
+	static constexpr float GRID_UNLIMITED = std::numeric_limits<float>::max();
+
+	GridLayout::GridLayout(int columnCount) : Layout() {
+		m_implicitRow.type = GridTrackType::Auto;
+		m_rowCount = 0;
+		SetColumnCount(columnCount);
+	}
+
+	void GridLayout::Update() {
+		SG_CMP_UPDATE_CONDITIONS;
+
+		PreparationOfUpdateChildren();
+		CalcVisibleGlobalRect(m_parent, this);
+
+		ArrangeIfDirty();
+
+		UpdateChildren(false);
+	}
+
+	void GridLayout::Arrange() {
+		CollectNodes();
+
+		Vec2 contentSize = GetContentSize();
+		if (auto rects = m_resultCache.Find(contentSize)) {
+			m_rects = *rects;
+		}
+		else {
+			Solve(contentSize);
+			m_resultCache.Store(contentSize, m_rects);
+		}
+
+		ApplyRects();
+	}
+
+	std::unique_ptr<BaseComponent> GridLayout::RemoveChild(BaseComponent* cmp) {
+		m_items.erase(cmp);
+		return BaseComponent::RemoveChild(cmp);
+	}
+
+	std::unique_ptr<BaseComponent> GridLayout::RemoveChildDeferred(BaseComponent* cmp) {
+		m_items.erase(cmp);
+		return BaseComponent::RemoveChildDeferred(cmp);
+	}
+
+	void GridLayout::SetColumns(const std::vector<GridTrack>& columns) {
+		m_columns = columns;
+		if (m_columns.empty()) m_columns.emplace_back();
+		InvalidateLayout();
+	}
+
+	void GridLayout::SetColumnCount(int count) {
+		m_columns.assign(SDL_max(count, 1), GridTrack());
+		InvalidateLayout();
+	}
+
+	void GridLayout::SetRows(const std::vector<GridTrack>& rows) {
+		m_rows = rows;
+		InvalidateLayout();
+	}
+
+	void GridLayout::SetImplicitRow(const GridTrack& track) {
+		m_implicitRow = track;
+		InvalidateLayout();
+	}
+
+	void GridLayout::SetSpacing(float h, float v) {
+		m_spacing = Vec2(h, v);
+		InvalidateLayout();
+	}
+
+	void GridLayout::SetGridItem(BaseComponent* cmp, const GridItem& item) {
+		if (!HasChild(cmp)) return;
+		m_items.insert_or_assign(cmp, item);
+		InvalidateLayout();
+	}
+
+	void GridLayout::SetGridItem(BaseComponent* cmp, int row, int column, int rowSpan, int columnSpan) {
+		GridItem item;
+		item.row = row;
+		item.column = column;
+		item.rowSpan = rowSpan;
+		item.columnSpan = columnSpan;
+		SetGridItem(cmp, item);
+	}
+
+	const GridItem* GridLayout::GetGridItem(BaseComponent* cmp) const {
+		auto it = m_items.find(cmp);
+		return it != m_items.end() ? &it->second : nullptr;
+	}
+
+	void GridLayout::CollectNodes() {
+		static const GridItem defaultItem;
+
+		m_nodes.clear();
+		for (auto& child : m_children) {
+			if (!child->IsVisible()) continue;
+
+			auto it = m_items.find(child.get());
+			const GridItem& item = it != m_items.end() ? it->second : defaultItem;
+
+			Node node{};
+			node.cmp = child.get();
+			node.minSize = child->GetMinSize();
+			node.row = item.row;
+			node.column = item.column;
+			node.rowSpan = SDL_max(item.rowSpan, 1);
+			node.columnSpan = SDL_max(item.columnSpan, 1);
+			node.alignH = item.alignH;
+			node.alignV = item.alignV;
+			m_nodes.push_back(node);
+		}
+
+		PlaceNodes();
+
+		m_resultCache.BeginInputs();
+		m_resultCache.AddInput(m_spacing.x);
+		m_resultCache.AddInput(m_spacing.y);
+		for (size_t i = 0; i < m_columns.size() + m_rows.size() + 1; ++i) {
+			const GridTrack& track = i < m_columns.size() ? m_columns[i] :
+				(i - m_columns.size() < m_rows.size() ? m_rows[i - m_columns.size()] : m_implicitRow);
+			m_resultCache.AddInput(static_cast<uint64_t>(track.type));
+			m_resultCache.AddInput(track.value);
+			m_resultCache.AddInput(track.minSize);
+			m_resultCache.AddInput(track.maxSize);
+		}
+		for (const auto& node : m_nodes) {
+			m_resultCache.AddInput(node.cmp);
+			m_resultCache.AddInput(node.minSize.w);
+			m_resultCache.AddInput(node.minSize.h);
+			m_resultCache.AddInput(static_cast<uint64_t>(node.row) << 32 | static_cast<uint32_t>(node.column));
+			m_resultCache.AddInput(static_cast<uint64_t>(node.rowSpan) << 32 | static_cast<uint32_t>(node.columnSpan));
+			m_resultCache.AddInput(static_cast<uint64_t>(node.alignH) << 8 | static_cast<uint64_t>(node.alignV));
+		}
+		m_resultCache.EndInputs();
+	}
+
+	void GridLayout::PlaceNodes() {
+		int columnCount = static_cast<int>(m_columns.size());
+		m_occupied.clear();
+		m_rowCount = 0;
+
+		for (auto& node : m_nodes) {
+			node.columnSpan = SDL_min(node.columnSpan, columnCount);
+			if (node.row < 0 && node.column < 0) continue;
+
+			node.row = SDL_max(node.row, 0);
+			node.column = SDL_min(SDL_max(node.column, 0), columnCount - node.columnSpan);
+			OccupyArea(node.row, node.column, node.rowSpan, node.columnSpan);
+		}
+
+		// 按行优先顺序放置剩余组件，光标只向前移动
+		int cursorRow = 0;
+		int cursorColumn = 0;
+		for (auto& node : m_nodes) {
+			if (node.row >= 0) continue;
+
+			while (true) {
+				if (cursorColumn + node.columnSpan > columnCount) {
+					cursorColumn = 0;
+					++cursorRow;
+					continue;
+				}
+				if (IsAreaFree(cursorRow, cursorColumn, node.rowSpan, node.columnSpan)) break;
+				++cursorColumn;
+			}
+
+			node.row = cursorRow;
+			node.column = cursorColumn;
+			OccupyArea(node.row, node.column, node.rowSpan, node.columnSpan);
+			cursorColumn += node.columnSpan;
+		}
+	}
+
+	bool GridLayout::IsAreaFree(int row, int column, int rowSpan, int columnSpan) const {
+		size_t columnCount = m_columns.size();
+		for (int r = row; r < row + rowSpan && r < static_cast<int>(m_rowCount); ++r) {
+			for (int c = column; c < column + columnSpan; ++c) {
+				if (m_occupied[r * columnCount + c]) return false;
+			}
+		}
+		return true;
+	}
+
+	void GridLayout::OccupyArea(int row, int column, int rowSpan, int columnSpan) {
+		size_t columnCount = m_columns.size();
+		if (row + rowSpan > static_cast<int>(m_rowCount)) {
+			m_rowCount = row + rowSpan;
+			m_occupied.resize(m_rowCount * columnCount, 0);
+		}
+
+		for (int r = row; r < row + rowSpan; ++r) {
+			for (int c = column; c < column + columnSpan; ++c) {
+				m_occupied[r * columnCount + c] = 1;
+			}
+		}
+	}
+
+	const GridTrack& GridLayout::GetTrack(bool columns, size_t index) const {
+		if (columns) return m_columns[index];
+		return index < m_rows.size() ? m_rows[index] : m_implicitRow;
+	}
+
+	void GridLayout::Solve(const Vec2& contentSize) {
+		SolveTracks(true, contentSize.w);
+		SolveTracks(false, contentSize.h);
+
+		const auto& columns = m_columnSizes;
+		const auto& rows = m_rowSizes;
+		m_rects.resize(m_nodes.size());
+		for (size_t i = 0; i < m_nodes.size(); ++i) {
+			const auto& node = m_nodes[i];
+			int lastColumn = node.column + node.columnSpan - 1;
+			int lastRow = node.row + node.rowSpan - 1;
+
+			Rect cell;
+			cell.position = Vec2(columns.offsets[node.column], rows.offsets[node.row]);
+			cell.size = Vec2(columns.offsets[lastColumn] + columns.sizes[lastColumn] - cell.position.x,
+				rows.offsets[lastRow] + rows.sizes[lastRow] - cell.position.y);
+
+			Rect rect = cell;
+			if (node.alignH != FlexAlign::Stretch) {
+				rect.size.w = node.minSize.w;
+				if (node.alignH == FlexAlign::Center) rect.position.x += (cell.size.w - rect.size.w) / 2;
+				else if (node.alignH == FlexAlign::End) rect.position.x += cell.size.w - rect.size.w;
+			}
+			if (node.alignV != FlexAlign::Stretch) {
+				rect.size.h = node.minSize.h;
+				if (node.alignV == FlexAlign::Center) rect.position.y += (cell.size.h - rect.size.h) / 2;
+				else if (node.alignV == FlexAlign::End) rect.position.y += cell.size.h - rect.size.h;
+			}
+			m_rects[i] = rect;
+		}
+	}
+
+	void GridLayout::SolveTracks(bool columns, float available) {
+		auto& tracks = columns ? m_columnSizes : m_rowSizes;
+		size_t count = columns ? m_columns.size() : m_rowCount;
+		float spacing = columns ? m_spacing.x : m_spacing.y;
+
+		tracks.sizes.assign(count, 0);
+		tracks.offsets.assign(count, 0);
+		tracks.contentMinSizes.assign(count, 0);
+		if (!count) return;
+
+		// 只占一个轨道的组件决定轨道的内容大小
+		for (const auto& node : m_nodes) {
+			int span = columns ? node.columnSpan : node.rowSpan;
+			if (span != 1) continue;
+			int index = columns ? node.column : node.row;
+			float minSize = columns ? node.minSize.w : node.minSize.h;
+			tracks.contentMinSizes[index] = SDL_max(tracks.contentMinSizes[index], minSize);
+		}
+
+		float usedSize = spacing * (count - 1);
+		float totalFraction = 0;
+		for (size_t i = 0; i < count; ++i) {
+			const GridTrack& track = GetTrack(columns, i);
+			float maxSize = track.maxSize < 0 ? GRID_UNLIMITED : SDL_max(track.maxSize, track.minSize);
+			if (track.type == GridTrackType::Fixed) {
+				tracks.sizes[i] = Clamp(track.value, track.minSize, maxSize);
+			}
+			else if (track.type == GridTrackType::Auto) {
+				tracks.sizes[i] = Clamp(tracks.contentMinSizes[i], track.minSize, maxSize);
+			}
+			else {
+				totalFraction += SDL_max(track.value, 0.f);
+				continue;
+			}
+			usedSize += tracks.sizes[i];
+		}
+
+		// 跨越多个轨道的组件放不下时，不足的部分平均分给所跨的Auto轨道
+		for (const auto& node : m_nodes) {
+			int span = columns ? node.columnSpan : node.rowSpan;
+			if (span == 1) continue;
+			int first = columns ? node.column : node.row;
+			float minSize = columns ? node.minSize.w : node.minSize.h;
+
+			float spannedSize = spacing * (span - 1);
+			int autoCount = 0;
+			for (int i = first; i < first + span; ++i) {
+				spannedSize += tracks.sizes[i];
+				if (GetTrack(columns, i).type == GridTrackType::Auto) ++autoCount;
+			}
+			if (minSize <= spannedSize || !autoCount) continue;
+
+			float extra = (minSize - spannedSize) / autoCount;
+			for (int i = first; i < first + span; ++i) {
+				if (GetTrack(columns, i).type == GridTrackType::Auto) tracks.sizes[i] += extra;
+			}
+			usedSize += minSize - spannedSize;
+		}
+
+		// 剩余空间按比例分配给Fraction轨道
+		float remaining = available - usedSize;
+		float unit = totalFraction > 0 && remaining > 0 ? remaining / totalFraction : 0;
+		for (size_t i = 0; i < count; ++i) {
+			const GridTrack& track = GetTrack(columns, i);
+			if (track.type != GridTrackType::Fraction) continue;
+			float minSize = SDL_max(track.minSize, tracks.contentMinSizes[i]);
+			float maxSize = track.maxSize < 0 ? GRID_UNLIMITED : SDL_max(track.maxSize, minSize);
+			tracks.sizes[i] = Clamp(SDL_max(track.value, 0.f) * unit, minSize, maxSize);
+		}
+
+		float offset = 0;
+		for (size_t i = 0; i < count; ++i) {
+			tracks.offsets[i] = offset;
+			offset += tracks.sizes[i] + spacing;
+		}
+	}
+
+	void GridLayout::ApplyRects() {
+		for (size_t i = 0; i < m_nodes.size(); ++i) {
+			m_nodes[i].cmp->SetPosition(m_rects[i].position);
+			m_nodes[i].cmp->SetSize(m_rects[i].size);
+		}
+	}
+}
@@ -3,6 +3,7 @@
 #include "component/line_edit.hpp"
 #include "component/common/utils.hpp"
 #include "gui_manager.hpp"
+#include "logger.hpp"
 
 
 namespace SimpleGui {
@@ -280,8 +281,6 @@ namespace SimpleGui {
 			m_caretIndex += inputText.length();
 			m_caret.SetVisible(true);
 
-			SDL_Log("length of input text = %d", inputText.length());
-
 			//m_string.insert(m_textCaches[m_caretIndex].totalBytes, inputText);
 			//size_t oldLen = m_textCaches.size();
 			//UpdateTextCaches();
@@ -0,0 +1,253 @@
+#include "component/list_view.hpp"
+#include "gui_manager.hpp"
+
+
+namespace SimpleGui {
+	ListView::ListView() : m_vScrollBar(Direction::Vertical) {
+		m_firstRow = 0;
+		m_defaultRowHeight = 0;
+		m_overscan = 2;
+		m_rowsDirty = true;
+	}
+
+	void ListView::EnteredComponentTree() {
+		BaseComponent::EnteredComponentTree();
+
+		m_padding = m_window->GetCurrentStyle()->componentPadding;
+		if (m_defaultRowHeight <= 0) {
+			SetDefaultRowHeight(GetFont().GetHeight() + m_padding.top + m_padding.bottom);
+		}
+		SetMinSize(m_vScrollBar.GetThickness() + m_padding.left + m_padding.right, m_defaultRowHeight);
+		SetSize(200, 300);
+	}
+
+	Vec2 ListView::GetContentSize() const {
+		Vec2 size = BaseComponent::GetContentSize();
+		if (m_heightIndex.GetTotalHeight() > size.h) {
+			size.w = SDL_max(size.w - m_vScrollBar.GetThickness(), 0.f);
+		}
+		return size;
+	}
+
+	void ListView::SetModel(std::shared_ptr<ListViewModel> model) {
+		m_model = std::move(model);
+		ResetModel();
+	}
+
+	void ListView::SetDelegate(std::unique_ptr<ListViewDelegate> delegate) {
+		// 行组件由旧的delegate创建，全部移除
+		for (auto cmp : m_rowCmps) {
+			RemoveChild(cmp);
+		}
+		for (auto cmp : m_freeRowCmps) {
+			RemoveChild(cmp);
+		}
+		m_rowCmps.clear();
+		m_freeRowCmps.clear();
+
+		m_delegate = std::move(delegate);
+		m_rowsDirty = true;
+	}
+
+	void ListView::SetDefaultRowHeight(float height) {
+		m_defaultRowHeight = height;
+		ResetModel();
+	}
+
+	void ListView::ResetModel() {
+		size_t count = m_model ? m_model->GetRowCount() : 0;
+		if (m_model && !m_model->HasFixedRowHeight()) {
+			std::vector<float> heights(count);
+			for (size_t row = 0; row < count; ++row) {
+				float height = m_model->GetRowHeight(row);
+				heights[row] = height > 0 ? height : m_defaultRowHeight;
+			}
+			m_heightIndex.Reset(std::move(heights), m_defaultRowHeight);
+		}
+		else {
+			m_heightIndex.Reset(count, m_defaultRowHeight);
+		}
+		m_rowsDirty = true;
+	}
+
+	void ListView::UpdateRows(size_t first, size_t count) {
+		if (!m_delegate) return;
+
+		for (size_t i = 0; i < m_rowCmps.size(); ++i) {
+			size_t row = m_firstRow + i;
+			if (row >= first && row - first < count) {
+				m_delegate->BindRowComponent(m_rowCmps[i], row);
+			}
+		}
+	}
+
+	void ListView::UpdateRowHeight(size_t row) {
+		if (!m_model || row >= m_heightIndex.GetCount()) return;
+		float height = m_model->GetRowHeight(row);
+		m_heightIndex.SetHeight(row, height > 0 ? height : m_defaultRowHeight);
+	}
+
+	size_t ListView::GetRowAtPosition(const Vec2& globalPos) const {
+		Rect contentGRect = GetContentGlobalRect();
+		if (!contentGRect.ContainPoint(globalPos) || !m_visibleGRect.ContainPoint(globalPos)) return INVALID_ROW;
+
+		float y = globalPos.y - contentGRect.Top() + m_vScrollBar.GetOffset();
+		if (y >= m_heightIndex.GetTotalHeight()) return INVALID_ROW;
+		return m_heightIndex.FindRow(y);
+	}
+
+	Rect ListView::GetRowGlobalRect(size_t row) const {
+		if (row >= m_heightIndex.GetCount()) return {};
+		Rect contentGRect = GetContentGlobalRect();
+		return Rect(contentGRect.Left(), contentGRect.Top() + m_heightIndex.GetOffset(row) - m_vScrollBar.GetOffset(),
+			contentGRect.size.w, m_heightIndex.GetHeight(row));
+	}
+
+	BaseComponent* ListView::GetRowComponent(size_t row) const {
+		if (row < m_firstRow || row - m_firstRow >= m_rowCmps.size()) return nullptr;
+		return m_rowCmps[row - m_firstRow];
+	}
+
+	void ListView::ScrollToRow(size_t row) {
+		if (row >= m_heightIndex.GetCount()) return;
+
+		float top = m_heightIndex.GetOffset(row);
+		float bottom = top + m_heightIndex.GetHeight(row);
+		float viewH = GetContentSize().h;
+		float offset = m_vScrollBar.GetOffset();
+		if (top < offset) offset = top;
+		else if (bottom > offset + viewH) offset = bottom - viewH;
+
+		float maxOffset = SDL_max(m_heightIndex.GetTotalHeight() - viewH, 0.f);
+		m_vScrollBar.SetOffset(Clamp(offset, 0, maxOffset));
+	}
+
+	bool ListView::HandleEvent(Event* event) {
+		SG_CMP_HANDLE_EVENT_CONDITIONS_FALSE;
+
+		if (m_vScrollBar.HandleEvent(event)) return true;
+		if (BaseComponent::HandleEvent(event)) return true;
+
+		if (auto ev = event->Convert<MouseWheelEvent>()) {
+			if (m_visibleGRect.ContainPoint(ev->GetPosition())) {
+				m_vScrollBar.ScrollBy(-ev->GetDirection().y * m_defaultRowHeight * 3);
+				return true;
+			}
+		}
+		else if (auto ev = event->Convert<MouseButtonEvent>();
+			ev && ev->IsPressed(MouseButton::Left)) {
+			size_t row = GetRowAtPosition(ev->GetPosition());
+			if (row != INVALID_ROW) {
+				rowClicked.Emit(row);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ListView::Update() {
+		SG_CMP_UPDATE_CONDITIONS;
+
+		UpdateVisibleRows();
+		BaseComponent::Update();
+
+		// update scrollbar
+		Rect gRect = GetGlobalRect();
+		float thickness = m_vScrollBar.GetThickness();
+		m_vScrollBar.Update(Rect(gRect.Right() - thickness, gRect.Top(), thickness, gRect.size.h),
+			m_visibleGRect, m_heightIndex.GetTotalHeight(), GetContentSize().h);
+	}
+
+	void ListView::Render(Renderer& renderer) {
+		SG_CMP_RENDER_CONDITIONS;
+
+		// draw bg
+		renderer.RenderRect(m_visibleGRect, GetThemeColor(ThemeColorFlags::ListViewBackground), true);
+
+		// draw rows
+		BaseComponent::Render(renderer);
+
+		// draw scrollbar
+		Color sliderColor = GetThemeColor(ThemeColorFlags::ScrollbarSlider_V);
+		if (m_vScrollBar.GetSliderState() == MouseState::Hovering) sliderColor = GetThemeColor(ThemeColorFlags::ScrollbarSliderHovered_V);
+		else if (m_vScrollBar.GetSliderState() == MouseState::Pressed) sliderColor = GetThemeColor(ThemeColorFlags::ScrollbarSliderPressed_V);
+		m_vScrollBar.Render(renderer, GetThemeColor(ThemeColorFlags::ScrollbarSlot_V), sliderColor);
+
+		// draw border
+		renderer.SetRenderClipRect(m_visibleGRect);
+		renderer.RenderRect(GetGlobalRect(), GetThemeColor(ThemeColorFlags::ListViewBorder), false);
+		renderer.ClearRenderClipRect();
+	}
+
+	void ListView::UpdateVisibleRows() {
+		if (!m_delegate) return;
+
+		size_t count = m_heightIndex.GetCount();
+		Vec2 contentSize = GetContentSize();
+		float maxOffset = SDL_max(m_heightIndex.GetTotalHeight() - contentSize.h, 0.f);
+		float offset = Clamp(m_vScrollBar.GetOffset(), 0, maxOffset);
+
+		// 可见行范围 [first, last)
+		size_t first = 0;
+		size_t last = 0;
+		if (count) {
+			first = m_heightIndex.FindRow(offset);
+			last = m_heightIndex.FindRow(offset + contentSize.h) + 1;
+			first = first > m_overscan ? first - m_overscan : 0;
+			last = SDL_min(last + m_overscan, count);
+		}
+
+		// recycle row components
+		if (m_rowsDirty || first != m_firstRow || last != m_firstRow + m_rowCmps.size()) {
+			m_rowCmpsCache.clear();
+			for (size_t i = 0; i < m_rowCmps.size(); ++i) {
+				size_t row = m_firstRow + i;
+				if (m_rowsDirty || row < first || row >= last) ReleaseRowComponent(m_rowCmps[i]);
+			}
+
+			for (size_t row = first; row < last; ++row) {
+				if (!m_rowsDirty && row >= m_firstRow && row - m_firstRow < m_rowCmps.size()) {
+					m_rowCmpsCache.push_back(m_rowCmps[row - m_firstRow]);
+					continue;
+				}
+
+				auto cmp = AcquireRowComponent();
+				m_delegate->BindRowComponent(cmp, row);
+				m_rowCmpsCache.push_back(cmp);
+			}
+
+			std::swap(m_rowCmps, m_rowCmpsCache);
+			m_firstRow = first;
+			m_rowsDirty = false;
+		}
+
+		// layout row components
+		float y = m_heightIndex.GetOffset(first) - offset;
+		for (size_t i = 0; i < m_rowCmps.size(); ++i) {
+			float height = m_heightIndex.GetHeight(first + i);
+			m_rowCmps[i]->SetPosition(0, y);
+			m_rowCmps[i]->SetSize(contentSize.w, height);
+			y += height;
+		}
+	}
+
+	void ListView::ReleaseRowComponent(BaseComponent* cmp) {
+		cmp->SetVisible(false);
+		m_freeRowCmps.push_back(cmp);
+	}
+
+	BaseComponent* ListView::AcquireRowComponent() {
+		if (!m_freeRowCmps.empty()) {
+			auto cmp = m_freeRowCmps.back();
+			m_freeRowCmps.pop_back();
+			cmp->SetVisible(true);
+			return cmp;
+		}
+
+		auto cmp = m_delegate->CreateRowComponent();
+		auto ptr = cmp.get();
+		AddChild(std::move(cmp));
+		return ptr;
+	}
+}
@@ -176,7 +176,10 @@ namespace SimpleGui {
 	void ProgressBar::SetValue(float value) {
 		Range::SetValue(value);
 
-		m_progressLbl->SetText(std::format("{}%", 
-			static_cast<int>(GetValueToMinValueInterval() / GetInterval() * 100)));
+		// 格式化到栈上的缓冲区，拖动进度时不产生堆分配
+		char text[16];
+		auto result = std::format_to_n(text, sizeof(text), "{}%",
+			static_cast<int>(GetValueToMinValueInterval() / GetInterval() * 100));
+		m_progressLbl->SetText(std::string_view(text, result.out - text));
 	}
 }
\ No newline at end of file
@@ -7,6 +7,7 @@ namespace SimpleGui {
 		m_window = window;
 		m_padding = m_window->GetCurrentStyle()->componentPadding;
 		SetSizeToFillWindow();
+		RegisterGeometry(&m_window->GetGeometryStore(), GeometryStore::INVALID_INDEX);
 	}
 
 	void RootComponent::SetSizeToFillWindow() {
@@ -25,12 +26,97 @@ namespace SimpleGui {
 
 	void RootComponent::Update() {
 		SG_CMP_UPDATE_CONDITIONS;
+		PreparationOfUpdateChildren();
+		UpdateSubtreesParallel();
 		BaseComponent::Update();
+
+		// 所有组件更新完毕，一次性计算整棵树的可见矩形，供下一帧直接使用
+		m_geometryStore->UpdateVisibleRects();
+	}
+
+	void RootComponent::UpdateSubtreesParallel() {
+		m_parallelSubtrees.clear();
+		for (auto& child : m_children) {
+			if (child && child->IsVisible() && child->IsParallelUpdateEnabled()) m_parallelSubtrees.push_back(child.get());
+		}
+		if (m_parallelSubtrees.empty()) return;
+
+		// 顶层子树之间没有依赖，各自的布局排列在工作线程中完成，之后主线程的Update不再重新排列
+		SG_GuiManager.GetJobSystem().ParallelFor(m_parallelSubtrees.size(),
+			[this](size_t i) { UpdateLayoutParallel(m_parallelSubtrees[i]); });
 	}
 
 	void RootComponent::Render(Renderer& renderer) {
 		SG_CMP_RENDER_CONDITIONS;
 		renderer.RenderRect(m_visibleGRect, GetThemeColor(ThemeColorFlags::Background), true);
-		BaseComponent::Render(renderer);
+		RenderToolTipAndExtendedFunctions(renderer);
+
+		CollectOccludedChildren();
+		for (size_t i = 0; i < m_children.size(); ++i) {
+			auto& child = m_children[i];
+			if (!child || child->IsCulled()) continue;
+			if (!m_occludedChildren[i]) {
+				child->Render(renderer);
+				continue;
+			}
+
+			// 被遮挡的子组件只记录其他层的内容（提示框、弹出框等）
+			size_t mutedCommands = renderer.GetFrameStats().mutedCommands;
+			renderer.SetMainLayerMuted(true);
+			child->Render(renderer);
+			renderer.SetMainLayerMuted(false);
+			renderer.RecordOccludedComponent(renderer.GetFrameStats().mutedCommands - mutedCommands);
+		}
+	}
+
+	void RootComponent::CollectOccludedChildren() {
+		m_occludedChildren.assign(m_children.size(), false);
+		m_occluders.clear();
+
+		for (size_t i = m_children.size(); i-- > 0;) {
+			auto& child = m_children[i];
+			if (!child || !child->IsVisible() || child->IsCulled()) continue;
+
+			if (IsOccluded(child->GetVisibleGlobalRect())) {
+				m_occludedChildren[i] = true;
+				continue;
+			}
+
+			Rect opaqueGRect = child->GetOpaqueGlobalRect();
+			if (opaqueGRect.size.w > 0 && opaqueGRect.size.h > 0) m_occluders.push_back(opaqueGRect);
+		}
+	}
+
+	bool RootComponent::IsOccluded(const Rect& rect) {
+		// 遮挡区域可能由多个矩形拼成，依次减去每个遮挡矩形，没有剩余部分时即被完全覆盖
+		constexpr size_t MAX_FRAGMENTS = 64;
+		if (m_occluders.empty() || rect.size.w <= 0 || rect.size.h <= 0) return false;
+
+		m_occlusionFragments.clear();
+		m_occlusionFragments.push_back(rect);
+		for (const auto& occluder : m_occluders) {
+			m_occlusionScratch.clear();
+			for (const auto& fragment : m_occlusionFragments) {
+				float left = SDL_max(fragment.Left(), occluder.Left());
+				float top = SDL_max(fragment.Top(), occluder.Top());
+				float right = SDL_min(fragment.Right(), occluder.Right());
+				float bottom = SDL_min(fragment.Bottom(), occluder.Bottom());
+				if (left >= right || top >= bottom) {
+					m_occlusionScratch.push_back(fragment);
+					continue;
+				}
+
+				// 剩余部分拆分为上、下、左、右四块
+				if (fragment.Top() < top) m_occlusionScratch.emplace_back(fragment.Left(), fragment.Top(), fragment.size.w, top - fragment.Top());
+				if (bottom < fragment.Bottom()) m_occlusionScratch.emplace_back(fragment.Left(), bottom, fragment.size.w, fragment.Bottom() - bottom);
+				if (fragment.Left() < left) m_occlusionScratch.emplace_back(fragment.Left(), top, left - fragment.Left(), bottom - top);
+				if (right < fragment.Right()) m_occlusionScratch.emplace_back(right, top, fragment.Right() - right, bottom - top);
+			}
+
+			std::swap(m_occlusionFragments, m_occlusionScratch);
+			if (m_occlusionFragments.empty()) return true;
+			if (m_occlusionFragments.size() > MAX_FRAGMENTS) return false;
+		}
+		return false;
 	}
 }
\ No newline at end of file
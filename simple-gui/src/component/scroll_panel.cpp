@@ -8,6 +8,8 @@ namespace SimpleGui {
 		m_hScrollBar = std::make_unique<ScrollBar>(Direction::Horizontal);
 		m_vScrollBar = std::make_unique<ScrollBar>(Direction::Vertical);
 		m_shiftPressed = false;
+		m_blitScrollEnabled = false;
+		m_kineticScrollEnabled = false;
 
 		m_hScrollBar->SetTarget(this);
 		m_vScrollBar->SetTarget(this);
@@ -29,11 +31,33 @@ namespace SimpleGui {
 		);
 	}
 
+	void ScrollPanel::SetBlitScrollEnabled(bool enabled) {
+		m_blitScrollEnabled = enabled;
+		if (!enabled) m_scrollCache = ScrollCache();
+		m_scrollCache.valid = false;
+	}
+
+	void ScrollPanel::SetKineticScrollEnabled(bool enabled) {
+		m_kineticScrollEnabled = enabled;
+		if (!enabled) m_kineticVelocity = Vec2();
+	}
+
+	void ScrollPanel::Fling(const Vec2& velocity) {
+		m_kineticVelocity = velocity;
+	}
+
+	void ScrollPanel::AddDamageRect(const Rect& gRect) {
+		if (!m_blitScrollEnabled) return;
+		m_scrollCache.damageRects.push_back(gRect);
+	}
+
 	bool ScrollPanel::HandleEvent(Event* event) {
 		SG_CMP_HANDLE_EVENT_CONDITIONS_FALSE;
 
-		if (m_hScrollBar->HandleEvent(event)) return true;
-		if (m_vScrollBar->HandleEvent(event)) return true;
+		if (m_hScrollBar->HandleEvent(event) || m_vScrollBar->HandleEvent(event)) {
+			m_kineticVelocity = Vec2();
+			return true;
+		}
 
 		//if (!m_visibleGRect.ContainPoint(SG_GuiManager.GetMousePosition())) return false;
 
@@ -43,7 +67,15 @@ namespace SimpleGui {
 			m_shiftPressed = (ev->IsPressed() && ev->GetKeyMod() == SDL_KMOD_LSHIFT) ? true : false;
 		}
 
-		if (auto ev = event->Convert<MouseWheelEvent>()) {
+		if (auto ev = event->Convert<MouseWheelEvent>(); ev && m_kineticScrollEnabled) {
+			// 每次滚动增加的速度衰减完后移动的距离与普通滚动一致
+			float& velocity = m_shiftPressed ? m_kineticVelocity.x : m_kineticVelocity.y;
+			float wheelDelta = m_shiftPressed ? m_hScrollBar->m_mouseWheelDelta : m_vScrollBar->m_mouseWheelDelta;
+			float impulse = -ev->GetDirection().y * wheelDelta * KINETIC_FRICTION;
+			if (velocity * impulse < 0) velocity = 0;
+			velocity += impulse;
+		}
+		else if (ev) {
 			if (!m_shiftPressed) {
 				m_vScrollBar->UpdateSliderPositionByWheel(m_vScrollBar->m_mouseWheelDelta, -ev->GetDirection().y);
 			}
@@ -60,8 +92,33 @@ namespace SimpleGui {
 	void ScrollPanel::Update() {
 		SG_CMP_UPDATE_CONDITIONS;
 
+		// 先应用本帧的滚动再更新子组件，子组件的可见矩形和剔除状态都基于滚动后的位置，
+		// 重绘新露出的区域时不会漏掉刚滚入的子组件
+		CalcVisibleGlobalRect(m_parent, this);
+		UpdateKineticScroll();
+		// 滑块只会整体平移子组件，前后边界的位移就是本帧的滚动距离
+		Rect oldChildrenBounds = GetChildrenBounds();
+		UpdateScrollBars();
+		Rect scrolledChildrenBounds = GetChildrenBounds();
+
 		BaseComponent::Update();
+		// 子组件更新后内容尺寸可能改变，重新计算滑块
+		UpdateScrollBars();
+
+		if (m_blitScrollEnabled) {
+			Rect childrenBounds = GetChildrenBounds();
+			// 子组件在更新中移动或改变了尺寸时，缓存中的内容不能再平移复用
+			if (childrenBounds.size.IsEqualApprox(oldChildrenBounds.size) &&
+				childrenBounds.position.IsEqualApprox(scrolledChildrenBounds.position)) {
+				m_scrollCache.scrollDelta += childrenBounds.position - oldChildrenBounds.position;
+			}
+			else {
+				m_scrollCache.valid = false;
+			}
+		}
+	}
 
+	void ScrollPanel::UpdateScrollBars() {
 		Rect globalRect = GetGlobalRect();
 		Rect contentGRect = GetContentGlobalRect();
 		Rect boundaryGRect = CalcChildrenBoundaryGlobalRect(this);
@@ -105,11 +162,16 @@ namespace SimpleGui {
 		if (!m_vScrollBar->m_visible && m_vScrollBar->m_dragSliderData.canDragging) m_vScrollBar->m_dragSliderData.canDragging = false;
 	}
 
+	Rect ScrollPanel::GetOpaqueGlobalRect() {
+		if (!m_visible || GetThemeColor(ThemeColorFlags::ScrollPanelBackground).a != 255) return {};
+		return m_visibleGRect;
+	}
+
 	void ScrollPanel::Render(Renderer& renderer) {
 		SG_CMP_RENDER_CONDITIONS;
 
 		renderer.RenderRect(m_visibleGRect, GetThemeColor(ThemeColorFlags::ScrollPanelBackground), true);
-		BaseComponent::Render(renderer);
+		if (!m_blitScrollEnabled || !RenderChildrenCached(renderer)) BaseComponent::Render(renderer);
 		m_hScrollBar->Render(renderer);
 		m_vScrollBar->Render(renderer);
 		renderer.SetRenderClipRect(m_visibleGRect);
@@ -120,4 +182,140 @@ namespace SimpleGui {
 		//renderer.DrawRect(GetContentGlobalRect(), Color::MAGENTA);
 		//renderer.DrawRect(CalcChildrenBoundaryGlobalRect(this), Color::GREEN);
 	}
-}
+
+	void ScrollPanel::UpdateKineticScroll() {
+		if (m_kineticVelocity.IsZeroApprox()) return;
+
+		float delta = static_cast<float>(SG_GuiManager.GetDelta());
+		Vec2 step = m_kineticVelocity * delta;
+		m_hScrollBar->UpdateSliderPositionByWheel(SDL_fabsf(step.x), step.x < 0 ? -1 : 1);
+		m_vScrollBar->UpdateSliderPositionByWheel(SDL_fabsf(step.y), step.y < 0 ? -1 : 1);
+
+		m_kineticVelocity *= SDL_expf(-KINETIC_FRICTION * delta);
+		if (m_kineticVelocity.Length() < KINETIC_STOP_SPEED) m_kineticVelocity = Vec2();
+	}
+
+	bool ScrollPanel::PrepareScrollCache(Renderer& renderer) {
+		auto& cache = m_scrollCache;
+		Vec2 outputSize = renderer.GetRenderOutputSize();
+		if (cache.textures[0] && cache.textures[1] && cache.outputSize == outputSize) return true;
+
+		// 缓存纹理与窗口等大，子组件的绘制命令不需要做坐标转换
+		cache.valid = false;
+		cache.outputSize = outputSize;
+		for (auto& texture : cache.textures) {
+			texture = renderer.CreateTargetTexture(static_cast<int>(outputSize.w), static_cast<int>(outputSize.h));
+			if (!texture) {
+				SG_ERROR("ScrollPanel: failed to create scroll cache texture, blit scrolling disabled. {}", SDL_GetError());
+				SetBlitScrollEnabled(false);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ScrollPanel::RenderChildrenCached(Renderer& renderer) {
+		auto& cache = m_scrollCache;
+		Vec2 scrollDelta = cache.scrollDelta;
+		cache.scrollDelta = Vec2();
+
+		// 不在主层或主层被静音时无法维护缓存
+		if (renderer.GetRenderLayer() != RenderLayer::Main || renderer.IsMainLayerMuted() || !PrepareScrollCache(renderer)) {
+			cache.valid = false;
+			return false;
+		}
+
+		Rect contentGRect(GetContentGlobalRect().GetIntersection(m_visibleGRect).ToSDLRect());
+		if (contentGRect.size.w < 1 || contentGRect.size.h < 1) {
+			cache.valid = false;
+			return false;
+		}
+
+		// 纹理只能按整像素平移，累计误差超过半个像素时完整重绘
+		Vec2 shift(SDL_roundf(scrollDelta.x), SDL_roundf(scrollDelta.y));
+		cache.residual += scrollDelta - shift;
+		bool blit = cache.valid && !shift.IsZeroApprox() &&
+			cache.contentGRect.position == contentGRect.position && cache.contentGRect.size == contentGRect.size &&
+			SDL_fabsf(shift.x) < contentGRect.size.w && SDL_fabsf(shift.y) < contentGRect.size.h &&
+			SDL_fabsf(cache.residual.x) <= 0.5f && SDL_fabsf(cache.residual.y) <= 0.5f;
+
+		RenderToolTipAndExtendedFunctions(renderer);
+
+		SDL_Texture* front = cache.textures[cache.front].get();
+		SDL_Texture* back = cache.textures[1 - cache.front].get();
+		// 没有滚动也没有通知变化时仍然完整记录一遍子组件，主层命令与缓存的内容相同就丢弃，直接使用缓存
+		bool reusable = cache.valid && shift.IsZeroApprox() && cache.damageRects.empty() &&
+			cache.contentGRect.position == contentGRect.position && cache.contentGRect.size == contentGRect.size;
+
+		size_t begin = renderer.GetRecordedCommandCount();
+		renderer.PushRenderTarget(back);
+		size_t contentBegin = renderer.GetRecordedCommandCount();
+		Rect redrawGRect = contentGRect;
+		if (blit) {
+			renderer.SetRenderClipRect(contentGRect);
+			renderer.RenderTexture(front, contentGRect, Rect(contentGRect.position + shift, contentGRect.size), SDL_BLENDMODE_NONE);
+			renderer.ClearRenderClipRect();
+
+			// 新露出的区域和通知变化的区域合并为一个矩形重绘，每个子组件只需绘制一次
+			bool merged = false;
+			auto Merge = [&redrawGRect, &merged](const Rect& rect) {
+				if (!merged) {
+					redrawGRect = rect;
+					merged = true;
+					return;
+				}
+				float left = SDL_min(redrawGRect.Left(), rect.Left());
+				float top = SDL_min(redrawGRect.Top(), rect.Top());
+				float right = SDL_max(redrawGRect.Right(), rect.Right());
+				float bottom = SDL_max(redrawGRect.Bottom(), rect.Bottom());
+				redrawGRect = Rect(left, top, right - left, bottom - top);
+				};
+			if (shift.y > 0) Merge(Rect(contentGRect.Left(), contentGRect.Top(), contentGRect.size.w, shift.y));
+			else if (shift.y < 0) Merge(Rect(contentGRect.Left(), contentGRect.Bottom() + shift.y, contentGRect.size.w, -shift.y));
+			if (shift.x > 0) Merge(Rect(contentGRect.Left(), contentGRect.Top(), shift.x, contentGRect.size.h));
+			else if (shift.x < 0) Merge(Rect(contentGRect.Right() + shift.x, contentGRect.Top(), -shift.x, contentGRect.size.h));
+
+			for (const auto& rect : cache.damageRects) {
+				if (rect.IsIntersect(contentGRect)) Merge(Rect(rect.GetIntersection(contentGRect).ToSDLRect()));
+			}
+		}
+		else {
+			cache.residual = Vec2();
+		}
+		RenderChildrenInRect(renderer, redrawGRect);
+		Uint64 contentHash = blit ? 0 : renderer.HashMainLayerCommands(contentBegin);
+		renderer.PopRenderTarget();
+
+		if (reusable && contentHash == cache.contentHash) {
+			renderer.DiscardMainLayerCommands(begin);
+			renderer.RenderTexture(front, contentGRect, contentGRect, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+			return true;
+		}
+
+		// 缓存中是预乘透明度的内容
+		renderer.RenderTexture(back, contentGRect, contentGRect, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+
+		cache.front = 1 - cache.front;
+		cache.contentGRect = contentGRect;
+		cache.contentHash = contentHash;
+		cache.damageRects.clear();
+		cache.valid = true;
+		return true;
+	}
+
+	void ScrollPanel::RenderChildrenInRect(Renderer& renderer, const Rect& gRect) {
+		renderer.RenderClearRect(gRect, Color::TRANSPARENT);
+		renderer.PushClipConstraint(gRect);
+		for (auto& child : m_children) {
+			if (child && !child->IsCulled() && child->GetVisibleGlobalRect().IsIntersect(gRect)) child->Render(renderer);
+		}
+		renderer.PopClipConstraint();
+
+		// 没有重绘的子组件仍需要记录其他层的内容
+		renderer.SetMainLayerMuted(true);
+		for (auto& child : m_children) {
+			if (child && !child->IsCulled() && !child->GetVisibleGlobalRect().IsIntersect(gRect)) child->Render(renderer);
+		}
+		renderer.SetMainLayerMuted(false);
+	}
+}
\ No newline at end of file
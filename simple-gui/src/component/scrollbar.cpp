@@ -186,7 +186,7 @@ namespace SimpleGui {
 			float maxMovingDistance = contentGRect.size.w - m_slider.globalRect.size.w;
 			float mScale = (m_slider.globalRect.Left() - contentGRect.Left()) / maxMovingDistance;
 			float distance = (boundaryGRect.size.w - targetContentGRect.size.w) * mScale;
-			m_target->ForEachChild([this, distance](BaseComponent* cmp) { this->UpdateTargetChildrenPosition(cmp, -distance); });
+			m_target->TranslateChildren(Vec2(-distance - m_alignmentOffset.x, 0));
 		}
 		else {
 			float tScale = (targetContentGRect.position.x - boundaryGRect.position.x) / (boundaryGRect.size.w - targetContentGRect.size.w);
@@ -230,7 +230,7 @@ namespace SimpleGui {
 			float maxMovingDistance = contentGRect.size.h - m_slider.globalRect.size.h;
 			float mScale = (m_slider.globalRect.Top() - contentGRect.Top()) / maxMovingDistance;
 			float distance = (boundaryGRect.size.h - targetContentGRect.size.h) * mScale;
-			m_target->ForEachChild([this, distance](BaseComponent* cmp) { this->UpdateTargetChildrenPosition(cmp, -distance); });
+			m_target->TranslateChildren(Vec2(0, -distance - m_alignmentOffset.y));
 		}
 		else {
 			float tScale = (targetContentGRect.position.y - boundaryGRect.position.y) / (boundaryGRect.size.h - targetContentGRect.size.h);
@@ -239,17 +239,6 @@ namespace SimpleGui {
 		}
 	}
 
-	void ScrollBar::UpdateTargetChildrenPosition(BaseComponent* cmp, float distance) const {
-		if (m_direction == Direction::Horizontal) {
-			float x = cmp->GetPosition().x;
-			cmp->SetPositionX(x + distance - m_alignmentOffset.x);
-		}
-		else {
-			float y = cmp->GetPosition().y;
-			cmp->SetPositionY(y + distance - m_alignmentOffset.y);
-		}
-	}
-
 	void ScrollBar::UpdateSliderPositionByWheel(float delta, int direction) {
 		direction = direction < 0 ? -1 : (direction > 0 ? 1 : 0);
 		if (direction == 0) return;
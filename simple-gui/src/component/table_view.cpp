@@ -0,0 +1,429 @@
+#include <numeric>
+#include "component/table_view.hpp"
+#include "gui_manager.hpp"
+
+
+namespace SimpleGui {
+	static constexpr float COLUMN_SEPARATOR_HIT_WIDTH = 4;
+
+	TableView::TableView() : m_vScrollBar(Direction::Vertical), m_hScrollBar(Direction::Horizontal) {
+		m_rowCount = 0;
+		m_firstRow = 0;
+		m_lastRow = 0;
+		m_sortColumn = INVALID_INDEX;
+		m_frame = 0;
+		m_rowHeight = 0;
+		m_minColumnWidth = 20;
+		m_sortAscending = true;
+		m_resizeCursor = UniqueCursorPtr(SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_EW_RESIZE));
+	}
+
+	void TableView::EnteredComponentTree() {
+		BaseComponent::EnteredComponentTree();
+
+		m_padding = m_window->GetCurrentStyle()->componentPadding;
+		if (m_rowHeight <= 0) {
+			m_rowHeight = GetFont().GetHeight() + m_padding.top + m_padding.bottom;
+		}
+		SetMinSize(m_vScrollBar.GetThickness() + m_padding.left + m_padding.right, m_rowHeight * 2);
+		SetSize(400, 300);
+	}
+
+	void TableView::OnFontChanged() {
+		// 缓存的文本在下次更新时用新字体重新创建
+		for (auto& cache : m_headerCaches) {
+			cache.text.reset();
+		}
+		m_cellCaches.clear();
+	}
+
+	void TableView::AddColumn(std::unique_ptr<TableColumn> column) {
+		if (!column) return;
+		m_columns.push_back(std::move(column));
+	}
+
+	void TableView::SortByColumn(size_t column, bool ascending) {
+		if (column >= m_columns.size()) return;
+
+		// 正在排序时记录请求，当前排序完成后再开始，避免等待后台线程
+		if (IsSorting()) {
+			m_pendingSort = SortRequest{ column, ascending };
+			m_sortColumn = column;
+			m_sortAscending = ascending;
+			return;
+		}
+		StartSort(column, ascending);
+	}
+
+	void TableView::ClearSort() {
+		m_order.clear();
+		m_pendingSort.reset();
+		m_sortColumn = INVALID_INDEX;
+		m_sortAscending = true;
+	}
+
+	void TableView::ScrollToRow(size_t viewRow) {
+		if (viewRow >= m_rowCount) return;
+
+		float top = viewRow * m_rowHeight;
+		float bottom = top + m_rowHeight;
+		float viewH = m_cellsGRect.size.h;
+		float offset = m_vScrollBar.GetOffset();
+		if (top < offset) offset = top;
+		else if (bottom > offset + viewH) offset = bottom - viewH;
+		m_vScrollBar.SetOffset(offset);
+	}
+
+	bool TableView::HandleEvent(Event* event) {
+		SG_CMP_HANDLE_EVENT_CONDITIONS_FALSE;
+
+		if (m_vScrollBar.HandleEvent(event)) return true;
+		if (m_hScrollBar.HandleEvent(event)) return true;
+		if (BaseComponent::HandleEvent(event)) return true;
+
+		if (auto ev = event->Convert<MouseMotionEvent>()) {
+			Vec2 pos = ev->GetPosition();
+			if (m_resizeColumnData.column != INVALID_INDEX) {
+				float width = m_resizeColumnData.startWidth + pos.x - m_resizeColumnData.startMousePosX;
+				m_columns[m_resizeColumnData.column]->SetWidth(SDL_max(width, m_minColumnWidth));
+				return true;
+			}
+
+			bool onSeparator = false;
+			if (m_headerGRect.GetIntersection(m_visibleGRect).ContainPoint(pos)) {
+				GetColumnAtPosition(pos.x, &onSeparator);
+			}
+			if (onSeparator) SDL_SetCursor(m_resizeCursor.get());
+			else if (SDL_GetCursor() == m_resizeCursor.get()) SDL_SetCursor(SDL_GetDefaultCursor());
+		}
+		else if (auto ev = event->Convert<MouseWheelEvent>()) {
+			if (m_visibleGRect.ContainPoint(ev->GetPosition())) {
+				Vec2 dir = ev->GetDirection();
+				if (dir.x != 0 || (SDL_GetModState() & SDL_KMOD_SHIFT)) {
+					m_hScrollBar.ScrollBy((dir.x != 0 ? dir.x : -dir.y) * m_rowHeight * 3);
+				}
+				else {
+					m_vScrollBar.ScrollBy(-dir.y * m_rowHeight * 3);
+				}
+				return true;
+			}
+		}
+		else if (auto ev = event->Convert<MouseButtonEvent>()) {
+			Vec2 pos = ev->GetPosition();
+			if (ev->IsPressed(MouseButton::Left)) {
+				bool onSeparator = false;
+				if (m_headerGRect.GetIntersection(m_visibleGRect).ContainPoint(pos)) {
+					size_t column = GetColumnAtPosition(pos.x, &onSeparator);
+					if (column == INVALID_INDEX) return false;
+
+					if (onSeparator) {
+						m_resizeColumnData.column = column;
+						m_resizeColumnData.startMousePosX = pos.x;
+						m_resizeColumnData.startWidth = m_columns[column]->GetWidth();
+					}
+					else {
+						SortByColumn(column, column == m_sortColumn ? !m_sortAscending : true);
+					}
+					return true;
+				}
+
+				if (m_cellsGRect.GetIntersection(m_visibleGRect).ContainPoint(pos) && m_rowHeight > 0) {
+					size_t column = GetColumnAtPosition(pos.x);
+					size_t viewRow = static_cast<size_t>((pos.y - m_cellsGRect.Top() + m_vScrollBar.GetOffset()) / m_rowHeight);
+					if (column != INVALID_INDEX && viewRow < m_rowCount) {
+						cellClicked.Emit(MapViewRowToDataRow(viewRow), column);
+						return true;
+					}
+				}
+			}
+			else if (ev->IsReleased(MouseButton::Left) && m_resizeColumnData.column != INVALID_INDEX) {
+				m_resizeColumnData.column = INVALID_INDEX;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void TableView::Update() {
+		SG_CMP_UPDATE_CONDITIONS;
+
+		BaseComponent::Update();
+
+		PollSortResult();
+
+		m_rowCount = 0;
+		for (const auto& column : m_columns) {
+			m_rowCount = SDL_max(m_rowCount, column->GetRowCount());
+		}
+
+		UpdateScrollBars();
+		UpdateHeaderTexts();
+		UpdateCellCaches();
+	}
+
+	void TableView::Render(Renderer& renderer) {
+		SG_CMP_RENDER_CONDITIONS;
+
+		// draw bg
+		renderer.RenderRect(m_visibleGRect, GetThemeColor(ThemeColorFlags::TableViewBackground), true);
+
+		float hOffset = m_hScrollBar.GetOffset();
+		float vOffset = m_vScrollBar.GetOffset();
+		float fontHeight = static_cast<float>(GetFont().GetHeight());
+		float textOffsetY = (m_rowHeight - fontHeight) / 2;
+		Color gridColor = GetThemeColor(ThemeColorFlags::TableViewGrid);
+
+		// draw cells
+		Rect cellsClipGRect = m_cellsGRect.GetIntersection(m_visibleGRect);
+		if (!cellsClipGRect.size.IsZeroApprox()) {
+			renderer.SetRenderClipRect(cellsClipGRect);
+
+			Color alternateColor = GetThemeColor(ThemeColorFlags::TableViewAlternateRow);
+			for (size_t row = m_firstRow; row < m_lastRow; ++row) {
+				if (row % 2 == 0) continue;
+				renderer.RenderRect(Rect(m_cellsGRect.Left(), m_cellsGRect.Top() + row * m_rowHeight - vOffset, m_cellsGRect.size.w, m_rowHeight),
+					alternateColor, true);
+			}
+
+			Color fgColor = GetThemeColor(ThemeColorFlags::TableViewForeground);
+			float left = m_cellsGRect.Left() - hOffset;
+			for (size_t col = 0; col < m_columns.size(); ++col) {
+				float right = left + m_columns[col]->GetWidth();
+				if (right > m_cellsGRect.Left() && left < m_cellsGRect.Right()) {
+					// 过长的文本不能画到相邻的列中
+					renderer.SetRenderClipRect(Rect(left, cellsClipGRect.Top(), right - left, cellsClipGRect.size.h).GetIntersection(cellsClipGRect));
+					for (size_t row = m_firstRow; row < m_lastRow; ++row) {
+						auto text = GetCellText(MapViewRowToDataRow(row), col);
+						if (!text) continue;
+						renderer.RenderText(text, Vec2(left + m_padding.left, m_cellsGRect.Top() + row * m_rowHeight - vOffset + textOffsetY), fgColor);
+					}
+					renderer.SetRenderClipRect(cellsClipGRect);
+					renderer.RenderLine(Vec2(right, m_cellsGRect.Top()), Vec2(right, m_cellsGRect.Bottom()), gridColor);
+				}
+				left = right;
+			}
+
+			for (size_t row = m_firstRow; row < m_lastRow; ++row) {
+				float y = m_cellsGRect.Top() + (row + 1) * m_rowHeight - vOffset;
+				renderer.RenderLine(Vec2(m_cellsGRect.Left(), y), Vec2(m_cellsGRect.Right(), y), gridColor);
+			}
+
+			renderer.ClearRenderClipRect();
+		}
+
+		// draw header
+		Rect headerClipGRect = m_headerGRect.GetIntersection(m_visibleGRect);
+		if (!headerClipGRect.size.IsZeroApprox()) {
+			renderer.SetRenderClipRect(headerClipGRect);
+			renderer.RenderRect(m_headerGRect, GetThemeColor(ThemeColorFlags::TableViewHeaderBackground), true);
+
+			Color headerFgColor = GetThemeColor(ThemeColorFlags::TableViewHeaderForeground);
+			float left = m_headerGRect.Left() - hOffset;
+			for (size_t col = 0; col < m_columns.size(); ++col) {
+				float right = left + m_columns[col]->GetWidth();
+				if (right > m_headerGRect.Left() && left < m_headerGRect.Right()) {
+					renderer.SetRenderClipRect(Rect(left, headerClipGRect.Top(), right - left, headerClipGRect.size.h).GetIntersection(headerClipGRect));
+					renderer.RenderText(m_headerCaches[col].text.get(), Vec2(left + m_padding.left, m_headerGRect.Top() + textOffsetY), headerFgColor);
+					renderer.SetRenderClipRect(headerClipGRect);
+
+					// 排序标记
+					if (col == m_sortColumn) {
+						float size = fontHeight / 3;
+						Vec2 center(right - m_padding.right - size, m_headerGRect.Top() + m_rowHeight / 2);
+						if (m_sortAscending) {
+							renderer.RenderTriangle(Vec2(center.x - size, center.y + size / 2), Vec2(center.x + size, center.y + size / 2),
+								Vec2(center.x, center.y - size / 2), headerFgColor, true);
+						}
+						else {
+							renderer.RenderTriangle(Vec2(center.x - size, center.y - size / 2), Vec2(center.x + size, center.y - size / 2),
+								Vec2(center.x, center.y + size / 2), headerFgColor, true);
+						}
+					}
+					renderer.RenderLine(Vec2(right, m_headerGRect.Top()), Vec2(right, m_headerGRect.Bottom()), gridColor);
+				}
+				left = right;
+			}
+			renderer.RenderLine(m_headerGRect.BottomLeft(), Vec2(m_headerGRect.Right(), m_headerGRect.Bottom()), gridColor);
+
+			renderer.ClearRenderClipRect();
+		}
+
+		// draw scrollbars
+		auto GetSliderColor = [this](MouseState state, ThemeColorFlags normal, ThemeColorFlags hovered, ThemeColorFlags pressed) {
+			if (state == MouseState::Pressed) return GetThemeColor(pressed);
+			if (state == MouseState::Hovering) return GetThemeColor(hovered);
+			return GetThemeColor(normal);
+			};
+		m_vScrollBar.Render(renderer, GetThemeColor(ThemeColorFlags::ScrollbarSlot_V),
+			GetSliderColor(m_vScrollBar.GetSliderState(), ThemeColorFlags::ScrollbarSlider_V,
+				ThemeColorFlags::ScrollbarSliderHovered_V, ThemeColorFlags::ScrollbarSliderPressed_V));
+		m_hScrollBar.Render(renderer, GetThemeColor(ThemeColorFlags::ScrollbarSlot_H),
+			GetSliderColor(m_hScrollBar.GetSliderState(), ThemeColorFlags::ScrollbarSlider_H,
+				ThemeColorFlags::ScrollbarSliderHovered_H, ThemeColorFlags::ScrollbarSliderPressed_H));
+
+		// draw border
+		renderer.SetRenderClipRect(m_visibleGRect);
+		renderer.RenderRect(GetGlobalRect(), GetThemeColor(ThemeColorFlags::TableViewBorder), false);
+		renderer.ClearRenderClipRect();
+
+		BaseComponent::Render(renderer);
+	}
+
+	float TableView::GetTotalColumnsWidth() const {
+		float width = 0;
+		for (const auto& column : m_columns) {
+			width += column->GetWidth();
+		}
+		return width;
+	}
+
+	size_t TableView::GetColumnAtPosition(float x, bool* onSeparator) const {
+		float left = m_headerGRect.Left() - m_hScrollBar.GetOffset();
+		for (size_t col = 0; col < m_columns.size(); ++col) {
+			float right = left + m_columns[col]->GetWidth();
+			if (onSeparator && SDL_fabsf(x - right) <= COLUMN_SEPARATOR_HIT_WIDTH) {
+				*onSeparator = true;
+				return col;
+			}
+			if (x >= left && x < right) return col;
+			left = right;
+		}
+		return INVALID_INDEX;
+	}
+
+	void TableView::StartSort(size_t column, bool ascending) {
+		m_sortColumn = column;
+		m_sortAscending = ascending;
+
+		// 比较函数基于数据快照，排序期间可以继续修改列中的数据
+		auto comparator = m_columns[column]->CreateSortComparator();
+		size_t rowCount = m_columns[column]->GetRowCount();
+		m_sortFuture = std::async(std::launch::async, [comparator = std::move(comparator), rowCount, ascending]() {
+			std::vector<size_t> order(rowCount);
+			std::iota(order.begin(), order.end(), 0);
+			if (ascending) {
+				std::stable_sort(order.begin(), order.end(), comparator);
+			}
+			else {
+				std::stable_sort(order.begin(), order.end(), [&comparator](size_t a, size_t b) { return comparator(b, a); });
+			}
+			return order;
+			});
+	}
+
+	void TableView::PollSortResult() {
+		if (!m_sortFuture.valid() || m_sortFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+		auto order = m_sortFuture.get();
+		if (m_pendingSort) {
+			SortRequest request = *m_pendingSort;
+			m_pendingSort.reset();
+			StartSort(request.column, request.ascending);
+			return;
+		}
+
+		// 排序期间调用了ClearSort，丢弃结果
+		if (m_sortColumn == INVALID_INDEX) return;
+
+		m_order = std::move(order);
+		sorted.Emit(m_sortColumn, m_sortAscending);
+	}
+
+	void TableView::UpdateScrollBars() {
+		Rect gRect = GetGlobalRect();
+		Rect contentGRect = GetContentGlobalRect();
+		float thickness = m_vScrollBar.GetThickness();
+		float contentW = GetTotalColumnsWidth();
+		float contentH = m_rowCount * m_rowHeight;
+		float viewH = SDL_max(contentGRect.size.h - m_rowHeight, 0.f);
+
+		bool vNeeded = contentH > viewH;
+		bool hNeeded = contentW > contentGRect.size.w - (vNeeded ? thickness : 0);
+		if (!vNeeded && hNeeded) vNeeded = contentH > viewH - thickness;
+
+		float viewW = vNeeded ? SDL_max(contentGRect.size.w - thickness, 0.f) : contentGRect.size.w;
+		if (hNeeded) viewH = SDL_max(viewH - thickness, 0.f);
+
+		m_headerGRect = Rect(contentGRect.Left(), contentGRect.Top(), viewW, SDL_min(m_rowHeight, contentGRect.size.h));
+		m_cellsGRect = Rect(contentGRect.Left(), contentGRect.Top() + m_rowHeight, viewW, viewH);
+
+		m_vScrollBar.Update(Rect(gRect.Right() - thickness, gRect.Top(), thickness, gRect.size.h - (hNeeded ? thickness : 0)),
+			m_visibleGRect, contentH, viewH);
+		m_hScrollBar.Update(Rect(gRect.Left(), gRect.Bottom() - thickness, gRect.size.w - (vNeeded ? thickness : 0), thickness),
+			m_visibleGRect, contentW, viewW);
+	}
+
+	void TableView::UpdateHeaderTexts() {
+		m_headerCaches.resize(m_columns.size());
+		for (size_t col = 0; col < m_columns.size(); ++col) {
+			auto& cache = m_headerCaches[col];
+			const auto& title = m_columns[col]->GetTitle();
+			if (cache.text && cache.title == title) continue;
+
+			cache.title = title;
+			if (cache.text) {
+				TTF_SetTextString(cache.text.get(), title.c_str(), title.length());
+			}
+			else {
+				cache.text = UniqueTextPtr(TTF_CreateText(&m_window->GetTTFTextEngine(), &GetFont().GetTTFFont(), title.c_str(), title.length()));
+			}
+		}
+	}
+
+	void TableView::UpdateCellCaches() {
+		++m_frame;
+		if (m_rowCount == 0 || m_rowHeight <= 0) {
+			m_firstRow = 0;
+			m_lastRow = 0;
+			m_cellCaches.clear();
+			return;
+		}
+
+		// 可见行范围 [first, last)
+		float offset = m_vScrollBar.GetOffset();
+		m_firstRow = SDL_min(static_cast<size_t>(offset / m_rowHeight), m_rowCount);
+		m_lastRow = SDL_min(static_cast<size_t>((offset + m_cellsGRect.size.h) / m_rowHeight) + 1, m_rowCount);
+
+		float left = -m_hScrollBar.GetOffset();
+		for (size_t col = 0; col < m_columns.size(); ++col) {
+			const auto& column = m_columns[col];
+			float right = left + column->GetWidth();
+			bool visible = right > 0 && left < m_cellsGRect.size.w;
+			left = right;
+			if (!visible) continue;
+
+			uint64_t version = column->GetVersion();
+			for (size_t row = m_firstRow; row < m_lastRow; ++row) {
+				size_t dataRow = MapViewRowToDataRow(row);
+				auto& cache = m_cellCaches[MakeCellKey(dataRow, col)];
+				cache.frame = m_frame;
+				if (cache.text && cache.version == version) continue;
+
+				// 列中的数据有修改，重新格式化，文本没有变化时继续使用原来的TTF_Text
+				cache.version = version;
+				column->FormatCell(dataRow, m_formatBuffer);
+				if (cache.text && cache.string == m_formatBuffer) continue;
+
+				cache.string = m_formatBuffer;
+				if (cache.text) {
+					TTF_SetTextString(cache.text.get(), cache.string.c_str(), cache.string.length());
+				}
+				else {
+					cache.text = UniqueTextPtr(TTF_CreateText(&m_window->GetTTFTextEngine(), &GetFont().GetTTFFont(),
+						cache.string.c_str(), cache.string.length()));
+				}
+			}
+		}
+
+		// 移除不可见单元格的缓存
+		std::erase_if(m_cellCaches, [this](const auto& item) {
+			return item.second.frame != m_frame;
+			});
+	}
+
+	TTF_Text* TableView::GetCellText(size_t dataRow, size_t column) const {
+		auto it = m_cellCaches.find(MakeCellKey(dataRow, column));
+		return it != m_cellCaches.end() ? it->second.text.get() : nullptr;
+	}
+}
@@ -0,0 +1,539 @@
+#include <utf8.h>
+#include <SDL3/SDL_clipboard.h>
+#include "component/text_edit.hpp"
+#include "component/common/utils.hpp"
+#include "gui_manager.hpp"
+
+
+namespace SimpleGui {
+	TextEdit::TextEdit(std::string_view text) :
+		m_document(text), m_vScrollBar(Direction::Vertical), m_hScrollBar(Direction::Horizontal) {
+		m_caretOffset = 0;
+		m_anchorOffset = 0;
+		m_caretLine = 0;
+		m_firstVisibleLine = 0;
+		m_lastVisibleLine = 0;
+		m_lineHeight = 0;
+		m_contentWidth = 0;
+		m_caretX = 0;
+		m_preferredCaretX = -1;
+		m_active = false;
+		m_editable = true;
+		m_selecting = false;
+		m_caretDirty = true;
+		m_ensureCaretVisible = false;
+		m_cursor = UniqueCursorPtr(SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_TEXT));
+
+		m_caret.SetBlink(true);
+		m_caret.SetVisible(false);
+	}
+
+	void TextEdit::EnteredComponentTree() {
+		BaseComponent::EnteredComponentTree();
+
+		m_padding = m_window->GetCurrentStyle()->componentPadding;
+		m_lineHeight = static_cast<float>(GetFont().GetHeight());
+		SetMinSize(GetFont().GetSize() + m_padding.left + m_padding.right + m_vScrollBar.GetThickness(),
+			m_lineHeight + m_padding.top + m_padding.bottom);
+		SetSize(300, 200);
+	}
+
+	void TextEdit::SetText(std::string_view text) {
+		m_document.SetText(text);
+		m_lineCaches.clear();
+		m_contentWidth = 0;
+		m_vScrollBar.SetOffset(0);
+		m_hScrollBar.SetOffset(0);
+		MoveCaret(0, false);
+		textChanged.Emit();
+	}
+
+	std::string TextEdit::GetSelectedText() const {
+		std::string text;
+		size_t start = SDL_min(m_anchorOffset, m_caretOffset);
+		size_t end = SDL_max(m_anchorOffset, m_caretOffset);
+		m_document.GetText(start, end - start, text);
+		return text;
+	}
+
+	void TextEdit::SetCaretPosition(size_t offset) {
+		MoveCaret(offset, false);
+	}
+
+	void TextEdit::Select(size_t start, size_t end) {
+		m_anchorOffset = SDL_min(start, m_document.GetLength());
+		MoveCaret(end, true);
+	}
+
+	void TextEdit::InsertText(std::string_view text) {
+		if (HasSelection()) {
+			size_t start = SDL_min(m_anchorOffset, m_caretOffset);
+			EraseRange(start, SDL_max(m_anchorOffset, m_caretOffset) - start);
+			m_caretOffset = start;
+		}
+
+		if (!text.empty()) {
+			size_t lineCount = m_document.GetLineCount();
+			size_t line = m_document.GetLineFromOffset(m_caretOffset);
+			m_document.Insert(m_caretOffset, text);
+			InvalidateLines(line, lineCount != m_document.GetLineCount());
+		}
+
+		MoveCaret(m_caretOffset + text.length(), false);
+		textChanged.Emit();
+	}
+
+	bool TextEdit::HandleEvent(Event* event) {
+		SG_CMP_HANDLE_EVENT_CONDITIONS_FALSE;
+
+		if (m_vScrollBar.HandleEvent(event)) return true;
+		if (m_hScrollBar.HandleEvent(event)) return true;
+
+		if (HandleMouseCursor(event)) return true;
+		if (HandleMouse(event)) return true;
+		if (HandleInputText(event)) return true;
+		if (HandleShortKey(event)) return true;
+
+		if (BaseComponent::HandleEvent(event)) return true;
+
+		return false;
+	}
+
+	void TextEdit::Update() {
+		SG_CMP_UPDATE_CONDITIONS;
+
+		BaseComponent::Update();
+
+		m_lineHeight = static_cast<float>(GetFont().GetHeight());
+		UpdateScrollBars();
+		UpdateCaret();
+		UpdateLineCaches();
+		UpdateSelectionRects();
+
+		// update caret
+		Vec2 origin = GetTextOrigin();
+		m_caret.GetGlobalRect().position.x = origin.x + m_caretX;
+		m_caret.GetGlobalRect().position.y = origin.y + m_caretLine * m_lineHeight;
+		m_caret.GetGlobalRect().size.h = m_lineHeight;
+		m_caret.Update();
+	}
+
+	void TextEdit::Render(Renderer& renderer) {
+		SG_CMP_RENDER_CONDITIONS;
+
+		// draw bg
+		renderer.RenderRect(m_visibleGRect, GetThemeColor(ThemeColorFlags::TextEditBackground), true);
+
+		Rect textClipGRect = m_textViewGRect.GetIntersection(m_visibleGRect);
+		if (!textClipGRect.size.IsZeroApprox()) {
+			renderer.SetRenderClipRect(textClipGRect);
+
+			// draw selection
+			Color selectedColor = GetThemeColor(ThemeColorFlags::TextEditSelectedBackground);
+			for (const auto& rect : m_selectionGRects) {
+				renderer.RenderRect(rect, selectedColor, true);
+			}
+
+			// draw visible lines
+			Vec2 origin = GetTextOrigin();
+			Color fgColor = GetThemeColor(ThemeColorFlags::TextEditForeground);
+			for (size_t line = m_firstVisibleLine; line <= m_lastVisibleLine; ++line) {
+				auto it = m_lineCaches.find(line);
+				if (it == m_lineCaches.end()) continue;
+				renderer.RenderText(it->second.text.get(), Vec2(origin.x, origin.y + line * m_lineHeight), fgColor);
+			}
+
+			// draw caret
+			m_caret.SetColor(GetThemeColor(ThemeColorFlags::TextEditCaret));
+			m_caret.Render(renderer);
+
+			renderer.ClearRenderClipRect();
+		}
+
+		// draw scrollbars
+		auto GetSliderColor = [this](MouseState state, ThemeColorFlags normal, ThemeColorFlags hovered, ThemeColorFlags pressed) {
+			if (state == MouseState::Pressed) return GetThemeColor(pressed);
+			if (state == MouseState::Hovering) return GetThemeColor(hovered);
+			return GetThemeColor(normal);
+			};
+		m_vScrollBar.Render(renderer, GetThemeColor(ThemeColorFlags::ScrollbarSlot_V),
+			GetSliderColor(m_vScrollBar.GetSliderState(), ThemeColorFlags::ScrollbarSlider_V,
+				ThemeColorFlags::ScrollbarSliderHovered_V, ThemeColorFlags::ScrollbarSliderPressed_V));
+		m_hScrollBar.Render(renderer, GetThemeColor(ThemeColorFlags::ScrollbarSlot_H),
+			GetSliderColor(m_hScrollBar.GetSliderState(), ThemeColorFlags::ScrollbarSlider_H,
+				ThemeColorFlags::ScrollbarSliderHovered_H, ThemeColorFlags::ScrollbarSliderPressed_H));
+
+		// draw border
+		renderer.SetRenderClipRect(m_visibleGRect);
+		Color borderColor = m_active ? GetThemeColor(ThemeColorFlags::TextEditActivatedBorder) : GetThemeColor(ThemeColorFlags::TextEditBorder);
+		renderer.RenderRect(GetGlobalRect(), borderColor, false);
+		renderer.ClearRenderClipRect();
+
+		BaseComponent::Render(renderer);
+	}
+
+	Vec2 TextEdit::GetTextOrigin() const {
+		return Vec2(m_textViewGRect.Left() - m_hScrollBar.GetOffset(), m_textViewGRect.Top() - m_vScrollBar.GetOffset());
+	}
+
+	float TextEdit::GetColumnX(size_t line, size_t column) {
+		if (column == 0) return 0;
+		m_document.GetLineText(line, m_lineBuffer);
+		return GetFont().GetTextSize(m_lineBuffer, column).w;
+	}
+
+	size_t TextEdit::MapXToColumn(size_t line, float x) {
+		m_document.GetLineText(line, m_lineBuffer);
+		if (x <= 0 || m_lineBuffer.empty()) return 0;
+
+		int w = 0;
+		size_t length = 0;
+		TTF_MeasureString(&GetFont().GetTTFFont(), m_lineBuffer.c_str(), m_lineBuffer.length(), static_cast<int>(x), &w, &length);
+		if (length >= m_lineBuffer.length()) return m_lineBuffer.length();
+
+		// 超过下一个字符宽度的一半时，光标位于该字符之后
+		auto it = m_lineBuffer.begin() + length;
+		utf8::next(it, m_lineBuffer.end());
+		size_t next = it - m_lineBuffer.begin();
+		float nextW = GetFont().GetTextSize(m_lineBuffer, next).w;
+		return x - w > (nextW - w) / 2 ? next : length;
+	}
+
+	size_t TextEdit::MapPositionToOffset(const Vec2& pos) {
+		Vec2 origin = GetTextOrigin();
+		float y = (pos.y - origin.y) / m_lineHeight;
+		size_t line = y > 0 ? static_cast<size_t>(y) : 0;
+		line = SDL_min(line, m_document.GetLineCount() - 1);
+		return m_document.GetLineStart(line) + MapXToColumn(line, pos.x - origin.x);
+	}
+
+	size_t TextEdit::GetPrevCharOffset(size_t offset) {
+		if (offset == 0) return 0;
+
+		size_t line = m_document.GetLineFromOffset(offset);
+		size_t start = m_document.GetLineStart(line);
+		if (offset == start) return offset - 1;
+
+		m_document.GetLineText(line, m_lineBuffer);
+		auto it = m_lineBuffer.begin() + (offset - start);
+		utf8::prior(it, m_lineBuffer.begin());
+		return start + (it - m_lineBuffer.begin());
+	}
+
+	size_t TextEdit::GetNextCharOffset(size_t offset) {
+		if (offset >= m_document.GetLength()) return m_document.GetLength();
+
+		size_t line = m_document.GetLineFromOffset(offset);
+		size_t start = m_document.GetLineStart(line);
+		if (offset - start >= m_document.GetLineLength(line)) return offset + 1;
+
+		m_document.GetLineText(line, m_lineBuffer);
+		auto it = m_lineBuffer.begin() + (offset - start);
+		utf8::next(it, m_lineBuffer.end());
+		return start + (it - m_lineBuffer.begin());
+	}
+
+	void TextEdit::MoveCaret(size_t offset, bool select, bool keepPreferredX) {
+		m_caretOffset = SDL_min(offset, m_document.GetLength());
+		if (!select) m_anchorOffset = m_caretOffset;
+		if (!keepPreferredX) m_preferredCaretX = -1;
+		m_caretDirty = true;
+		m_ensureCaretVisible = true;
+		if (m_active) m_caret.SetVisible(true);
+	}
+
+	void TextEdit::MoveCaretVertically(long long lines, bool select) {
+		if (m_caretDirty) UpdateCaret();
+		if (m_preferredCaretX < 0) m_preferredCaretX = m_caretX;
+
+		long long line = static_cast<long long>(m_caretLine) + lines;
+		line = SDL_clamp(line, 0, static_cast<long long>(m_document.GetLineCount()) - 1);
+		size_t offset = m_document.GetLineStart(line) + MapXToColumn(line, m_preferredCaretX);
+		MoveCaret(offset, select, true);
+	}
+
+	void TextEdit::EraseRange(size_t offset, size_t length) {
+		size_t lineCount = m_document.GetLineCount();
+		size_t line = m_document.GetLineFromOffset(offset);
+		m_document.Erase(offset, length);
+		InvalidateLines(line, lineCount != m_document.GetLineCount());
+	}
+
+	void TextEdit::InvalidateLines(size_t line, bool lineCountChanged) {
+		// 行数变化时，之后所有行的行号都已改变
+		if (lineCountChanged) {
+			std::erase_if(m_lineCaches, [line](const auto& item) { return item.first >= line; });
+		}
+		else {
+			m_lineCaches.erase(line);
+		}
+		m_caretDirty = true;
+	}
+
+	void TextEdit::UpdateScrollBars() {
+		Rect gRect = GetGlobalRect();
+		Rect contentGRect = GetContentGlobalRect();
+		float thickness = m_vScrollBar.GetThickness();
+		float contentH = m_document.GetLineCount() * m_lineHeight;
+
+		bool vNeeded = contentH > contentGRect.size.h;
+		bool hNeeded = m_contentWidth > contentGRect.size.w - (vNeeded ? thickness : 0);
+		if (!vNeeded && hNeeded) vNeeded = contentH > contentGRect.size.h - thickness;
+
+		m_textViewGRect = contentGRect;
+		if (vNeeded) m_textViewGRect.size.w = SDL_max(m_textViewGRect.size.w - thickness, 0.f);
+		if (hNeeded) m_textViewGRect.size.h = SDL_max(m_textViewGRect.size.h - thickness, 0.f);
+
+		m_vScrollBar.Update(Rect(gRect.Right() - thickness, gRect.Top(), thickness, gRect.size.h - (hNeeded ? thickness : 0)),
+			m_visibleGRect, contentH, m_textViewGRect.size.h);
+		m_hScrollBar.Update(Rect(gRect.Left(), gRect.Bottom() - thickness, gRect.size.w - (vNeeded ? thickness : 0), thickness),
+			m_visibleGRect, m_contentWidth, m_textViewGRect.size.w);
+	}
+
+	void TextEdit::UpdateLineCaches() {
+		size_t lineCount = m_document.GetLineCount();
+		m_firstVisibleLine = static_cast<size_t>(m_vScrollBar.GetOffset() / m_lineHeight);
+		m_lastVisibleLine = static_cast<size_t>((m_vScrollBar.GetOffset() + m_textViewGRect.size.h) / m_lineHeight);
+		m_firstVisibleLine = SDL_min(m_firstVisibleLine, lineCount - 1);
+		m_lastVisibleLine = SDL_min(m_lastVisibleLine, lineCount - 1);
+
+		// 移除不可见行的缓存
+		std::erase_if(m_lineCaches, [this](const auto& item) {
+			return item.first < m_firstVisibleLine || item.first > m_lastVisibleLine;
+			});
+
+		for (size_t line = m_firstVisibleLine; line <= m_lastVisibleLine; ++line) {
+			if (m_lineCaches.contains(line)) continue;
+
+			m_document.GetLineText(line, m_lineBuffer);
+			auto text = TTF_CreateText(&m_window->GetTTFTextEngine(), &GetFont().GetTTFFont(), m_lineBuffer.c_str(), m_lineBuffer.length());
+			int w = 0, h = 0;
+			TTF_GetTextSize(text, &w, &h);
+			m_contentWidth = SDL_max(m_contentWidth, w + m_caret.GetGlobalRect().size.w);
+			m_lineCaches.emplace(line, LineCache{ UniqueTextPtr(text), static_cast<float>(w) });
+		}
+	}
+
+	void TextEdit::UpdateCaret() {
+		if (m_caretDirty) {
+			m_caretLine = m_document.GetLineFromOffset(m_caretOffset);
+			m_caretX = GetColumnX(m_caretLine, m_caretOffset - m_document.GetLineStart(m_caretLine));
+			m_caretDirty = false;
+		}
+
+		if (!m_ensureCaretVisible) return;
+		m_ensureCaretVisible = false;
+
+		float caretW = m_caret.GetGlobalRect().size.w;
+		if (m_caretX + caretW > m_contentWidth) {
+			m_contentWidth = m_caretX + caretW;
+			UpdateScrollBars();
+		}
+
+		float caretY = m_caretLine * m_lineHeight;
+		if (caretY < m_vScrollBar.GetOffset()) {
+			m_vScrollBar.SetOffset(caretY);
+		}
+		else if (caretY + m_lineHeight > m_vScrollBar.GetOffset() + m_textViewGRect.size.h) {
+			m_vScrollBar.SetOffset(caretY + m_lineHeight - m_textViewGRect.size.h);
+		}
+
+		if (m_caretX < m_hScrollBar.GetOffset()) {
+			m_hScrollBar.SetOffset(m_caretX);
+		}
+		else if (m_caretX + caretW > m_hScrollBar.GetOffset() + m_textViewGRect.size.w) {
+			m_hScrollBar.SetOffset(m_caretX + caretW - m_textViewGRect.size.w);
+		}
+
+		// 偏移量已改变，重新计算滑块位置
+		UpdateScrollBars();
+	}
+
+	void TextEdit::UpdateSelectionRects() {
+		m_selectionGRects.clear();
+		if (!HasSelection()) return;
+
+		size_t selStart = SDL_min(m_anchorOffset, m_caretOffset);
+		size_t selEnd = SDL_max(m_anchorOffset, m_caretOffset);
+		Vec2 origin = GetTextOrigin();
+
+		for (size_t line = m_firstVisibleLine; line <= m_lastVisibleLine; ++line) {
+			size_t lineStart = m_document.GetLineStart(line);
+			size_t lineEnd = lineStart + m_document.GetLineLength(line);
+			if (selEnd < lineStart) break;
+			if (selStart > lineEnd) continue;
+
+			size_t start = SDL_max(selStart, lineStart) - lineStart;
+			size_t end = SDL_min(selEnd, lineEnd) - lineStart;
+			m_document.GetLineText(line, m_lineBuffer);
+			float x1 = start ? GetFont().GetTextSize(m_lineBuffer, start).w : 0;
+			float x2 = end ? GetFont().GetTextSize(m_lineBuffer, end).w : 0;
+			// 选中换行符
+			if (selEnd > lineEnd) x2 += m_lineHeight / 4;
+			if (x2 <= x1) continue;
+
+			m_selectionGRects.emplace_back(origin.x + x1, origin.y + line * m_lineHeight, x2 - x1, m_lineHeight);
+		}
+	}
+
+	bool TextEdit::HandleMouseCursor(Event* event) const {
+		if (auto ev = event->Convert<MouseMotionEvent>()) {
+			if (m_textViewGRect.GetIntersection(m_visibleGRect).ContainPoint(ev->GetPosition())) {
+				SDL_SetCursor(m_cursor.get());
+			}
+			else if (SDL_GetCursor() == m_cursor.get()) {
+				SDL_SetCursor(SDL_GetDefaultCursor());
+			}
+		}
+		return false;
+	}
+
+	bool TextEdit::HandleMouse(Event* event) {
+		if (auto ev = event->Convert<MouseButtonEvent>()) {
+			if (ev->IsPressed(MouseButton::Left)) {
+				bool inside = m_visibleGRect.ContainPoint(ev->GetPosition());
+				if (inside != m_active) {
+					m_active = inside;
+					if (m_active) SDL_StartTextInput(&m_window->GetSDLWindow());
+					else SDL_StopTextInput(&m_window->GetSDLWindow());
+					m_caret.SetVisible(m_active);
+				}
+				if (!inside) return false;
+
+				// set IME composition window positon
+				IMEUtils::SetIMECompositionWindowPosition(*m_window, m_caret.GetGlobalRect().BottomLeft());
+
+				bool shift = (SDL_GetModState() & SDL_KMOD_SHIFT) != 0;
+				MoveCaret(MapPositionToOffset(ev->GetPosition()), shift);
+				m_selecting = true;
+				return true;
+			}
+
+			if (ev->IsReleased(MouseButton::Left) && m_selecting) {
+				m_selecting = false;
+				return true;
+			}
+		}
+		else if (auto ev = event->Convert<MouseMotionEvent>()) {
+			if (m_selecting) {
+				MoveCaret(MapPositionToOffset(ev->GetPosition()), true);
+				return true;
+			}
+		}
+		else if (auto ev = event->Convert<MouseWheelEvent>()) {
+			if (m_visibleGRect.ContainPoint(ev->GetPosition())) {
+				m_vScrollBar.ScrollBy(-ev->GetDirection().y * m_lineHeight * 3);
+				m_hScrollBar.ScrollBy(ev->GetDirection().x * m_lineHeight * 3);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool TextEdit::HandleInputText(Event* event) {
+		if (!m_active || !m_editable) return false;
+
+		if (auto ev = event->Convert<KeyBoardTextInputEvent>()) {
+			InsertText(ev->GetInputText());
+			return true;
+		}
+
+		return false;
+	}
+
+	bool TextEdit::HandleShortKey(Event* event) {
+		if (!m_active) return false;
+
+		auto ev = event->Convert<KeyBoardButtonEvent>();
+		if (!ev || !ev->IsPressed()) return false;
+
+		bool shift = (ev->GetKeyMod() & SDL_KMOD_SHIFT) != 0;
+		bool ctrl = (ev->GetKeyMod() & SDL_KMOD_CTRL) != 0;
+		size_t selStart = SDL_min(m_anchorOffset, m_caretOffset);
+		size_t selEnd = SDL_max(m_anchorOffset, m_caretOffset);
+
+		switch (ev->GetKeyCode()) {
+		case SDLK_BACKSPACE:
+		case SDLK_DELETE: {
+			if (!m_editable) return false;
+			if (!HasSelection()) {
+				bool backspace = ev->GetKeyCode() == SDLK_BACKSPACE;
+				size_t offset = backspace ? GetPrevCharOffset(m_caretOffset) : GetNextCharOffset(m_caretOffset);
+				if (offset == m_caretOffset) return true;
+				m_anchorOffset = offset;
+			}
+			InsertText("");
+			return true;
+		}
+
+		case SDLK_RETURN:
+		case SDLK_KP_ENTER: {
+			if (!m_editable) return false;
+			InsertText("\n");
+			return true;
+		}
+
+		case SDLK_LEFT: {
+			MoveCaret(HasSelection() && !shift ? selStart : GetPrevCharOffset(m_caretOffset), shift);
+			return true;
+		}
+
+		case SDLK_RIGHT: {
+			MoveCaret(HasSelection() && !shift ? selEnd : GetNextCharOffset(m_caretOffset), shift);
+			return true;
+		}
+
+		case SDLK_UP: {
+			MoveCaretVertically(-1, shift);
+			return true;
+		}
+
+		case SDLK_DOWN: {
+			MoveCaretVertically(1, shift);
+			return true;
+		}
+
+		case SDLK_PAGEUP:
+		case SDLK_PAGEDOWN: {
+			long long lines = SDL_max(static_cast<long long>(m_textViewGRect.size.h / m_lineHeight), 1LL);
+			MoveCaretVertically(ev->GetKeyCode() == SDLK_PAGEUP ? -lines : lines, shift);
+			return true;
+		}
+
+		case SDLK_HOME: {
+			size_t line = m_document.GetLineFromOffset(m_caretOffset);
+			MoveCaret(ctrl ? 0 : m_document.GetLineStart(line), shift);
+			return true;
+		}
+
+		case SDLK_END: {
+			size_t line = m_document.GetLineFromOffset(m_caretOffset);
+			MoveCaret(ctrl ? m_document.GetLength() : m_document.GetLineStart(line) + m_document.GetLineLength(line), shift);
+			return true;
+		}
+		}
+
+		if (ev->IsCtrlAnd(SDLK_A)) {
+			SelectAll();
+			return true;
+		}
+		else if (ev->IsCtrlAnd(SDLK_C) || ev->IsCtrlAnd(SDLK_X)) {
+			if (!HasSelection()) return false;
+			SDL_SetClipboardText(GetSelectedText().c_str());
+			if (ev->GetKeyCode() == SDLK_X && m_editable) InsertText("");
+			return true;
+		}
+		else if (ev->IsCtrlAnd(SDLK_V)) {
+			if (!m_editable) return false;
+			char* clipboard = SDL_GetClipboardText();
+			std::string text = clipboard;
+			SDL_free(clipboard);
+			std::erase(text, '\r');
+			InsertText(text);
+			return true;
+		}
+
+		return false;
+	}
+}
@@ -48,8 +48,13 @@ namespace SimpleGui {
 
 		renderer.SetRenderClipRect(m_visibleGRect);
 		if (m_texture && !m_texture->IsNull()) {
-			Rect rect(0, 0, m_texture->GetWidth(), m_texture->GetHeight());
-			renderer.RenderTexture(m_texture.get(), rect, m_textureGRect, 0, rect.Center(), m_flipMode);
+			if (m_textureStretchMode == TextureStretchMode::Tile) {
+				renderer.RenderTiledTexture(m_texture.get(), m_textureGRect, m_visibleGRect, m_flipMode);
+			}
+			else {
+				Rect rect(0, 0, m_texture->GetWidth(), m_texture->GetHeight());
+				renderer.RenderTexture(m_texture.get(), rect, m_textureGRect, 0, rect.Center(), m_flipMode);
+			}
 		}
 		m_tipLbl->CustomThemeColor(ThemeColorFlags::LabelForeground, GetThemeColor(ThemeColorFlags::Foreground));
 		m_tipLbl->Render(renderer);
@@ -69,8 +74,8 @@ namespace SimpleGui {
 		SetupTipLabel();
 	}
 
-	void TextureRect::SetTexture(std::string_view path) {
-		m_texture = SG_GuiManager.GetWindow().GetRenderer().CreateSharedTexture(path);
+	void TextureRect::SetTexture(std::string_view path, bool mipmaps) {
+		m_texture = SG_GuiManager.GetWindow().GetRenderer().CreateSharedTexture(path, mipmaps);
 		SetScaleMode(m_scaleMode);
 		SetupTipLabel();
 	}
@@ -86,7 +91,7 @@ namespace SimpleGui {
 	void TextureRect::SetScaleMode(TextureScaleMode mode) {
 		if (!m_texture || m_texture->IsNull()) return;
 		const auto sdlMode = mode == TextureScaleMode::Linear ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST;
-		SDL_SetTextureScaleMode(&m_texture->GetSDLTexture(), sdlMode);
+		m_texture->SetScaleMode(sdlMode);
 		m_scaleMode = mode;
 	}
 
@@ -172,24 +177,4 @@ namespace SimpleGui {
 				break;
 		}
 	}
-
-	void TextureRect::RenderTexture(SDL_Renderer *renderer) const {
-		SDL_FRect rect = m_textureGRect.ToSDLFRect();
-
-		if (m_textureStretchMode == TextureStretchMode::Tile) {
-			for (int i = 0; i < rect.w;) {
-				for (int j = 0; j < rect.h;) {
-					SDL_FRect tileRect = {
-						static_cast<float>(i), static_cast<float>(j), m_texture->GetWidth(), m_texture->GetHeight()
-					};
-					SDL_RenderTextureRotated(renderer, &m_texture->GetSDLTexture(), NULL, &tileRect, 0, NULL,
-					                         m_flipMode);
-					j += m_texture->GetHeight();
-				}
-				i += m_texture->GetWidth();
-			}
-		} else {
-			SDL_RenderTextureRotated(renderer, &m_texture->GetSDLTexture(), NULL, &rect, 0, NULL, m_flipMode);
-		}
-	}
 }
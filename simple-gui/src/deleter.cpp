@@ -1,4 +1,5 @@
 #include "deleter.hpp"
+#include "renderer.hpp"
 
 
 namespace SimpleGui {
@@ -24,6 +25,6 @@ namespace SimpleGui {
 
 	void TextureDeleter::operator()(SDL_Texture* texture) const noexcept {
 		if (!texture) return;
-		SDL_DestroyTexture(texture);
+		Renderer::DestroyTexture(texture);
 	}
 }
\ No newline at end of file
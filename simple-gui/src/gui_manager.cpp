@@ -21,6 +21,7 @@ namespace SimpleGui {
 		m_eventManager.reset();
 		m_window.reset();
 		m_timerManager.reset();
+		m_jobSystem.reset();
 	}
 
 	void GuiManager::Init(int argc, char** argv, std::string_view fontPath) {
@@ -47,6 +48,7 @@ namespace SimpleGui {
 		s_guiManager->m_eventManager = std::make_unique<EventManager>(s_guiManager->m_window.get());
 		s_guiManager->m_fpsController = std::make_unique<FrameRateController>(s_guiManager->m_window.get());
 		s_guiManager->m_timerManager = std::make_unique<TimerManager>();
+		s_guiManager->m_jobSystem = std::make_unique<JobSystem>();
 
 		//SDL_SetHint(SDL_HINT_IME_IMPLEMENTED_UI, "composition");
 		SG_INFO("SimpleGui: gui manager initialization successful.");
@@ -0,0 +1,106 @@
+#include "job_system.hpp"
+
+
+namespace SimpleGui {
+	namespace {
+		thread_local size_t s_queueIndex = 0;
+	}
+
+	bool JobSystem::WorkQueue::Push(const Job& job) {
+		std::lock_guard lock(mutex);
+		if (tail - head == CAPACITY) return false;
+		jobs[tail++ % CAPACITY] = job;
+		return true;
+	}
+
+	bool JobSystem::WorkQueue::Pop(Job& job) {
+		std::lock_guard lock(mutex);
+		if (tail == head) return false;
+		job = jobs[--tail % CAPACITY];
+		return true;
+	}
+
+	bool JobSystem::WorkQueue::Steal(Job& job) {
+		std::lock_guard lock(mutex);
+		if (tail == head) return false;
+		job = jobs[head++ % CAPACITY];
+		return true;
+	}
+
+	JobSystem::JobSystem(size_t workerCount) {
+		if (workerCount == 0) {
+			unsigned int hardwareCount = std::thread::hardware_concurrency();
+			workerCount = hardwareCount > 1 ? hardwareCount - 1 : 0;
+		}
+
+		m_queueCount = workerCount + 1;
+		m_queues = std::make_unique<WorkQueue[]>(m_queueCount);
+		m_threads.reserve(workerCount);
+		for (size_t i = 0; i < workerCount; ++i) {
+			m_threads.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+		}
+	}
+
+	JobSystem::~JobSystem() {
+		{
+			std::lock_guard lock(m_sleepMutex);
+			m_running.store(false);
+		}
+		m_sleepCondition.notify_all();
+
+		for (auto& thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	void JobSystem::Dispatch(size_t count, JobFunction fn, void* context) {
+		std::atomic<size_t> remaining{ count };
+		size_t self = s_queueIndex;
+
+		// 任务平均分到各个队列，工作线程不需要一开始就窃取；队列已满时直接在调用线程执行
+		for (size_t i = 0; i < count; ++i) {
+			m_queuedJobs.fetch_add(1);
+			if (m_queues[(self + i) % m_queueCount].Push({ fn, context, i, &remaining })) continue;
+
+			m_queuedJobs.fetch_sub(1);
+			fn(context, i);
+			remaining.fetch_sub(1, std::memory_order_release);
+		}
+
+		{
+			std::lock_guard lock(m_sleepMutex);
+		}
+		m_sleepCondition.notify_all();
+
+		// 等待期间继续执行自己队列中的任务或窃取其他队列的任务
+		while (remaining.load(std::memory_order_acquire) > 0) {
+			if (!TryRunJob(self)) std::this_thread::yield();
+		}
+	}
+
+	bool JobSystem::TryRunJob(size_t queueIndex) {
+		Job job{};
+		bool found = m_queues[queueIndex].Pop(job);
+		for (size_t i = 1; !found && i < m_queueCount; ++i) {
+			found = m_queues[(queueIndex + i) % m_queueCount].Steal(job);
+		}
+		if (!found) return false;
+
+		m_queuedJobs.fetch_sub(1);
+		job.fn(job.context, job.index);
+		// 计数归零后提交者可能立即返回，此后不能再访问remaining
+		job.remaining->fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void JobSystem::WorkerLoop(size_t queueIndex) {
+		s_queueIndex = queueIndex;
+
+		while (m_running.load()) {
+			if (TryRunJob(queueIndex)) continue;
+
+			std::unique_lock lock(m_sleepMutex);
+			m_sleepCondition.wait(lock, [this] { return m_queuedJobs.load() > 0 || !m_running.load(); });
+		}
+	}
+}
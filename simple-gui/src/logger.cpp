@@ -1,7 +1,5 @@
 #include "logger.hpp"
-#include <chrono>
 #include <ctime>
-#include <fstream>
 
 
 #ifdef _WIN32
@@ -14,18 +12,51 @@ constexpr WORD WHITE = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE;
 
 
 namespace SimpleGui {
+    Logger::RingBuffer::RingBuffer() {
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY 必须是2的幂");
+        m_cells = std::make_unique<Cell[]>(CAPACITY);
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    Logger::Logger() {
+        m_thread = std::thread(&Logger::Run, this);
+    }
+
+    Logger::~Logger() {
+        m_running.store(false);
+        if (m_thread.joinable()) m_thread.join();
+    }
+
     Logger & Logger::GetInstance() {
         static Logger instance{};
         return instance;
     }
 
     void Logger::Setup(bool consoleLog, bool retainLog) {
-        m_consoleLog = consoleLog;
-        m_retainLogs = retainLog;
+        m_consoleLog.store(consoleLog);
+        m_retainLogs.store(retainLog);
+    }
+
+    bool Logger::SetLogFile(const std::string &path) {
+        std::lock_guard lock(m_mutex);
+        if (m_logFile.is_open()) m_logFile.close();
+        if (path.empty()) return true;
+        m_logFile.open(path, std::ios::app);
+        return m_logFile.is_open();
+    }
+
+    std::vector<LogAEntry> Logger::GetLogEntries() const {
+        Flush();
+        std::lock_guard lock(m_mutex);
+        return m_logEntries;
     }
 
     bool Logger::SaveToFile(const std::string &filePath) const {
+        Flush();
         if (std::ofstream file(filePath); file.is_open()) {
+            std::lock_guard lock(m_mutex);
             for (const auto&[_, message]: m_logEntries) {
                 file << message;
             }
@@ -36,25 +67,96 @@ namespace SimpleGui {
     }
 
     void Logger::Clear() {
+        Flush();
+        std::lock_guard lock(m_mutex);
         m_logEntries.clear();
     }
 
-    Logger::LogTime::LogTime(const std::string &date)
-        : day(date.substr(0, 3)), dayNumber(date.substr(8, 2)), month(date.substr(4, 3)),
-          year(date.substr(20, 4)), time(date.substr(11, 8)) {}
+    void Logger::Flush() const {
+        size_t target = m_queue.GetEnqueuePosition();
+        while (m_processed.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+        }
+    }
 
-    std::string Logger::CurrentDateTime() const {
-        auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    void Logger::FormatPreformatted(std::string_view, void *args, std::string &out) {
+        auto message = static_cast<std::string*>(args);
+        out = std::move(*message);
+        std::destroy_at(message);
+    }
 
-        char buffer[32];
-        ctime_s(buffer, sizeof(buffer), &time);
+    void Logger::Run() {
+        // 复用缓冲区，后台线程输出日志时同样不产生额外的分配
+        std::string message;
+        std::string line;
+        size_t reportedDropped = 0;
+
+        for (;;) {
+            bool popped = m_queue.TryPop([&](LogRecord &record) { Write(record, message, line); });
+            if (popped) {
+                m_processed.fetch_add(1, std::memory_order_release);
+                continue;
+            }
+
+            if (size_t dropped = m_dropped.load(std::memory_order_relaxed); dropped != reportedDropped) {
+                line = std::format("SimpleGui [WARN]: {} log messages dropped, the log queue is full\n", dropped - reportedDropped);
+                reportedDropped = dropped;
+                OutputToConsole(LogLevel::Warn, line);
+            }
 
-        LogTime logTime{ std::string(buffer) };
-        return std::format("{0}-{1}-{2} {3}", logTime.year, logTime.month, logTime.dayNumber, logTime.time);
+            if (!m_running.load()) {
+                // 退出前输出已经进入队列的日志，包括其他线程已占位、还未写完的记录
+                if (m_processed.load(std::memory_order_relaxed) >= m_queue.GetEnqueuePosition()) break;
+                std::this_thread::yield();
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void Logger::Write(LogRecord &record, std::string &message, std::string &line) {
+        record.formatFn(record.format, record.args, message);
+
+        line.clear();
+        switch (record.level) {
+            case LogLevel::Info: line += "SimpleGui [INFO]: "; break;
+            case LogLevel::Warn: line += "SimpleGui [WARN]: "; break;
+            default: line += "SimpleGui [ERROR]: "; break;
+        }
+        FormatDateTime(record.time, line);
+        line += " - ";
+        line += message;
+        if (record.level == LogLevel::Error) {
+            std::format_to(std::back_inserter(line), "\nFUNC: {}\nLINE: {}\n\n",
+                           record.location.function_name(), record.location.line());
+        }
+        else {
+            line += "\n";
+        }
+
+        OutputToConsole(record.level, line);
+
+        bool retain = m_retainLogs.load();
+        std::lock_guard lock(m_mutex);
+        if (m_logFile.is_open()) m_logFile << line << std::flush;
+        if (retain) m_logEntries.emplace_back(record.level, line);
+    }
+
+    void Logger::FormatDateTime(std::chrono::system_clock::time_point time, std::string &out) {
+        auto t = std::chrono::system_clock::to_time_t(time);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        char buffer[32];
+        size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%b-%d %H:%M:%S", &tm);
+        out.append(buffer, length);
     }
 
     void Logger::OutputToConsole(LogLevel level, const std::string &message) const {
-        if (!m_consoleLog) return;
+        if (!m_consoleLog.load()) return;
 
 #ifdef _WIN32
         WORD color = level == LogLevel::Info ? GREEN : (level == LogLevel::Warn ? YELLOW : RED);
@@ -62,11 +164,9 @@ namespace SimpleGui {
         SetConsoleTextAttribute(hConsole, color);
         std::cout << message;
         SetConsoleTextAttribute(hConsole, WHITE);
+#else
+        (void)level;
+        std::cout << message;
 #endif
     }
-
-    void Logger::RetainLogs(LogLevel level, const std::string &message) {
-        if (!m_retainLogs) return;
-        m_logEntries.emplace_back(level, message);
-    }
 }
@@ -0,0 +1,63 @@
+#include "mipmap.hpp"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SG_MIPMAP_SSE2
+#endif
+#include "gui_manager.hpp"
+
+
+namespace SimpleGui {
+	namespace {
+		constexpr int ROWS_PER_JOB = 32;
+
+		// row0和row1是源图像中相邻的两行，row1可以与row0相同
+		void DownscaleRow(const uint8* row0, const uint8* row1, int srcW, uint8* dst, int dstW) {
+			int x = 0;
+#ifdef SG_MIPMAP_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i bias = _mm_set1_epi16(2);
+			// 两行各读取4个源像素，扩展为16位后先纵向再横向相加，得到2个目标像素
+			for (; x + 1 < dstW && x * 2 + 3 < srcW; x += 2) {
+				__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+				__m128i sumLo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+				__m128i sumHi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+				__m128i first = _mm_add_epi16(sumLo, _mm_srli_si128(sumLo, 8));
+				__m128i second = _mm_add_epi16(sumHi, _mm_srli_si128(sumHi, 8));
+				__m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(first, second), bias), 2);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(sum, sum));
+			}
+#endif
+			for (; x < dstW; ++x) {
+				int x0 = x * 2 * 4;
+				int x1 = SDL_min(x * 2 + 1, srcW - 1) * 4;
+				for (int c = 0; c < 4; ++c) {
+					dst[x * 4 + c] = static_cast<uint8>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+				}
+			}
+		}
+	}
+
+	SDL_Surface* DownscaleSurfaceHalf(SDL_Surface* src) {
+		if (!src || SDL_BYTESPERPIXEL(src->format) != 4 || SDL_MUSTLOCK(src)) return nullptr;
+
+		int dstW = SDL_max(src->w / 2, 1);
+		int dstH = SDL_max(src->h / 2, 1);
+		SDL_Surface* dst = SDL_CreateSurface(dstW, dstH, src->format);
+		if (!dst) return nullptr;
+
+		const auto srcPixels = static_cast<const uint8*>(src->pixels);
+		const auto dstPixels = static_cast<uint8*>(dst->pixels);
+		size_t jobCount = static_cast<size_t>((dstH + ROWS_PER_JOB - 1) / ROWS_PER_JOB);
+		SG_GuiManager.GetJobSystem().ParallelFor(jobCount, [&](size_t job) {
+			int begin = static_cast<int>(job) * ROWS_PER_JOB;
+			int end = SDL_min(begin + ROWS_PER_JOB, dstH);
+			for (int y = begin; y < end; ++y) {
+				const uint8* row0 = srcPixels + static_cast<size_t>(y * 2) * src->pitch;
+				const uint8* row1 = srcPixels + static_cast<size_t>(SDL_min(y * 2 + 1, src->h - 1)) * src->pitch;
+				DownscaleRow(row0, row1, src->w, dstPixels + static_cast<size_t>(y) * dst->pitch, dstW);
+			}
+		});
+		return dst;
+	}
+}
@@ -1,13 +1,14 @@
 #include "renderer.hpp"
 #include <SDL3_image/SDL_image.h>
+#include <algorithm>
 #include "deleter.hpp"
 
 
 namespace SimpleGui {
 	class RenderCommandDataVisitor final {
 	public:
-		RenderCommandDataVisitor(SDL_Renderer* renderer, const SDL_Color& color) :
-			m_renderer(renderer), m_color(color) {
+		RenderCommandDataVisitor(SDL_Renderer* renderer, const SDL_Color& color, ShapeTessellator& tessellator) :
+			m_renderer(renderer), m_color(color), m_tessellator(tessellator) {
 		}
 		~RenderCommandDataVisitor() = default;
 
@@ -57,43 +58,26 @@ namespace SimpleGui {
 		}
 
 		void operator()(const RenderCircleCommandData& data) {
-			SDL_SetRenderDrawColor(m_renderer, m_color.r, m_color.g, m_color.b, m_color.a);
-			if (data.fill) {
-				std::vector<SDL_FPoint> points;
-				for (float y = -data.radius; y <= data.radius; y++) {
-					float x = (int)sqrt(data.radius * data.radius - y * y);
-					points.emplace_back(data.center.x - x, data.center.y + y);
-					points.emplace_back(data.center.x + x, data.center.y + y);
-				}
-				SDL_RenderLines(m_renderer, points.data(), points.size());
-			}
-			else {
-				float x = data.radius;
-				float y = 0;
-				float err = 0;
-
-				while (x >= y) {
-					SDL_FPoint points[8] = {
-						{data.center.x + x, data.center.y + y},
-						{data.center.x + y, data.center.y + x},
-						{data.center.x - y, data.center.y + x},
-						{data.center.x - x, data.center.y + y},
-						{data.center.x - x, data.center.y - y},
-						{data.center.x - y, data.center.y - x},
-						{data.center.x + y, data.center.y - x},
-						{data.center.x + x, data.center.y - y}
-					};
-
-					SDL_RenderPoints(m_renderer, points, 8);
-
-					y += 1;
-					err += 1 + 2 * y;
-					if (2 * (err - x) + 1 > 0) {
-						x -= 1;
-						err += 1 - 2 * x;
-					}
-				}
-			}
+			m_tessellator.Clear();
+			if (data.fill) m_tessellator.FillCircle(Vec2(data.center), data.radius, ToFColor(), data.antialias);
+			else m_tessellator.StrokeCircle(Vec2(data.center), data.radius, 1, ToFColor(), data.antialias);
+			RenderGeometry();
+		}
+
+		void operator()(const RenderArcCommandData& data) {
+			m_tessellator.Clear();
+			if (data.fill) m_tessellator.FillArc(Vec2(data.center), data.radius, data.startAngle, data.endAngle, ToFColor(), data.antialias);
+			else m_tessellator.StrokeArc(Vec2(data.center), data.radius, data.startAngle, data.endAngle, 1, ToFColor(), data.antialias);
+			RenderGeometry();
+		}
+
+		void operator()(const RenderRoundRectCommandData& data) {
+			m_tessellator.Clear();
+			Rect rect(data.rect);
+			// 轮廓线的中心在像素中心上，与SDL_RenderRect一样画在矩形内侧
+			if (data.fill) m_tessellator.FillRoundRect(rect, data.radius, ToFColor(), data.antialias);
+			else m_tessellator.StrokeRoundRect(Rect(rect.Left() + 0.5f, rect.Top() + 0.5f, rect.size.w - 1, rect.size.h - 1), data.radius - 0.5f, 1, ToFColor(), data.antialias);
+			RenderGeometry();
 		}
 
 		void operator()(const RenderTextureCommandData& data) {
@@ -110,12 +94,350 @@ namespace SimpleGui {
 			else SDL_SetRenderClipRect(m_renderer, &data.rect);
 		}
 
+		void operator()(const RenderTargetCommandData& data) {
+			SDL_SetRenderTarget(m_renderer, data.target);
+		}
+
+		void operator()(const RenderCopyTextureCommandData& data) {
+			SDL_SetTextureBlendMode(data.texture, data.blendMode);
+			SDL_RenderTexture(m_renderer, data.texture, &data.srcRect, &data.dstRect);
+		}
+
+		// 九宫格和平铺纹理由Renderer::ExecuteTexturedGeometryBatch合并绘制
+		void operator()(const RenderNineSliceCommandData&) {}
+		void operator()(const RenderTiledTextureCommandData&) {}
+
+		void operator()(const RenderClearRectCommandData& data) {
+			SDL_SetRenderDrawColor(m_renderer, m_color.r, m_color.g, m_color.b, m_color.a);
+			SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+			SDL_RenderFillRect(m_renderer, &data.rect);
+			SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
+		}
+
 	private:
 		SDL_Renderer* m_renderer;
 		SDL_Color m_color;
+		ShapeTessellator& m_tessellator;
+
+		SDL_FColor ToFColor() const {
+			return { m_color.r / 255.f, m_color.g / 255.f, m_color.b / 255.f, m_color.a / 255.f };
+		}
+
+		void RenderGeometry() const {
+			const auto& vertices = m_tessellator.GetVertices();
+			const auto& indices = m_tessellator.GetIndices();
+			if (indices.empty()) return;
+			SDL_RenderGeometry(m_renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+				indices.data(), static_cast<int>(indices.size()));
+		}
 	};
 
 
+	// 命令可能覆盖的范围。线条、轮廓等可能超出几何边界一个像素，范围向外扩展一个像素；范围未知时返回false
+	class RenderCommandBounds final {
+	public:
+		explicit RenderCommandBounds(Rect& bounds) : m_bounds(bounds) {}
+		~RenderCommandBounds() = default;
+
+		bool operator()(const RenderLineCommandData& data) const {
+			return SetBounds(SDL_min(data.start.x, data.end.x), SDL_min(data.start.y, data.end.y),
+				SDL_max(data.start.x, data.end.x), SDL_max(data.start.y, data.end.y), 1);
+		}
+
+		bool operator()(const RenderLinesCommandData& data) const {
+			if (data.points.empty()) return SetBounds(0, 0, 0, 0, 0);
+			float left = data.points[0].x, top = data.points[0].y, right = left, bottom = top;
+			for (const auto& point : data.points) {
+				left = SDL_min(left, point.x);
+				top = SDL_min(top, point.y);
+				right = SDL_max(right, point.x);
+				bottom = SDL_max(bottom, point.y);
+			}
+			return SetBounds(left, top, right, bottom, 1);
+		}
+
+		bool operator()(const RenderRectCommandData& data) const {
+			return SetBounds(data.rect, data.fill ? 0 : 1);
+		}
+
+		bool operator()(const RenderRectsCommandData& data) const {
+			if (data.rects.empty()) return SetBounds(0, 0, 0, 0, 0);
+			float left = data.rects[0].x, top = data.rects[0].y, right = left, bottom = top;
+			for (const auto& rect : data.rects) {
+				left = SDL_min(left, rect.x);
+				top = SDL_min(top, rect.y);
+				right = SDL_max(right, rect.x + rect.w);
+				bottom = SDL_max(bottom, rect.y + rect.h);
+			}
+			return SetBounds(left, top, right, bottom, data.fill ? 0 : 1);
+		}
+
+		bool operator()(const RenderTriangleCommandData& data) const {
+			return SetBounds(SDL_min(data.p1.x, SDL_min(data.p2.x, data.p3.x)), SDL_min(data.p1.y, SDL_min(data.p2.y, data.p3.y)),
+				SDL_max(data.p1.x, SDL_max(data.p2.x, data.p3.x)), SDL_max(data.p1.y, SDL_max(data.p2.y, data.p3.y)), 1);
+		}
+
+		bool operator()(const RenderCircleCommandData& data) const {
+			return SetBounds(data.center.x - data.radius, data.center.y - data.radius,
+				data.center.x + data.radius, data.center.y + data.radius, 1);
+		}
+
+		bool operator()(const RenderArcCommandData& data) const {
+			return SetBounds(data.center.x - data.radius, data.center.y - data.radius,
+				data.center.x + data.radius, data.center.y + data.radius, 1);
+		}
+
+		bool operator()(const RenderRoundRectCommandData& data) const {
+			return SetBounds(data.rect, data.fill && !data.antialias ? 0 : 1);
+		}
+
+		bool operator()(const RenderTextureCommandData& data) const {
+			// 旋转后的范围不再是目标矩形
+			if (data.angle != 0) return false;
+			return SetBounds(data.dstRect, 0);
+		}
+
+		bool operator()(const RenderTextCommandData& data) const {
+			int w = 0, h = 0;
+			if (!TTF_GetTextSize(data.text, &w, &h)) return false;
+			return SetBounds(data.pos.x, data.pos.y, data.pos.x + w, data.pos.y + h, 0);
+		}
+
+		bool operator()(const RenderClipCommandData&) const { return false; }
+		bool operator()(const RenderTargetCommandData&) const { return false; }
+
+		bool operator()(const RenderCopyTextureCommandData& data) const {
+			return SetBounds(data.dstRect, 0);
+		}
+
+		bool operator()(const RenderClearRectCommandData& data) const {
+			return SetBounds(data.rect, 0);
+		}
+
+		bool operator()(const RenderNineSliceCommandData& data) const {
+			return SetBounds(data.xs[0], data.ys[0], data.xs[3], data.ys[3], 0);
+		}
+
+		bool operator()(const RenderTiledTextureCommandData& data) const {
+			return SetBounds(data.rect, 0);
+		}
+
+	private:
+		Rect& m_bounds;
+
+		bool SetBounds(float left, float top, float right, float bottom, float margin) const {
+			m_bounds = Rect(left - margin, top - margin, right - left + margin * 2, bottom - top + margin * 2);
+			return true;
+		}
+
+		bool SetBounds(const SDL_FRect& rect, float margin) const {
+			return SetBounds(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h, margin);
+		}
+	};
+
+	static bool GetRenderCommandBounds(const RenderCommand& cmd, Rect& bounds) {
+		return std::visit(RenderCommandBounds(bounds), cmd.data);
+	}
+
+	// 两个范围只有边相接时不会绘制到同一个像素
+	static bool IsBoundsOverlapping(const Rect& a, const Rect& b) {
+		return a.Left() < b.Right() && b.Left() < a.Right() && a.Top() < b.Bottom() && b.Top() < a.Bottom();
+	}
+
+	// 把九宫格一个方向上的网格坐标限制在[min, max]内，纹理坐标在所在的分段内线性插值。网格完全位于范围外时返回false
+	static bool ClampNineSliceAxis(float (&pos)[4], float (&uv)[4], float min, float max) {
+		if (pos[3] <= min || pos[0] >= max || min >= max) return false;
+
+		float clampedPos[4], clampedUv[4];
+		for (int i = 0; i < 4; ++i) {
+			float p = std::clamp(pos[i], min, max);
+			int seg = 0;
+			while (seg < 2 && p > pos[seg + 1]) ++seg;
+			float len = pos[seg + 1] - pos[seg];
+			float t = len > 0 ? (p - pos[seg]) / len : 0;
+			clampedPos[i] = p;
+			clampedUv[i] = uv[seg] + (uv[seg + 1] - uv[seg]) * t;
+		}
+		std::copy(std::begin(clampedPos), std::end(clampedPos), pos);
+		std::copy(std::begin(clampedUv), std::end(clampedUv), uv);
+		return true;
+	}
+
+	// 记录时按裁剪矩形处理命令：填充矩形裁剪到裁剪矩形内，其他命令在范围完全位于裁剪矩形之外时剔除
+	class RenderCommandClipper final {
+	public:
+		enum class Result {
+			Keep,
+			Trimmed,
+			Culled
+		};
+
+		explicit RenderCommandClipper(const Rect& clipRect) : m_clipRect(clipRect) {}
+		~RenderCommandClipper() = default;
+
+		Result operator()(RenderRectCommandData& data) const {
+			if (!data.fill) return CullBounds(data);
+			return TrimRect(data.rect);
+		}
+
+		Result operator()(RenderRectsCommandData& data) const {
+			if (!data.fill) return CullBounds(data);
+
+			bool trimmed = false;
+			std::erase_if(data.rects, [this, &trimmed](SDL_FRect& rect) {
+				Result result = TrimRect(rect);
+				trimmed |= result != Result::Keep;
+				return result == Result::Culled;
+			});
+			if (data.rects.empty()) return Result::Culled;
+			return trimmed ? Result::Trimmed : Result::Keep;
+		}
+
+		Result operator()(RenderClearRectCommandData& data) const {
+			return TrimRect(data.rect);
+		}
+
+		Result operator()(RenderNineSliceCommandData& data) const {
+			bool trimmed = data.xs[0] < m_clipRect.Left() || data.xs[3] > m_clipRect.Right()
+				|| data.ys[0] < m_clipRect.Top() || data.ys[3] > m_clipRect.Bottom();
+			if (!ClampNineSliceAxis(data.xs, data.us, m_clipRect.Left(), m_clipRect.Right())) return Result::Culled;
+			if (!ClampNineSliceAxis(data.ys, data.vs, m_clipRect.Top(), m_clipRect.Bottom())) return Result::Culled;
+			return trimmed ? Result::Trimmed : Result::Keep;
+		}
+
+		// 平铺的原点不变，只缩小覆盖范围
+		Result operator()(RenderTiledTextureCommandData& data) const {
+			return TrimRect(data.rect);
+		}
+
+		template<typename T>
+		Result operator()(const T& data) const {
+			return CullBounds(data);
+		}
+
+	private:
+		Rect m_clipRect;
+
+		template<typename T>
+		Result CullBounds(const T& data) const {
+			Rect bounds;
+			if (!RenderCommandBounds(bounds)(data)) return Result::Keep;
+			return IsBoundsOverlapping(bounds, m_clipRect) ? Result::Keep : Result::Culled;
+		}
+
+		Result TrimRect(SDL_FRect& rect) const {
+			float left = SDL_max(rect.x, m_clipRect.Left());
+			float top = SDL_max(rect.y, m_clipRect.Top());
+			float right = SDL_min(rect.x + rect.w, m_clipRect.Right());
+			float bottom = SDL_min(rect.y + rect.h, m_clipRect.Bottom());
+			if (left >= right || top >= bottom) return Result::Culled;
+			if (left == rect.x && top == rect.y && right == rect.x + rect.w && bottom == rect.y + rect.h) return Result::Keep;
+
+			rect = { left, top, right - left, bottom - top };
+			return Result::Trimmed;
+		}
+	};
+
+	// 按字段计算命令的FNV-1a指纹，不包含结构体的填充字节；文本还包含其内容，因为TTF_Text会被原地修改
+	class RenderCommandHasher final {
+	public:
+		explicit RenderCommandHasher(Uint64& hash) : m_hash(hash) {}
+		~RenderCommandHasher() = default;
+
+		void operator()(const RenderLineCommandData& data) const { Add(data.start); Add(data.end); }
+		void operator()(const RenderLinesCommandData& data) const { AddBytes(data.points.data(), data.points.size() * sizeof(SDL_FPoint)); }
+		void operator()(const RenderRectCommandData& data) const { Add(data.rect); Add(data.fill); }
+		void operator()(const RenderRectsCommandData& data) const {
+			AddBytes(data.rects.data(), data.rects.size() * sizeof(SDL_FRect));
+			Add(data.fill);
+		}
+		void operator()(const RenderTriangleCommandData& data) const { Add(data.p1); Add(data.p2); Add(data.p3); Add(data.fill); }
+		void operator()(const RenderCircleCommandData& data) const {
+			Add(data.center); Add(data.radius); Add(data.fill); Add(data.antialias);
+		}
+		void operator()(const RenderArcCommandData& data) const {
+			Add(data.center); Add(data.radius); Add(data.startAngle); Add(data.endAngle); Add(data.fill); Add(data.antialias);
+		}
+		void operator()(const RenderRoundRectCommandData& data) const { Add(data.rect); Add(data.radius); Add(data.fill); Add(data.antialias); }
+		void operator()(const RenderNineSliceCommandData& data) const {
+			Add(data.texture); Add(data.xs); Add(data.ys); Add(data.us); Add(data.vs);
+		}
+		void operator()(const RenderTiledTextureCommandData& data) const {
+			Add(data.texture); Add(data.rect); Add(data.origin); Add(data.tileSize); Add(data.mode);
+		}
+		void operator()(const RenderTextureCommandData& data) const {
+			Add(data.texture); Add(data.srcRect); Add(data.dstRect); Add(data.angle); Add(data.center); Add(data.mode);
+		}
+		void operator()(const RenderTextCommandData& data) const {
+			Add(data.text);
+			Add(data.pos);
+			if (data.text && data.text->text) AddBytes(data.text->text, SDL_strlen(data.text->text));
+			// 切换字体或修改字体大小、样式后文本外观也会改变
+			if (TTF_Font* font = data.text ? TTF_GetTextFont(data.text) : nullptr) {
+				Add(font);
+				Add(TTF_GetFontGeneration(font));
+			}
+		}
+		void operator()(const RenderClipCommandData& data) const { Add(data.rect); Add(data.disable); }
+		void operator()(const RenderTargetCommandData& data) const { Add(data.target); }
+		void operator()(const RenderCopyTextureCommandData& data) const {
+			Add(data.texture); Add(data.srcRect); Add(data.dstRect); Add(data.blendMode);
+		}
+		void operator()(const RenderClearRectCommandData& data) const { Add(data.rect); }
+
+	private:
+		Uint64& m_hash;
+
+		void AddBytes(const void* data, size_t size) const {
+			auto bytes = static_cast<const uint8*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				m_hash = (m_hash ^ bytes[i]) * 1099511628211ull;
+			}
+		}
+
+		// 只用于没有填充字节的类型
+		template<typename T>
+		void Add(const T& value) const { AddBytes(&value, sizeof(T)); }
+	};
+
+	// 相同状态（命令类型、纹理、颜色）的相邻命令可以被SDL合并为一次绘制
+	static bool IsSameBatchState(const RenderCommand& a, const RenderCommand& b) {
+		if (a.data.index() != b.data.index()) return false;
+		if (auto ta = std::get_if<RenderTextureCommandData>(&a.data)) {
+			return ta->texture == std::get<RenderTextureCommandData>(b.data).texture;
+		}
+		if (auto ta = std::get_if<RenderCopyTextureCommandData>(&a.data)) {
+			auto& tb = std::get<RenderCopyTextureCommandData>(b.data);
+			return ta->texture == tb.texture && ta->blendMode == tb.blendMode;
+		}
+		// 九宫格和平铺纹理的颜色在顶点中，同一纹理的相邻命令合并为一次绘制
+		if (auto na = std::get_if<RenderNineSliceCommandData>(&a.data)) {
+			return na->texture == std::get<RenderNineSliceCommandData>(b.data).texture;
+		}
+		if (auto ta = std::get_if<RenderTiledTextureCommandData>(&a.data)) {
+			return ta->texture == std::get<RenderTiledTextureCommandData>(b.data).texture;
+		}
+		// 文本的颜色在顶点中，与颜色无关
+		if (std::holds_alternative<RenderTextCommandData>(a.data)) return true;
+		return a.color.r == b.color.r && a.color.g == b.color.g && a.color.b == b.color.b && a.color.a == b.color.a;
+	}
+
+	// 用纹理三角形绘制的命令，返回使用的纹理，其他命令返回nullptr
+	static SDL_Texture* GetTexturedGeometry(const RenderCommand& cmd) {
+		if (auto data = std::get_if<RenderNineSliceCommandData>(&cmd.data)) return data->texture;
+		if (auto data = std::get_if<RenderTiledTextureCommandData>(&cmd.data)) return data->texture;
+		return nullptr;
+	}
+
+	// 改变设备状态的命令，不能越过它重排
+	static bool IsBatchBarrier(const RenderCommand& cmd) {
+		return std::holds_alternative<RenderClipCommandData>(cmd.data) || std::holds_alternative<RenderTargetCommandData>(cmd.data);
+	}
+
+
+	// 渲染器属性中保存设备锁，纹理销毁时据此找到所属渲染器的锁
+	static constexpr const char* DEVICE_MUTEX_PROPERTY = "SimpleGui.renderer.device_mutex";
+
 	Renderer::Renderer(SDL_Window* window) {
 		m_renderer = SDL_CreateRenderer(window, NULL);
 		if (!m_renderer) {
@@ -138,11 +460,13 @@ namespace SimpleGui {
 			exit(-1);
 		}
 
-		m_topRender = false;
+		m_mainLayerMuted = false;
 		SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
+		SDL_SetPointerProperty(SDL_GetRendererProperties(m_renderer), DEVICE_MUTEX_PROPERTY, &m_deviceMutex);
 	}
 
 	Renderer::~Renderer() {
+		SetPipelined(false);
 		TTF_DestroyRendererTextEngine(m_textEngine);
 		SDL_DestroyRenderer(m_renderer);
 	}
@@ -151,6 +475,36 @@ namespace SimpleGui {
 		m_clearColor = color;
 	}
 
+	void Renderer::SetPipelined(bool pipelined) {
+		if (m_pipelined == pipelined) return;
+		m_pipelined = pipelined;
+
+		if (pipelined) {
+			m_stopRenderThread = false;
+			m_renderThread = std::thread(&Renderer::RenderThreadLoop, this);
+			return;
+		}
+
+		{
+			std::lock_guard lock(m_frameMutex);
+			m_stopRenderThread = true;
+		}
+		m_frameCondition.notify_all();
+		if (m_renderThread.joinable()) m_renderThread.join();
+	}
+
+	void Renderer::DestroyTexture(SDL_Texture* texture) {
+		if (!texture) return;
+		auto mutex = static_cast<std::mutex*>(SDL_GetPointerProperty(
+			SDL_GetRendererProperties(SDL_GetRendererFromTexture(texture)), DEVICE_MUTEX_PROPERTY, nullptr));
+		if (!mutex) {
+			SDL_DestroyTexture(texture);
+			return;
+		}
+		std::lock_guard lock(*mutex);
+		SDL_DestroyTexture(texture);
+	}
+
 	//void Renderer::Clear() {
 	//	SDL_SetRenderDrawColor(m_renderer, m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a);
 	//	SDL_RenderClear(m_renderer);
@@ -161,24 +515,103 @@ namespace SimpleGui {
 	//}
 
 	void Renderer::SetClipRect(const Rect& rect) const {
+		auto lock = LockDevice();
 		auto rt = rect.ToSDLRect();
 		SDL_SetRenderClipRect(m_renderer, &rt);
 	}
 
 	void Renderer::ClearClipRect() const {
+		auto lock = LockDevice();
 		SDL_SetRenderClipRect(m_renderer, NULL);
 	}
 
 	void Renderer::SetRenderClipRect(const Rect& rect) {
-		RenderCommand cmd{ .data = RenderClipCommandData{rect.ToSDLRect(), false} };
+		Rect clipRect = rect;
+		if (GetRenderLayer() == RenderLayer::Main && !m_clipConstraints.empty()) {
+			clipRect = clipRect.GetIntersection(m_clipConstraints.back());
+		}
+		RenderCommand cmd{ .data = RenderClipCommandData{clipRect.ToSDLRect(), false} };
 		AddRenderCommand(std::move(cmd));
 	}
 
 	void Renderer::ClearRenderClipRect() {
+		if (GetRenderLayer() == RenderLayer::Main && !m_clipConstraints.empty()) {
+			RenderCommand cmd{ .data = RenderClipCommandData{m_clipConstraints.back().ToSDLRect(), false} };
+			AddRenderCommand(std::move(cmd));
+			return;
+		}
 		RenderCommand cmd{ .data = RenderClipCommandData{{}, true} };
 		AddRenderCommand(std::move(cmd));
 	}
 
+	void Renderer::PushRenderTarget(SDL_Texture* target) {
+		m_renderTargets.push_back(target);
+		RenderCommand cmd{ .data = RenderTargetCommandData{target} };
+		AddRenderCommand(std::move(cmd));
+	}
+
+	void Renderer::PopRenderTarget() {
+		if (m_renderTargets.empty()) return;
+		m_renderTargets.pop_back();
+		RenderCommand cmd{ .data = RenderTargetCommandData{m_renderTargets.empty() ? nullptr : m_renderTargets.back()} };
+		AddRenderCommand(std::move(cmd));
+	}
+
+	Uint64 Renderer::HashMainLayerCommands(size_t begin) const {
+		Uint64 hash = 14695981039346656037ull;
+		RenderCommandHasher hasher(hash);
+		for (size_t i = begin; i < m_renderQueue.size(); ++i) {
+			const RenderCommand& cmd = m_renderQueue[i];
+			if (static_cast<RenderLayer>(cmd.sortKey >> 8) != RenderLayer::Main) continue;
+
+			hash = (hash ^ cmd.data.index()) * 1099511628211ull;
+			std::visit(hasher, cmd.data);
+			SDL_Color color = cmd.color;
+			for (uint8 channel : { color.r, color.g, color.b, color.a }) {
+				hash = (hash ^ channel) * 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+
+	void Renderer::DiscardMainLayerCommands(size_t begin) {
+		if (begin >= m_renderQueue.size()) return;
+
+		auto first = m_renderQueue.begin() + begin;
+		auto removed = std::remove_if(first, m_renderQueue.end(),
+			[](const RenderCommand& cmd) { return static_cast<RenderLayer>(cmd.sortKey >> 8) == RenderLayer::Main; });
+		m_frameStats.recordedCommands -= m_renderQueue.end() - removed;
+		m_renderQueue.erase(removed, m_renderQueue.end());
+
+		// 被丢弃的命令中可能有裁剪矩形，主层当前的裁剪矩形变为未知
+		for (auto& [key, state] : m_clipStates) {
+			if (static_cast<RenderLayer>(key >> 8) == RenderLayer::Main) state.valid = false;
+		}
+	}
+
+	void Renderer::PushClipConstraint(const Rect& rect) {
+		Rect constraint = m_clipConstraints.empty() ? rect : rect.GetIntersection(m_clipConstraints.back());
+		m_clipConstraints.push_back(constraint);
+		ClearRenderClipRect();
+	}
+
+	void Renderer::PopClipConstraint() {
+		if (m_clipConstraints.empty()) return;
+		m_clipConstraints.pop_back();
+		ClearRenderClipRect();
+	}
+
+	void Renderer::PushRenderLayer(RenderLayer layer, uint8 order) {
+		m_sortKeyStack.push_back(m_sortKey);
+		m_sortKey = static_cast<uint32>(layer) << 8 | order;
+	}
+
+	void Renderer::PopRenderLayer() {
+		if (m_sortKeyStack.empty()) return;
+		m_sortKey = m_sortKeyStack.back();
+		m_sortKeyStack.pop_back();
+	}
+
 	void Renderer::RenderLine(const Vec2& p1, const Vec2& p2, const Color& color) {
 		RenderCommand cmd{
 			.data = RenderLineCommandData{p1.ToSDLFPoint(), p2.ToSDLFPoint()},
@@ -214,18 +647,47 @@ namespace SimpleGui {
 		AddRenderCommand(std::move(cmd));
 	}
 
-	void Renderer::RenderCircle(const Vec2& center, float radius, const Color& color, bool fill) {
+	void Renderer::RenderCircle(const Vec2& center, float radius, const Color& color, bool fill, bool antialias) {
 		RenderCommand cmd{
-			.data = RenderCircleCommandData{center.ToSDLFPoint(), radius, fill},
+			.data = RenderCircleCommandData{center.ToSDLFPoint(), radius, fill, antialias},
+			.color = color.ToSDLColor() };
+		AddRenderCommand(std::move(cmd));
+	}
+
+	void Renderer::RenderArc(const Vec2& center, float radius, float startAngle, float endAngle, const Color& color, bool fill, bool antialias) {
+		RenderCommand cmd{
+			.data = RenderArcCommandData{center.ToSDLFPoint(), radius, startAngle, endAngle, fill, antialias},
+			.color = color.ToSDLColor() };
+		AddRenderCommand(std::move(cmd));
+	}
+
+	void Renderer::RenderRoundRect(const Rect& rect, float radius, const Color& color, bool fill, bool antialias) {
+		RenderCommand cmd{
+			.data = RenderRoundRectCommandData{rect.ToSDLFRect(), radius, fill, antialias},
 			.color = color.ToSDLColor() };
 		AddRenderCommand(std::move(cmd));
 	}
 
 	void Renderer::RenderTexture(Texture* texture, const Rect& srcRect, const Rect& dstRect, float angle, const Vec2& center, SDL_FlipMode mode) {
+		// 有缩小级别时使用不小于显示尺寸的最小级别，源矩形换算到该级别的坐标
+		// 只在用到原图时才取原图，否则会上传原图并使它一直不被释放
+		Rect levelSrcRect = srcRect;
+		SDL_Texture* levelTexture;
+		if (texture->HasMipmaps() && srcRect.size.w > 0 && srcRect.size.h > 0) {
+			Vec2 size(texture->GetWidth() * dstRect.size.w / srcRect.size.w, texture->GetHeight() * dstRect.size.h / srcRect.size.h);
+			levelTexture = &texture->GetSDLTexture(size);
+			float sx = static_cast<float>(levelTexture->w) / texture->GetWidth();
+			float sy = static_cast<float>(levelTexture->h) / texture->GetHeight();
+			levelSrcRect = Rect(srcRect.Left() * sx, srcRect.Top() * sy, srcRect.size.w * sx, srcRect.size.h * sy);
+		}
+		else {
+			levelTexture = &texture->GetSDLTexture();
+		}
+
 		RenderCommand cmd{
 			.data = RenderTextureCommandData{
-				&texture->GetSDLTexture(),
-				srcRect.ToSDLFRect(),
+				levelTexture,
+				levelSrcRect.ToSDLFRect(),
 				dstRect.ToSDLFRect(),
 				angle,
 				center.ToSDLFPoint(),
@@ -240,6 +702,75 @@ namespace SimpleGui {
 		AddRenderCommand(std::move(cmd));
 	}
 
+	void Renderer::RenderTexture(SDL_Texture* texture, const Rect& srcRect, const Rect& dstRect, SDL_BlendMode blendMode) {
+		RenderCommand cmd{
+			.data = RenderCopyTextureCommandData{
+				texture,
+				srcRect.ToSDLFRect(),
+				dstRect.ToSDLFRect(),
+				blendMode} };
+		AddRenderCommand(std::move(cmd));
+	}
+
+	void Renderer::RenderClearRect(const Rect& rect, const Color& color) {
+		RenderCommand cmd{
+			.data = RenderClearRectCommandData{rect.ToSDLFRect()},
+			.color = color.ToSDLColor() };
+		AddRenderCommand(std::move(cmd));
+	}
+
+	void Renderer::RenderNineSlice(Texture* texture, const NineSliceInsets& insets, const Rect& dstRect, const Color& color) {
+		if (!texture || texture->IsNull()) return;
+		RenderNineSlice(&texture->GetSDLTexture(), texture->GetRect(), insets, dstRect, dstRect, color);
+	}
+
+	void Renderer::RenderNineSlice(SDL_Texture* texture, const Rect& srcRect, const NineSliceInsets& insets, const Rect& dstRect,
+		const Rect& visibleRect, const Color& color) {
+		if (!texture || texture->w <= 0 || texture->h <= 0) return;
+
+		// 目标矩形比两侧不拉伸的部分之和还小时，按比例缩小两侧
+		float horizontal = insets.left + insets.right;
+		float vertical = insets.top + insets.bottom;
+		float sx = horizontal > dstRect.size.w && horizontal > 0 ? dstRect.size.w / horizontal : 1;
+		float sy = vertical > dstRect.size.h && vertical > 0 ? dstRect.size.h / vertical : 1;
+		float tw = static_cast<float>(texture->w);
+		float th = static_cast<float>(texture->h);
+
+		RenderNineSliceCommandData data{
+			texture,
+			{ dstRect.Left(), dstRect.Left() + insets.left * sx, dstRect.Right() - insets.right * sx, dstRect.Right() },
+			{ dstRect.Top(), dstRect.Top() + insets.top * sy, dstRect.Bottom() - insets.bottom * sy, dstRect.Bottom() },
+			{ srcRect.Left() / tw, (srcRect.Left() + insets.left) / tw, (srcRect.Right() - insets.right) / tw, srcRect.Right() / tw },
+			{ srcRect.Top() / th, (srcRect.Top() + insets.top) / th, (srcRect.Bottom() - insets.bottom) / th, srcRect.Bottom() / th } };
+		if (!ClampNineSliceAxis(data.xs, data.us, visibleRect.Left(), visibleRect.Right())) return;
+		if (!ClampNineSliceAxis(data.ys, data.vs, visibleRect.Top(), visibleRect.Bottom())) return;
+
+		RenderCommand cmd{
+			.data = data,
+			.color = color.ToSDLColor() };
+		AddRenderCommand(std::move(cmd));
+	}
+
+	void Renderer::RenderTiledTexture(Texture* texture, const Rect& dstRect, const Rect& visibleRect, SDL_FlipMode mode, const Color& color) {
+		if (!texture || texture->IsNull()) return;
+
+		float left = SDL_max(dstRect.Left(), visibleRect.Left());
+		float top = SDL_max(dstRect.Top(), visibleRect.Top());
+		float right = SDL_min(dstRect.Right(), visibleRect.Right());
+		float bottom = SDL_min(dstRect.Bottom(), visibleRect.Bottom());
+		if (left >= right || top >= bottom) return;
+
+		RenderCommand cmd{
+			.data = RenderTiledTextureCommandData{
+				&texture->GetSDLTexture(),
+				{ left, top, right - left, bottom - top },
+				dstRect.position.ToSDLFPoint(),
+				{ static_cast<float>(texture->GetWidth()), static_cast<float>(texture->GetHeight()) },
+				mode},
+			.color = color.ToSDLColor() };
+		AddRenderCommand(std::move(cmd));
+	}
+
 	void Renderer::DrawLine(const Vec2& p1, const Vec2& p2, const Color& color) const {
 		SetRenderColor(color);
 		SDL_RenderLine(m_renderer, p1.x, p1.y, p2.x, p2.y);
@@ -261,29 +792,9 @@ namespace SimpleGui {
 	}
 
 	void Renderer::DrawCircle(const Vec2& center, float radius, const Color& color) const {
-		float x = radius;
-		float y = 0;
-		float err = 0;
-
-		SetRenderColor(color);
-
-		while (x >= y) {
-			SDL_RenderPoint(m_renderer, center.x + x, center.y + y);
-			SDL_RenderPoint(m_renderer, center.x + y, center.y + x);
-			SDL_RenderPoint(m_renderer, center.x - y, center.y + x);
-			SDL_RenderPoint(m_renderer, center.x - x, center.y + y);
-			SDL_RenderPoint(m_renderer, center.x - x, center.y - y);
-			SDL_RenderPoint(m_renderer, center.x - y, center.y - x);
-			SDL_RenderPoint(m_renderer, center.x + y, center.y - x);
-			SDL_RenderPoint(m_renderer, center.x + x, center.y - y);
-
-			y += 1;
-			err += 1 + 2 * y;
-			if (2 * (err - x) + 1 > 0) {
-				x -= 1;
-				err += 1 - 2 * x;
-			}
-		}
+		m_immediateTessellator.Clear();
+		m_immediateTessellator.StrokeCircle(center, radius, 1, color.ToSDLFColor(), false);
+		DrawTessellatedGeometry();
 	}
 
 	void Renderer::FillRect(const Rect& rect, const Color& color) const {
@@ -350,11 +861,29 @@ namespace SimpleGui {
 	}
 
 	void Renderer::FillCircle(const Vec2& center, float radius, const Color& color) const {
-		SetRenderColor(color);
-		for (float y = -radius; y <= radius; y++) {
-			float x = (int)sqrt(radius * radius - y * y);
-			SDL_RenderLine(m_renderer, center.x - x, center.y + y, center.x + x, center.y + y);
-		}
+		m_immediateTessellator.Clear();
+		m_immediateTessellator.FillCircle(center, radius, color.ToSDLFColor(), false);
+		DrawTessellatedGeometry();
+	}
+
+	void Renderer::DrawRoundRect(const Rect& rect, float radius, const Color& color) const {
+		m_immediateTessellator.Clear();
+		m_immediateTessellator.StrokeRoundRect(Rect(rect.Left() + 0.5f, rect.Top() + 0.5f, rect.size.w - 1, rect.size.h - 1), radius - 0.5f, 1, color.ToSDLFColor(), false);
+		DrawTessellatedGeometry();
+	}
+
+	void Renderer::FillRoundRect(const Rect& rect, float radius, const Color& color) const {
+		m_immediateTessellator.Clear();
+		m_immediateTessellator.FillRoundRect(rect, radius, color.ToSDLFColor(), false);
+		DrawTessellatedGeometry();
+	}
+
+	void Renderer::DrawTessellatedGeometry() const {
+		const auto& vertices = m_immediateTessellator.GetVertices();
+		const auto& indices = m_immediateTessellator.GetIndices();
+		if (indices.empty()) return;
+		SDL_RenderGeometry(m_renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+			indices.data(), static_cast<int>(indices.size()));
 	}
 
 	void Renderer::DrawTexture(SDL_Texture* texture, const Rect& srcRect, const Rect& dstRect, float angle, const Vec2 center, SDL_FlipMode mode) const {
@@ -408,28 +937,119 @@ namespace SimpleGui {
 	}
 
 	std::shared_ptr<SDL_Texture> Renderer::CreateSharedSDLTexture(std::string_view path) const {
+		auto lock = LockDevice();
 		SDL_Texture* tt = IMG_LoadTexture(m_renderer, path.data());
 		return {tt, TextureDeleter()};
 	}
 
-	std::shared_ptr<Texture> Renderer::CreateSharedTexture(std::string_view path) const {
-		return std::shared_ptr<Texture>(new Texture(*this, path));
+	std::shared_ptr<Texture> Renderer::CreateSharedTexture(std::string_view path, bool mipmaps) const {
+		return std::shared_ptr<Texture>(new Texture(*this, path, mipmaps));
 	}
 
 	SDL_Texture* Renderer::CreateSDLTexture(std::string_view path) const {
+		auto lock = LockDevice();
 		return IMG_LoadTexture(m_renderer, path.data());
 	}
 
-	Texture* Renderer::CreateTexture(std::string_view path) const {
-		return new Texture(*this, path);
+	Texture* Renderer::CreateTexture(std::string_view path, bool mipmaps) const {
+		return new Texture(*this, path, mipmaps);
+	}
+
+	UniqueTexturePtr Renderer::CreateTargetTexture(int w, int h) const {
+		auto lock = LockDevice();
+		UniqueTexturePtr texture(SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h));
+		if (texture) SDL_SetTextureScaleMode(texture.get(), SDL_SCALEMODE_NEAREST);
+		return texture;
 	}
 
 	void Renderer::Render() {
-		SDL_SetRenderDrawColor(m_renderer, m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a);
-		SDL_RenderClear(m_renderer);
-		ExecuteRenderQueue(m_renderQueue);
-		ExecuteRenderQueue(m_topRenderQueue);
-		SDL_RenderPresent(m_renderer);
+		SortRenderQueue();
+		m_stats = m_frameStats;
+		m_frameStats = {};
+		// 下一帧开始执行时SDL中的裁剪矩形是上一帧遗留的
+		m_clipStates.clear();
+
+		if (m_pipelined) {
+			SubmitFrame();
+			ReleaseIdleTextureLevels();
+			return;
+		}
+
+		{
+			auto lock = LockDevice();
+			SDL_SetRenderDrawColor(m_renderer, m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a);
+			SDL_RenderClear(m_renderer);
+			ExecuteRenderQueue(m_renderQueue, m_renderOrder);
+			SDL_RenderPresent(m_renderer);
+		}
+		ReleaseIdleTextureLevels();
+	}
+
+	void Renderer::RegisterMipmapTexture(const Texture* texture) const {
+		texture->m_registryIndex = m_mipmapTextures.size();
+		m_mipmapTextures.push_back(texture);
+	}
+
+	void Renderer::UnregisterMipmapTexture(const Texture* texture) const {
+		size_t index = texture->m_registryIndex;
+		m_mipmapTextures.back()->m_registryIndex = index;
+		m_mipmapTextures[index] = m_mipmapTextures.back();
+		m_mipmapTextures.pop_back();
+	}
+
+	void Renderer::ReleaseIdleTextureLevels() {
+		// 不需要每帧检查，闲置时间的精度够用即可
+		Uint64 now = SDL_GetTicks();
+		if (now - m_lastLevelReleaseTime < Texture::LEVEL_RELEASE_DELAY / 4) return;
+		m_lastLevelReleaseTime = now;
+		for (const Texture* texture : m_mipmapTextures) {
+			texture->ReleaseIdleLevels(now);
+		}
+	}
+
+	void Renderer::SubmitFrame() {
+		std::unique_lock lock(m_frameMutex);
+		// 渲染线程呈现完上一帧后才交换，UI线程最多领先一帧
+		m_frameCondition.wait(lock, [this] { return !m_frameReady && m_renderIdle; });
+
+		// 交换后记录队列是上一帧已执行（已清空）的队列，容量得以复用
+		std::swap(m_renderQueue, m_submitQueue);
+		std::swap(m_renderOrder, m_submitOrder);
+		m_submitClearColor = m_clearColor;
+		m_frameReady = true;
+		m_frameExecuted = false;
+		m_frameCondition.notify_all();
+
+		// 命令执行完毕后命令引用的资源（TTF_Text等）不再被渲染线程访问，呈现与UI线程的下一帧并行
+		m_frameCondition.wait(lock, [this] { return m_frameExecuted; });
+	}
+
+	void Renderer::RenderThreadLoop() {
+		for (;;) {
+			std::unique_lock lock(m_frameMutex);
+			m_frameCondition.wait(lock, [this] { return m_frameReady || m_stopRenderThread; });
+			if (!m_frameReady) return;
+			m_frameReady = false;
+			m_renderIdle = false;
+			lock.unlock();
+
+			auto device = LockDevice();
+			SDL_SetRenderDrawColor(m_renderer, m_submitClearColor.r, m_submitClearColor.g, m_submitClearColor.b, m_submitClearColor.a);
+			SDL_RenderClear(m_renderer);
+			ExecuteRenderQueue(m_submitQueue, m_submitOrder);
+
+			lock.lock();
+			m_frameExecuted = true;
+			m_frameCondition.notify_all();
+			lock.unlock();
+
+			SDL_RenderPresent(m_renderer);
+			device.unlock();
+
+			lock.lock();
+			m_renderIdle = true;
+			m_frameCondition.notify_all();
+		}
 	}
 
 	void Renderer::SetRenderColor(const Color& color) const {
@@ -437,16 +1057,151 @@ namespace SimpleGui {
 	}
 
 	void Renderer::AddRenderCommand(RenderCommand&& cmd) {
-		if (m_topRender) m_topRenderQueue.push(cmd);
-		else m_renderQueue.push(cmd);
+		if (m_mainLayerMuted && GetRenderLayer() == RenderLayer::Main) {
+			++m_frameStats.mutedCommands;
+			return;
+		}
+		if (!ClipRenderCommand(cmd, GetRecordClipState())) return;
+
+		cmd.sortKey = m_sortKey;
+		m_renderQueue.push_back(std::move(cmd));
+		++m_frameStats.recordedCommands;
 	}
 
-	void Renderer::ExecuteRenderQueue(std::queue<RenderCommand>& queue) {
-		while (!queue.empty()) {
-			auto& cmd = queue.front();
-			RenderCommandDataVisitor visitor(m_renderer, cmd.color);
+	Renderer::RecordClipState& Renderer::GetRecordClipState() {
+		for (auto& [key, state] : m_clipStates) {
+			if (key == m_sortKey) return state;
+		}
+		return m_clipStates.emplace_back(m_sortKey, RecordClipState{}).second;
+	}
+
+	bool Renderer::ClipRenderCommand(RenderCommand& cmd, RecordClipState& clip) {
+		if (auto data = std::get_if<RenderClipCommandData>(&cmd.data)) {
+			clip.valid = !data->disable;
+			clip.rect = Rect(data->rect);
+			return true;
+		}
+		if (std::holds_alternative<RenderTargetCommandData>(cmd.data)) {
+			clip.valid = false;
+			return true;
+		}
+		if (!clip.valid) return true;
+
+		switch (std::visit(RenderCommandClipper(clip.rect), cmd.data)) {
+			case RenderCommandClipper::Result::Culled:
+				++m_frameStats.culledCommands;
+				return false;
+			case RenderCommandClipper::Result::Trimmed:
+				++m_frameStats.trimmedCommands;
+				return true;
+			default:
+				return true;
+		}
+	}
+
+	void Renderer::SortRenderQueue() {
+		size_t count = m_renderQueue.size();
+		m_renderOrder.resize(count);
+		for (size_t i = 0; i < count; ++i) m_renderOrder[i] = static_cast<uint32>(i);
+
+		// 排序键只有低16位，按字节做两趟稳定的计数排序，所有命令在同一字节上相同时跳过该趟
+		m_sortScratch.resize(count);
+		for (int shift = 0; shift < 16; shift += 8) {
+			size_t offsets[256] = {};
+			for (uint32 index : m_renderOrder) ++offsets[(m_renderQueue[index].sortKey >> shift) & 0xFF];
+			if (count == 0 || offsets[(m_renderQueue[m_renderOrder[0]].sortKey >> shift) & 0xFF] == count) continue;
+
+			size_t sum = 0;
+			for (auto& offset : offsets) {
+				size_t n = offset;
+				offset = sum;
+				sum += n;
+			}
+			for (uint32 index : m_renderOrder) m_sortScratch[offsets[(m_renderQueue[index].sortKey >> shift) & 0xFF]++] = index;
+			std::swap(m_renderOrder, m_sortScratch);
+		}
+
+		m_commandBounds.resize(count);
+		m_commandBoundsKnown.assign(count, false);
+		for (size_t i = 0; i < count; ++i) {
+			m_commandBoundsKnown[i] = GetRenderCommandBounds(m_renderQueue[i], m_commandBounds[i]);
+		}
+
+		for (size_t begin = 0, end = 0; begin < count; begin = end) {
+			uint32 key = m_renderQueue[m_renderOrder[begin]].sortKey;
+			for (end = begin + 1; end < count && m_renderQueue[m_renderOrder[end]].sortKey == key; ++end) {}
+			BatchRenderQueue(begin, end);
+		}
+	}
+
+	void Renderer::BatchRenderQueue(size_t begin, size_t end) {
+		// 在窗口内向后查找与当前命令状态相同的命令，它与中间的命令都不重叠时提前到当前命令之后，绘制结果不变
+		constexpr size_t BATCH_WINDOW = 32;
+
+		for (size_t i = begin; i + 2 < end; ++i) {
+			const RenderCommand& current = m_renderQueue[m_renderOrder[i]];
+			if (IsBatchBarrier(current) || IsSameBatchState(current, m_renderQueue[m_renderOrder[i + 1]])) continue;
+
+			m_batchScratch.clear();
+			for (size_t j = i + 1; j < end && j <= i + BATCH_WINDOW; ++j) {
+				uint32 index = m_renderOrder[j];
+				const RenderCommand& cmd = m_renderQueue[index];
+				if (IsBatchBarrier(cmd) || !m_commandBoundsKnown[index]) break;
+
+				const Rect& bounds = m_commandBounds[index];
+				if (IsSameBatchState(current, cmd)) {
+					bool overlapping = std::any_of(m_batchScratch.begin(), m_batchScratch.end(),
+						[&bounds](const Rect& rect) { return IsBoundsOverlapping(bounds, rect); });
+					if (!overlapping) {
+						std::rotate(m_renderOrder.begin() + i + 1, m_renderOrder.begin() + j, m_renderOrder.begin() + j + 1);
+						++m_frameStats.reorderedCommands;
+						break;
+					}
+				}
+				m_batchScratch.push_back(bounds);
+			}
+		}
+	}
+
+	void Renderer::ExecuteRenderQueue(std::vector<RenderCommand>& queue, std::vector<uint32>& order) {
+		for (size_t i = 0; i < order.size();) {
+			auto& cmd = queue[order[i]];
+			if (GetTexturedGeometry(cmd)) {
+				i = ExecuteTexturedGeometryBatch(queue, order, i);
+				continue;
+			}
+
+			RenderCommandDataVisitor visitor(m_renderer, cmd.color, m_tessellator);
 			std::visit(visitor, cmd.data);
-			queue.pop();
+			++i;
+		}
+		queue.clear();
+		order.clear();
+	}
+
+	size_t Renderer::ExecuteTexturedGeometryBatch(std::vector<RenderCommand>& queue, std::vector<uint32>& order, size_t begin) {
+		SDL_Texture* texture = GetTexturedGeometry(queue[order[begin]]);
+
+		m_tessellator.Clear();
+		size_t end = begin;
+		for (; end < order.size(); ++end) {
+			const auto& cmd = queue[order[end]];
+			if (GetTexturedGeometry(cmd) != texture) break;
+
+			SDL_FColor color = { cmd.color.r / 255.f, cmd.color.g / 255.f, cmd.color.b / 255.f, cmd.color.a / 255.f };
+			if (auto data = std::get_if<RenderNineSliceCommandData>(&cmd.data)) {
+				m_tessellator.AddNineSlice(data->xs, data->ys, data->us, data->vs, color);
+			}
+			else {
+				auto& tiled = std::get<RenderTiledTextureCommandData>(cmd.data);
+				m_tessellator.AddTiles(tiled.rect, tiled.origin, tiled.tileSize, tiled.mode, color);
+			}
 		}
+
+		const auto& vertices = m_tessellator.GetVertices();
+		const auto& indices = m_tessellator.GetIndices();
+		SDL_RenderGeometry(m_renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+			indices.data(), static_cast<int>(indices.size()));
+		return end;
 	}
 }
@@ -0,0 +1,301 @@
+#include "shape_tessellator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+
+namespace SimpleGui {
+	int ShapeTessellator::GetSegmentCount(float radius) {
+		int segments = MIN_SEGMENTS;
+		if (radius > MAX_CHORD_ERROR) {
+			// 弦高 r * (1 - cos(π / n)) <= MAX_CHORD_ERROR
+			float step = std::acos(1 - MAX_CHORD_ERROR / radius);
+			segments = static_cast<int>(std::ceil(std::numbers::pi_v<float> / step));
+		}
+		segments = (segments + 3) / 4 * 4;
+		return std::clamp(segments, MIN_SEGMENTS, MAX_SEGMENTS);
+	}
+
+	void ShapeTessellator::FillCircle(const Vec2& center, float radius, const SDL_FColor& color, bool antialias) {
+		int segments = GetSegmentCount(radius);
+		const auto& unit = GetUnitCircle(segments);
+
+		m_contour.clear();
+		for (int i = 0; i < segments; ++i) {
+			m_contour.push_back({ { center.x + unit[i].x * radius, center.y + unit[i].y * radius }, unit[i] });
+		}
+		FillContour(center.ToSDLFPoint(), color, antialias);
+	}
+
+	void ShapeTessellator::StrokeCircle(const Vec2& center, float radius, float thickness, const SDL_FColor& color, bool antialias) {
+		int segments = GetSegmentCount(radius);
+		const auto& unit = GetUnitCircle(segments);
+
+		m_contour.clear();
+		for (int i = 0; i < segments; ++i) {
+			m_contour.push_back({ { center.x + unit[i].x * radius, center.y + unit[i].y * radius }, unit[i] });
+		}
+		StrokeContour(thickness, true, color, antialias);
+	}
+
+	void ShapeTessellator::FillArc(const Vec2& center, float radius, float startAngle, float endAngle, const SDL_FColor& color, bool antialias) {
+		if (SDL_fabsf(endAngle - startAngle) >= 360) {
+			FillCircle(center, radius, color, antialias);
+			return;
+		}
+
+		// 扇心的法线为0，两条半径边不羽化
+		m_contour.clear();
+		m_contour.push_back({ center.ToSDLFPoint(), { 0, 0 } });
+		BuildArcContour(center, radius, startAngle, endAngle);
+		FillContour(center.ToSDLFPoint(), color, antialias);
+	}
+
+	void ShapeTessellator::StrokeArc(const Vec2& center, float radius, float startAngle, float endAngle, float thickness, const SDL_FColor& color, bool antialias) {
+		if (SDL_fabsf(endAngle - startAngle) >= 360) {
+			StrokeCircle(center, radius, thickness, color, antialias);
+			return;
+		}
+
+		m_contour.clear();
+		BuildArcContour(center, radius, startAngle, endAngle);
+		StrokeContour(thickness, false, color, antialias);
+	}
+
+	void ShapeTessellator::FillRoundRect(const Rect& rect, float radius, const SDL_FColor& color, bool antialias) {
+		BuildRoundRectContour(rect, radius);
+		FillContour(rect.Center().ToSDLFPoint(), color, antialias);
+	}
+
+	void ShapeTessellator::StrokeRoundRect(const Rect& rect, float radius, float thickness, const SDL_FColor& color, bool antialias) {
+		BuildRoundRectContour(rect, radius);
+		StrokeContour(thickness, true, color, antialias);
+	}
+
+	void ShapeTessellator::AddNineSlice(const float (&xs)[4], const float (&ys)[4], const float (&us)[4], const float (&vs)[4], const SDL_FColor& color) {
+		int first = static_cast<int>(m_vertices.size());
+		for (int row = 0; row < 4; ++row) {
+			for (int col = 0; col < 4; ++col) {
+				m_vertices.push_back({ { xs[col], ys[row] }, color, { us[col], vs[row] } });
+			}
+		}
+
+		for (int row = 0; row < 3; ++row) {
+			for (int col = 0; col < 3; ++col) {
+				int i = first + row * 4 + col;
+				m_indices.push_back(i);
+				m_indices.push_back(i + 1);
+				m_indices.push_back(i + 5);
+				m_indices.push_back(i);
+				m_indices.push_back(i + 5);
+				m_indices.push_back(i + 4);
+			}
+		}
+	}
+
+	void ShapeTessellator::AddTiles(const SDL_FRect& rect, const SDL_FPoint& origin, const SDL_FPoint& tileSize, SDL_FlipMode mode, const SDL_FColor& color) {
+		if (tileSize.x <= 0 || tileSize.y <= 0 || rect.w <= 0 || rect.h <= 0) return;
+
+		float right = rect.x + rect.w;
+		float bottom = rect.y + rect.h;
+		int firstCol = static_cast<int>(std::floor((rect.x - origin.x) / tileSize.x));
+		int lastCol = static_cast<int>(std::ceil((right - origin.x) / tileSize.x));
+		int firstRow = static_cast<int>(std::floor((rect.y - origin.y) / tileSize.y));
+		int lastRow = static_cast<int>(std::ceil((bottom - origin.y) / tileSize.y));
+		bool flipH = (mode & SDL_FLIP_HORIZONTAL) != 0;
+		bool flipV = (mode & SDL_FLIP_VERTICAL) != 0;
+
+		m_vertices.reserve(m_vertices.size() + static_cast<size_t>(lastCol - firstCol) * (lastRow - firstRow) * 4);
+		m_indices.reserve(m_indices.size() + static_cast<size_t>(lastCol - firstCol) * (lastRow - firstRow) * 6);
+		for (int row = firstRow; row < lastRow; ++row) {
+			float tileTop = origin.y + row * tileSize.y;
+			float top = SDL_max(tileTop, rect.y);
+			float bottomEdge = SDL_min(tileTop + tileSize.y, bottom);
+			if (top >= bottomEdge) continue;
+			float v0 = (top - tileTop) / tileSize.y;
+			float v1 = (bottomEdge - tileTop) / tileSize.y;
+			if (flipV) {
+				v0 = 1 - v0;
+				v1 = 1 - v1;
+			}
+
+			for (int col = firstCol; col < lastCol; ++col) {
+				float tileLeft = origin.x + col * tileSize.x;
+				float left = SDL_max(tileLeft, rect.x);
+				float rightEdge = SDL_min(tileLeft + tileSize.x, right);
+				if (left >= rightEdge) continue;
+				float u0 = (left - tileLeft) / tileSize.x;
+				float u1 = (rightEdge - tileLeft) / tileSize.x;
+				if (flipH) {
+					u0 = 1 - u0;
+					u1 = 1 - u1;
+				}
+
+				int first = static_cast<int>(m_vertices.size());
+				m_vertices.push_back({ { left, top }, color, { u0, v0 } });
+				m_vertices.push_back({ { rightEdge, top }, color, { u1, v0 } });
+				m_vertices.push_back({ { rightEdge, bottomEdge }, color, { u1, v1 } });
+				m_vertices.push_back({ { left, bottomEdge }, color, { u0, v1 } });
+				m_indices.push_back(first);
+				m_indices.push_back(first + 1);
+				m_indices.push_back(first + 2);
+				m_indices.push_back(first);
+				m_indices.push_back(first + 2);
+				m_indices.push_back(first + 3);
+			}
+		}
+	}
+
+	void ShapeTessellator::Clear() {
+		m_vertices.clear();
+		m_indices.clear();
+	}
+
+	const std::vector<SDL_FPoint>& ShapeTessellator::GetUnitCircle(int segments) {
+		auto [it, inserted] = m_unitCircles.try_emplace(segments);
+		if (inserted) {
+			auto& points = it->second;
+			points.reserve(segments + 1);
+			for (int i = 0; i <= segments; ++i) {
+				float angle = 2 * std::numbers::pi_v<float> * i / segments;
+				points.push_back({ std::cos(angle), std::sin(angle) });
+			}
+			points.back() = points.front();
+		}
+		return it->second;
+	}
+
+	void ShapeTessellator::BuildArcContour(const Vec2& center, float radius, float startAngle, float endAngle) {
+		if (endAngle < startAngle) std::swap(startAngle, endAngle);
+
+		int segments = GetSegmentCount(radius);
+		const auto& unit = GetUnitCircle(segments);
+		float start = startAngle * std::numbers::pi_v<float> / 180;
+		float sweep = (endAngle - startAngle) * std::numbers::pi_v<float> / 180;
+		float step = 2 * std::numbers::pi_v<float> / segments;
+
+		// 模板中的点旋转到起始角度，最后一段不足一个分段时补上终点
+		float c = std::cos(start), s = std::sin(start);
+		for (int i = 0; i <= segments && i * step < sweep - 1e-4f; ++i) {
+			SDL_FPoint normal = { unit[i].x * c - unit[i].y * s, unit[i].x * s + unit[i].y * c };
+			m_contour.push_back({ { center.x + normal.x * radius, center.y + normal.y * radius }, normal });
+		}
+		SDL_FPoint normal = { std::cos(start + sweep), std::sin(start + sweep) };
+		m_contour.push_back({ { center.x + normal.x * radius, center.y + normal.y * radius }, normal });
+	}
+
+	void ShapeTessellator::BuildRoundRectContour(const Rect& rect, float radius) {
+		m_contour.clear();
+		radius = std::clamp(radius, 0.f, SDL_min(rect.size.w, rect.size.h) / 2);
+
+		if (radius <= 0) {
+			m_contour.push_back({ rect.TopLeft().ToSDLFPoint(), { -1, -1 } });
+			m_contour.push_back({ rect.TopRight().ToSDLFPoint(), { 1, -1 } });
+			m_contour.push_back({ rect.BottomRight().ToSDLFPoint(), { 1, 1 } });
+			m_contour.push_back({ rect.BottomLeft().ToSDLFPoint(), { -1, 1 } });
+			return;
+		}
+
+		int segments = GetSegmentCount(radius);
+		int quarter = segments / 4;
+		const auto& unit = GetUnitCircle(segments);
+
+		// 屏幕坐标中角度顺时针增加，从左上角开始依次为180°~270°、270°~360°、0°~90°、90°~180°
+		const SDL_FPoint centers[4] = {
+			{ rect.Left() + radius, rect.Top() + radius },
+			{ rect.Right() - radius, rect.Top() + radius },
+			{ rect.Right() - radius, rect.Bottom() - radius },
+			{ rect.Left() + radius, rect.Bottom() - radius }
+		};
+		const int starts[4] = { quarter * 2, quarter * 3, 0, quarter };
+
+		for (int corner = 0; corner < 4; ++corner) {
+			for (int i = 0; i <= quarter; ++i) {
+				const SDL_FPoint& normal = unit[starts[corner] + i];
+				m_contour.push_back({ { centers[corner].x + normal.x * radius, centers[corner].y + normal.y * radius }, normal });
+			}
+		}
+	}
+
+	void ShapeTessellator::FillContour(const SDL_FPoint& fanCenter, const SDL_FColor& color, bool antialias) {
+		int count = static_cast<int>(m_contour.size());
+		if (count < 2) return;
+
+		int center = AddVertex(fanCenter, color);
+		int inner = AddContourRing(antialias ? -0.5f : 0, color);
+		for (int i = 0; i < count; ++i) {
+			m_indices.push_back(center);
+			m_indices.push_back(inner + i);
+			m_indices.push_back(inner + (i + 1) % count);
+		}
+
+		if (antialias) {
+			int outer = AddContourRing(0.5f, { color.r, color.g, color.b, 0 });
+			AddQuadStrip(inner, outer, true, true);
+		}
+	}
+
+	void ShapeTessellator::StrokeContour(float thickness, bool closed, const SDL_FColor& color, bool antialias) {
+		if (m_contour.size() < 2) return;
+
+		float half = thickness / 2;
+		if (!antialias) {
+			int inner = AddContourRing(-half, color);
+			int outer = AddContourRing(half, color);
+			AddQuadStrip(inner, outer, closed, false);
+			return;
+		}
+
+		// 两侧各有1像素的羽化，线宽不足1像素时实心部分退化为中线，用透明度表示覆盖率
+		float innerSolid = -half + 0.5f;
+		float outerSolid = half - 0.5f;
+		SDL_FColor solid = color;
+		if (innerSolid > outerSolid) {
+			innerSolid = outerSolid = 0;
+			solid.a *= SDL_min(thickness, 1.f);
+		}
+		SDL_FColor transparent = { solid.r, solid.g, solid.b, 0 };
+
+		int innerFeather = AddContourRing(-half - 0.5f, transparent);
+		int innerRing = AddContourRing(innerSolid, solid);
+		int outerRing = innerSolid < outerSolid ? AddContourRing(outerSolid, solid) : innerRing;
+		int outerFeather = AddContourRing(half + 0.5f, transparent);
+
+		AddQuadStrip(innerFeather, innerRing, closed, false);
+		if (outerRing != innerRing) AddQuadStrip(innerRing, outerRing, closed, false);
+		AddQuadStrip(outerRing, outerFeather, closed, false);
+	}
+
+	int ShapeTessellator::AddVertex(const SDL_FPoint& pos, const SDL_FColor& color) {
+		m_vertices.push_back({ pos, color, { 0, 0 } });
+		return static_cast<int>(m_vertices.size()) - 1;
+	}
+
+	int ShapeTessellator::AddContourRing(float offset, const SDL_FColor& color) {
+		int first = static_cast<int>(m_vertices.size());
+		for (const auto& point : m_contour) {
+			AddVertex({ point.pos.x + point.normal.x * offset, point.pos.y + point.normal.y * offset }, color);
+		}
+		return first;
+	}
+
+	void ShapeTessellator::AddQuadStrip(int ring1, int ring2, bool closed, bool skipUnfeathered) {
+		int count = static_cast<int>(m_contour.size());
+		int quads = closed ? count : count - 1;
+		for (int i = 0; i < quads; ++i) {
+			int j = (i + 1) % count;
+			if (skipUnfeathered) {
+				const auto& a = m_contour[i].normal;
+				const auto& b = m_contour[j].normal;
+				if ((a.x == 0 && a.y == 0) || (b.x == 0 && b.y == 0)) continue;
+			}
+
+			m_indices.push_back(ring1 + i);
+			m_indices.push_back(ring2 + i);
+			m_indices.push_back(ring2 + j);
+			m_indices.push_back(ring1 + i);
+			m_indices.push_back(ring2 + j);
+			m_indices.push_back(ring1 + j);
+		}
+	}
+}
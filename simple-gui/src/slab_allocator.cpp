@@ -0,0 +1,69 @@
+#include "slab_allocator.hpp"
+#include <new>
+
+
+namespace SimpleGui {
+	SlabAllocator::~SlabAllocator() {
+		for (auto slab : m_slabs) {
+			::operator delete(slab, std::align_val_t(ALIGNMENT));
+		}
+	}
+
+	SlabAllocator& SlabAllocator::GetInstance() {
+		// 不析构：静态对象（如未调用Quit时的GuiManager）在程序退出时仍可能释放组件
+		static SlabAllocator* s_instance = new SlabAllocator();
+		return *s_instance;
+	}
+
+	void* SlabAllocator::Allocate(size_t size) {
+		if (size == 0) size = 1;
+		if (size > MAX_SIZE) return ::operator new(size);
+
+		size_t idx = GetClassIndex(size);
+		size_t classSize = (idx + 1) * ALIGNMENT;
+		m_usedBytes += classSize;
+
+		if (FreeNode* node = m_freeLists[idx]) {
+			m_freeLists[idx] = node->next;
+			return node;
+		}
+
+		if (static_cast<size_t>(m_end - m_cursor) < classSize) NewSlab();
+		void* ptr = m_cursor;
+		m_cursor += classSize;
+		return ptr;
+	}
+
+	void SlabAllocator::Deallocate(void* ptr, size_t size) noexcept {
+		if (!ptr) return;
+		if (size == 0) size = 1;
+		if (size > MAX_SIZE) {
+			::operator delete(ptr);
+			return;
+		}
+
+		size_t idx = GetClassIndex(size);
+		m_usedBytes -= (idx + 1) * ALIGNMENT;
+
+		auto node = static_cast<FreeNode*>(ptr);
+		node->next = m_freeLists[idx];
+		m_freeLists[idx] = node;
+	}
+
+	void SlabAllocator::NewSlab() {
+		// 当前块剩余的空间不足以放下对象，将其按最大的可用分级放入空闲链表，避免浪费
+		while (static_cast<size_t>(m_end - m_cursor) >= ALIGNMENT) {
+			size_t remain = static_cast<size_t>(m_end - m_cursor);
+			size_t idx = GetClassIndex(remain < MAX_SIZE ? remain - remain % ALIGNMENT : MAX_SIZE);
+			auto node = reinterpret_cast<FreeNode*>(m_cursor);
+			node->next = m_freeLists[idx];
+			m_freeLists[idx] = node;
+			m_cursor += (idx + 1) * ALIGNMENT;
+		}
+
+		auto slab = static_cast<std::byte*>(::operator new(SLAB_SIZE, std::align_val_t(ALIGNMENT)));
+		m_slabs.push_back(slab);
+		m_cursor = slab;
+		m_end = slab + SLAB_SIZE;
+	}
+}
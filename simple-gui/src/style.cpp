@@ -136,6 +136,24 @@ namespace SimpleGui {
 		style->colors[ThemeColorFlags::LineEditSelectedBackground] = Color(0x3498dbff);
 		style->colors[ThemeColorFlags::LineEditSelectedForeground] = Color::BLACK;
 
+		style->colors[ThemeColorFlags::TextEditBackground] = Color(200, 200, 200);
+		style->colors[ThemeColorFlags::TextEditForeground] = Color::BLACK;
+		style->colors[ThemeColorFlags::TextEditBorder] = Color(0x3d444dff);
+		style->colors[ThemeColorFlags::TextEditActivatedBorder] = Color(0x3498dbff);
+		style->colors[ThemeColorFlags::TextEditCaret] = Color::BLACK;
+		style->colors[ThemeColorFlags::TextEditSelectedBackground] = Color(0x3498db64);
+
+		style->colors[ThemeColorFlags::ListViewBackground] = Color(200, 200, 200);
+		style->colors[ThemeColorFlags::ListViewBorder] = Color(0x3d444dff);
+
+		style->colors[ThemeColorFlags::TableViewBackground] = Color(200, 200, 200);
+		style->colors[ThemeColorFlags::TableViewForeground] = Color::BLACK;
+		style->colors[ThemeColorFlags::TableViewAlternateRow] = Color(185, 185, 185);
+		style->colors[ThemeColorFlags::TableViewGrid] = Color(160, 160, 160);
+		style->colors[ThemeColorFlags::TableViewHeaderBackground] = Color(0x3498dbff);
+		style->colors[ThemeColorFlags::TableViewHeaderForeground] = Color::WHITE;
+		style->colors[ThemeColorFlags::TableViewBorder] = Color(0x3d444dff);
+
 		style->colors[ThemeColorFlags::ProgressBarSlot] = Color(200, 200, 200);
 		style->colors[ThemeColorFlags::ProgressBarProgress] = Color(0x3498dbff);
 		style->colors[ThemeColorFlags::ProgressBarForeground] = Color::BLACK;
@@ -206,6 +224,13 @@ namespace SimpleGui {
 		style->colors[ThemeColorFlags::LineEditSelectedBackground] = Color(0x8250dfff);
 		style->colors[ThemeColorFlags::LineEditSelectedForeground] = Color::WHITE;
 
+		style->colors[ThemeColorFlags::TextEditBackground] = Color(47, 47, 47);
+		style->colors[ThemeColorFlags::TextEditForeground] = Color::WHITE;
+		style->colors[ThemeColorFlags::TextEditBorder] = Color(0x3d444dff);
+		style->colors[ThemeColorFlags::TextEditActivatedBorder] = Color(0x8250dfff);
+		style->colors[ThemeColorFlags::TextEditCaret] = Color::WHITE;
+		style->colors[ThemeColorFlags::TextEditSelectedBackground] = Color(0x8250df64);
+
 		style->colors[ThemeColorFlags::ProgressBarSlot] = Color(47, 47, 47);
 		style->colors[ThemeColorFlags::ProgressBarProgress] = Color(0x8250dfff);
 		style->colors[ThemeColorFlags::ProgressBarForeground] = Color::WHITE;
@@ -229,6 +254,17 @@ namespace SimpleGui {
 		style->colors[ThemeColorFlags::ComboBoxItemSelected] = Color(0x8250dfff);
 		style->colors[ThemeColorFlags::ComboBoxItemHovered] = Color(0x8250df64);
 
+		style->colors[ThemeColorFlags::ListViewBackground] = Color(47, 47, 47);
+		style->colors[ThemeColorFlags::ListViewBorder] = Color(0x3d444dff);
+
+		style->colors[ThemeColorFlags::TableViewBackground] = Color(47, 47, 47);
+		style->colors[ThemeColorFlags::TableViewForeground] = Color::WHITE;
+		style->colors[ThemeColorFlags::TableViewAlternateRow] = Color(58, 58, 58);
+		style->colors[ThemeColorFlags::TableViewGrid] = Color(80, 80, 80);
+		style->colors[ThemeColorFlags::TableViewHeaderBackground] = Color(0x8250dfff);
+		style->colors[ThemeColorFlags::TableViewHeaderForeground] = Color::WHITE;
+		style->colors[ThemeColorFlags::TableViewBorder] = Color(0x3d444dff);
+
 		return style;
 	}
 
@@ -1,17 +1,184 @@
 #include "texture.hpp"
 #include <SDL3_image/SDL_image.h>
+#include "logger.hpp"
+#include "mipmap.hpp"
 #include "renderer.hpp"
 
 
 namespace SimpleGui {
-	Texture::Texture(const Renderer& renderer, std::string_view path) {
-		m_texture = IMG_LoadTexture(&renderer.GetSDLRenderer(), path.data());
+	Texture::Texture(const Renderer& renderer, std::string_view path, bool mipmaps) : m_renderer(renderer) {
 		m_path = path;
+
+		if (!mipmaps) {
+			auto lock = renderer.LockDevice();
+			SDL_Texture* texture = IMG_LoadTexture(&renderer.GetSDLRenderer(), m_path.c_str());
+			if (!texture) return;
+			m_width = texture->w;
+			m_height = texture->h;
+			m_levels.push_back({ texture->w, texture->h, texture });
+			return;
+		}
+
+		// 加载时还不知道显示尺寸，保留所有级别的像素，第一次使用时再释放用不到的级别
+		m_surfaces = BuildSurfaces(m_path, 0);
+		if (m_surfaces.empty()) return;
+		m_width = m_surfaces[0]->w;
+		m_height = m_surfaces[0]->h;
+		for (SDL_Surface* surface : m_surfaces) {
+			m_levels.push_back({ surface->w, surface->h });
+		}
+
+		if (!UploadLevel(m_levels.size() - 1)) {
+			ReleaseSurfaces(m_surfaces.size() - 1);
+			m_surfaces.clear();
+			m_levels.clear();
+			return;
+		}
+		if (HasMipmaps()) m_renderer.RegisterMipmapTexture(this);
 	}
 
 	Texture::~Texture() {
-		if (m_texture) {
-			SDL_DestroyTexture(m_texture);
+		if (HasMipmaps()) m_renderer.UnregisterMipmapTexture(this);
+		if (m_rebuildFuture.valid()) {
+			for (SDL_Surface* surface : m_rebuildFuture.get()) {
+				SDL_DestroySurface(surface);
+			}
+		}
+		for (auto& level : m_levels) {
+			Renderer::DestroyTexture(level.texture);
+		}
+		if (!m_surfaces.empty()) ReleaseSurfaces(m_surfaces.size() - 1);
+	}
+
+	SDL_Texture& Texture::GetSDLTexture(const Vec2& size) const {
+		size_t level = 0;
+		while (level + 1 < m_levels.size() && m_levels[level + 1].w >= size.w && m_levels[level + 1].h >= size.h) {
+			++level;
+		}
+		return GetLevelTexture(level);
+	}
+
+	void Texture::SetScaleMode(SDL_ScaleMode mode) {
+		m_scaleMode = mode;
+		for (auto& level : m_levels) {
+			if (level.texture) SDL_SetTextureScaleMode(level.texture, mode);
+		}
+	}
+
+	SDL_Texture& Texture::GetLevelTexture(size_t level) const {
+		Level& target = m_levels[level];
+		target.lastUsedTime = SDL_GetTicks();
+		if (target.texture) return *target.texture;
+		if (target.uploadFailed) return GetNearestUploadedLevel(level);
+
+		PollRebuildResult();
+		if (!m_surfaces[level]) {
+			RequestRebuild(level);
+			return GetNearestUploadedLevel(level);
+		}
+
+		if (!UploadLevel(level)) {
+			target.uploadFailed = true;
+			SG_ERROR("Texture: can't upload mipmap level {} of {}. {}", level, m_path, SDL_GetError());
+			return GetNearestUploadedLevel(level);
+		}
+		// 该级别及更大级别的像素不再需要，更小级别的像素保留，缩小显示时不需要重新读取文件
+		ReleaseSurfaces(level);
+		return *target.texture;
+	}
+
+	SDL_Texture& Texture::GetNearestUploadedLevel(size_t level) const {
+		for (size_t d = 1; d < m_levels.size(); ++d) {
+			if (level >= d && m_levels[level - d].texture) return *m_levels[level - d].texture;
+			if (level + d < m_levels.size() && m_levels[level + d].texture) return *m_levels[level + d].texture;
+		}
+		return *m_levels.back().texture;
+	}
+
+	std::vector<SDL_Surface*> Texture::BuildSurfaces(const std::string& path, size_t keepLevel) {
+		std::vector<SDL_Surface*> surfaces;
+		SDL_Surface* image = IMG_Load(path.c_str());
+		if (!image) return surfaces;
+		// 统一为每像素4字节，缩小时不需要区分格式
+		SDL_Surface* current = SDL_ConvertSurface(image, SDL_PIXELFORMAT_RGBA32);
+		SDL_DestroySurface(image);
+		if (!current) return surfaces;
+
+		for (;;) {
+			bool last = current->w == 1 && current->h == 1;
+			SDL_Surface* next = last ? nullptr : DownscaleSurfaceHalf(current);
+			// 不需要保留的更大级别只用于生成下一级
+			if (surfaces.size() < keepLevel) {
+				SDL_DestroySurface(current);
+				surfaces.push_back(nullptr);
+			}
+			else {
+				surfaces.push_back(current);
+			}
+			if (last) return surfaces;
+
+			if (!next) {
+				for (SDL_Surface* surface : surfaces) {
+					SDL_DestroySurface(surface);
+				}
+				surfaces.clear();
+				return surfaces;
+			}
+			current = next;
+		}
+	}
+
+	void Texture::RequestRebuild(size_t level) const {
+		if (m_rebuildFuture.valid() || m_rebuildFailed) return;
+		// 在后台线程中读取文件，绘制不等待
+		m_rebuildFuture = std::async(std::launch::async, [path = m_path, level]() {
+			return BuildSurfaces(path, level);
+		});
+	}
+
+	void Texture::PollRebuildResult() const {
+		if (!m_rebuildFuture.valid() || m_rebuildFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+		std::vector<SDL_Surface*> surfaces = m_rebuildFuture.get();
+		if (surfaces.size() != m_levels.size()) {
+			// 文件被删除或修改时不再重试，继续使用已上传的级别
+			m_rebuildFailed = true;
+			SG_ERROR("Texture: can't rebuild mipmap levels of {}", m_path);
+			for (SDL_Surface* surface : surfaces) {
+				SDL_DestroySurface(surface);
+			}
+			return;
+		}
+
+		for (size_t i = 0; i < surfaces.size(); ++i) {
+			if (!m_surfaces[i]) m_surfaces[i] = surfaces[i];
+			else SDL_DestroySurface(surfaces[i]);
+		}
+	}
+
+	bool Texture::UploadLevel(size_t level) const {
+		auto lock = m_renderer.LockDevice();
+		SDL_Texture* texture = SDL_CreateTextureFromSurface(&m_renderer.GetSDLRenderer(), m_surfaces[level]);
+		if (!texture) return false;
+		SDL_SetTextureScaleMode(texture, m_scaleMode);
+		m_levels[level].texture = texture;
+		return true;
+	}
+
+	void Texture::ReleaseSurfaces(size_t lastLevel) const {
+		for (size_t i = 0; i <= lastLevel; ++i) {
+			SDL_DestroySurface(m_surfaces[i]);
+			m_surfaces[i] = nullptr;
+		}
+	}
+
+	void Texture::ReleaseIdleLevels(Uint64 now) const {
+		for (size_t i = 0; i + 1 < m_levels.size(); ++i) {
+			Level& level = m_levels[i];
+			if (level.texture && now - level.lastUsedTime > LEVEL_RELEASE_DELAY) {
+				Renderer::DestroyTexture(level.texture);
+				level.texture = nullptr;
+			}
 		}
 	}
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #include "timer.hpp"
 #include <SDL3/SDL_log.h>
+#include "logger.hpp"
 
 
 namespace SimpleGui {
@@ -57,7 +58,6 @@ namespace SimpleGui {
 		for (auto it = m_timers.begin(); it != m_timers.end();) {
 			if ((*it)->m_kill) {
 				it = m_timers.erase(it);
-				SDL_Log("TimerManager: timer count = %d", m_timers.size());
 			}
 			else {
 				(*it)->Update();
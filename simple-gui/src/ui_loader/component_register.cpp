@@ -149,6 +149,26 @@ namespace SimpleGui {
             static_cast<DraggablePanel*>(cmp)->SetClampRangeFollowParentContent(std::any_cast<bool>(args[0]));
         });
 
+        // ListView
+        SG_CMP_REG_REG_CLASS(ListView);
+        SG_CMP_REG_COPY_PROPERTIES(ListView, BaseComponent);
+        SG_CMP_REG_REG_PROPERTY(ListView, "row-height", [](SG_CMP_REG_PROPERTY_SETTER_ARGS) {
+            static_cast<ListView*>(cmp)->SetDefaultRowHeight(std::any_cast<float>(args[0]));
+        });
+        SG_CMP_REG_REG_PROPERTY(ListView, "overscan", [](SG_CMP_REG_PROPERTY_SETTER_ARGS) {
+            static_cast<ListView*>(cmp)->SetOverscan(std::any_cast<int>(args[0]));
+        });
+
+        // TableView
+        SG_CMP_REG_REG_CLASS(TableView);
+        SG_CMP_REG_COPY_PROPERTIES(TableView, BaseComponent);
+        SG_CMP_REG_REG_PROPERTY(TableView, "row-height", [](SG_CMP_REG_PROPERTY_SETTER_ARGS) {
+            static_cast<TableView*>(cmp)->SetRowHeight(std::any_cast<float>(args[0]));
+        });
+        SG_CMP_REG_REG_PROPERTY(TableView, "min-column-width", [](SG_CMP_REG_PROPERTY_SETTER_ARGS) {
+            static_cast<TableView*>(cmp)->SetMinColumnWidth(std::any_cast<float>(args[0]));
+        });
+
         // ProgressBar
         SG_CMP_REG_REG_CLASS(ProgressBar);
         SG_CMP_REG_COPY_PROPERTIES(ProgressBar, BaseComponent);
@@ -216,6 +236,16 @@ namespace SimpleGui {
             static_cast<Slider*>(cmp)->SetScrollable(std::any_cast<bool>(args[0]));
         });
 
+        // TextEdit
+        SG_CMP_REG_REG_CLASS(TextEdit);
+        SG_CMP_REG_COPY_PROPERTIES(TextEdit, BaseComponent);
+        SG_CMP_REG_REG_PROPERTY(TextEdit, "text", [](SG_CMP_REG_PROPERTY_SETTER_ARGS) {
+            static_cast<TextEdit*>(cmp)->SetText(std::any_cast<const char*>(args[0]));
+        });
+        SG_CMP_REG_REG_PROPERTY(TextEdit, "editable", [](SG_CMP_REG_PROPERTY_SETTER_ARGS) {
+            static_cast<TextEdit*>(cmp)->SetEditable(std::any_cast<bool>(args[0]));
+        });
+
         // TextureRect
         SG_CMP_REG_REG_CLASS(TextureRect);
         SG_CMP_REG_COPY_PROPERTIES(TextureRect, BaseComponent);
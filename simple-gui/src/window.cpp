@@ -19,11 +19,15 @@ namespace SimpleGui {
 
 		m_renderer = std::make_unique<Renderer>(m_window);
 		m_styleManager = std::make_unique<StyleManager>();
+		m_geometryStore = std::make_unique<GeometryStore>();
 		m_rootCmp = std::unique_ptr<RootComponent>(new RootComponent(this));
 	}
 
 	Window::~Window() {
+		// 先停止渲染线程，组件释放的资源不会再被正在呈现的帧使用
+		m_renderer->SetPipelined(false);
 		m_rootCmp.reset();
+		m_geometryStore.reset();
 		m_styleManager.reset();
 		m_font.reset();
 		m_renderer.reset();
@@ -139,6 +143,7 @@ namespace SimpleGui {
 
 	bool Window::EnableVsync(bool enable) const {
 		auto vsync = enable ? 1 : SDL_RENDERER_VSYNC_DISABLED;
+		auto lock = m_renderer->LockDevice();
 		return SDL_SetRenderVSync(&m_renderer->GetSDLRenderer(), vsync);;
 	}
 
@@ -147,7 +152,15 @@ namespace SimpleGui {
 	}
 
 	void Window::SetFont(std::string_view path, float ptsize) {
+		auto oldFont = std::move(m_font);
 		m_font = std::make_unique<Font>(path, ptsize);
+		if (!oldFont) return;
+
+		// 共享窗口字体的组件先切换到新字体，之后没有TTF_Text再引用旧字体
+		m_rootCmp->NotifyWindowFontChanged();
+		// 上一帧的命令已经执行完，渲染线程可能还在呈现，持有设备锁时关闭旧字体
+		auto lock = m_renderer->LockDevice();
+		oldFont.reset();
 	}
 
 	std::string Window::GetCurrentStyleName() const {